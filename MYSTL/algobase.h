@@ -426,7 +426,7 @@ template <class RandomIter, class T>
 void fill_cat(RandomIter first, RandomIter last, const T& value,
               mystl::random_access_iterator_tag)
 {
-  fill_n(first, last - first, value);
+  mystl::fill_n(first, last - first, value);
 }
 
 template <class ForwardIter, class T>
@@ -2,9 +2,11 @@
 #define MYTINYSTL_ALLOCATOR_H_
 
 // 这个头文件包含一个模板类 allocator，用于管理内存的分配、释放，对象的构造、析构
+// 不超过 1KB 的请求经过 thread_cache.h 中的线程缓存，定义 MYSTL_NO_THREAD_CACHE 可以让所有请求直接走 operator new
 
 #include "construct.h"
 #include "util.h"
+#include "thread_cache.h"
 
 namespace mystl
 {
@@ -23,7 +25,18 @@ public:
   typedef size_t       size_type;
   typedef ptrdiff_t    difference_type;
 
+  // 容器通过 rebind 取得节点、buffer 等其它类型的配置器
+  template <class U>
+  struct rebind
+  {
+    typedef allocator<U> other;
+  };
+
 public:
+  allocator() noexcept = default;
+  template <class U>
+  allocator(const allocator<U>&) noexcept {}
+
   static T*   allocate();
   static T*   allocate(size_type n);
 
@@ -45,7 +58,7 @@ public:
 template <class T>
 T* allocator<T>::allocate()
 {
-  return static_cast<T*>(::operator new(sizeof(T))); // TODO:删除了作用域声明符::
+  return allocate(1);
 }
 
 template <class T>
@@ -53,22 +66,33 @@ T* allocator<T>::allocate(size_type n)
 {
   if (n == 0)
     return nullptr;
+#ifndef MYSTL_NO_THREAD_CACHE
+  // 线程缓存中的块按 16 字节对齐，对齐要求更高的类型直接走 operator new
+  if (alignof(T) <= tc_detail::tc_align)
+    return static_cast<T*>(mystl::tc_allocate(n * sizeof(T)));
+#endif
   return static_cast<T*>(::operator new(n * sizeof(T)));
 }
 
 template <class T>
 void allocator<T>::deallocate(T* ptr)
 {
-  if (ptr == nullptr)
-    return;
-  ::operator delete(ptr);
+  deallocate(ptr, 1);
 }
 
-template <class T>  //! 重载了两个参数的deallocate函数，内部实现和一个参数的一样，和allocate 函数相对应
-void allocator<T>::deallocate(T* ptr, size_type /*size*/)
+//! 释放时的 n 必须与分配时相同，线程缓存靠它找到块所在的分级
+template <class T>
+void allocator<T>::deallocate(T* ptr, size_type n)
 {
   if (ptr == nullptr)
     return;
+#ifndef MYSTL_NO_THREAD_CACHE
+  if (alignof(T) <= tc_detail::tc_align)
+  {
+    mystl::tc_deallocate(ptr, n * sizeof(T));
+    return;
+  }
+#endif
   ::operator delete(ptr);
 }
 
@@ -109,6 +133,19 @@ void allocator<T>::destroy(T* first, T* last)
   mystl::destroy(first, last);
 }
 
+// allocator 没有状态，所有实例都可以互相释放对方分配的内存
+template <class T, class U>
+bool operator==(const allocator<T>&, const allocator<U>&) noexcept
+{
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const allocator<T>&, const allocator<U>&) noexcept
+{
+  return false;
+}
+
 } // namespace mystl
 #endif // !MYTINYSTL_ALLOCATOR_H_
 
@@ -0,0 +1,566 @@
+#ifndef MYSTL_CIRCULAR_BUFFER_H
+#define MYSTL_CIRCULAR_BUFFER_H
+
+// 这个头文件包含一个模板类 circular_buffer
+// circular_buffer : 容量固定的环形缓冲区，两端插入删除都是 O(1)，支持随机访问
+// 容量向上取整到 2 的幂，下标只需一次与运算；元素在环上最多分成两段连续空间，可用 array_one / array_two 整段读取
+// 满了以后的行为由 circular_buffer_mode 决定：overwrite 覆盖另一端最旧的元素，reject 拒绝插入并返回 false
+
+#include <initializer_list>
+
+#include "allocator.h"
+#include "uninitialized.h"
+#include "iterator.h"
+#include "span.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 容器已满时插入的处理方式
+enum class circular_buffer_mode
+{
+  overwrite,  // 覆盖另一端的元素：push_back 挤掉 front，push_front 挤掉 back
+  reject      // 不插入，返回 false
+};
+
+// circular_buffer 的迭代器
+// pos 是未取模的物理下标（head + 逻辑下标），比较和相减都直接用 pos
+template <class T, class Ref, class Ptr>
+struct circular_buffer_iterator : public iterator<random_access_iterator_tag, T>
+{
+  typedef circular_buffer_iterator<T, T&, T*>             iterator;
+  typedef circular_buffer_iterator<T, const T&, const T*> const_iterator;
+  typedef circular_buffer_iterator                        self;
+
+  typedef T            value_type;
+  typedef Ptr          pointer;
+  typedef Ref          reference;
+  typedef size_t       size_type;
+  typedef ptrdiff_t    difference_type;
+
+  T*        buf;   // 缓冲区起始位置
+  size_type mask;  // 容量 - 1
+  size_type pos;   // 当前位置
+
+  circular_buffer_iterator() noexcept
+    :buf(nullptr), mask(0), pos(0) {}
+  circular_buffer_iterator(T* b, size_type m, size_type p) noexcept
+    :buf(b), mask(m), pos(p) {}
+  circular_buffer_iterator(const iterator& rhs) noexcept
+    :buf(rhs.buf), mask(rhs.mask), pos(rhs.pos) {}
+
+  reference operator*()  const { return buf[pos & mask]; }
+  pointer   operator->() const { return buf + (pos & mask); }
+
+  self& operator++()    { ++pos; return *this; }
+  self  operator++(int) { self tmp = *this; ++pos; return tmp; }
+  self& operator--()    { --pos; return *this; }
+  self  operator--(int) { self tmp = *this; --pos; return tmp; }
+
+  self& operator+=(difference_type n) { pos += n; return *this; }
+  self& operator-=(difference_type n) { pos -= n; return *this; }
+  self  operator+(difference_type n) const { return self(buf, mask, pos + n); }
+  self  operator-(difference_type n) const { return self(buf, mask, pos - n); }
+  difference_type operator-(const self& x) const
+  { return static_cast<difference_type>(pos - x.pos); }
+
+  reference operator[](difference_type n) const { return buf[(pos + n) & mask]; }
+
+  bool operator==(const self& rhs) const { return pos == rhs.pos; }
+  bool operator!=(const self& rhs) const { return pos != rhs.pos; }
+  bool operator< (const self& rhs) const { return pos < rhs.pos; }
+  bool operator> (const self& rhs) const { return rhs.pos < pos; }
+  bool operator<=(const self& rhs) const { return !(rhs.pos < pos); }
+  bool operator>=(const self& rhs) const { return !(pos < rhs.pos); }
+};
+
+// 模板类: circular_buffer
+// 模板参数 T 代表类型，Alloc 代表空间配置器，缺省使用 mystl::allocator
+template <class T, class Alloc = mystl::allocator<T>>
+class circular_buffer
+{
+public:
+  // circular_buffer 的嵌套型别定义
+  typedef Alloc                                    allocator_type;
+  typedef Alloc                                    data_allocator;
+
+  typedef T                                        value_type;
+  typedef T*                                       pointer;
+  typedef const T*                                 const_pointer;
+  typedef T&                                       reference;
+  typedef const T&                                 const_reference;
+  typedef size_t                                   size_type;
+  typedef ptrdiff_t                                difference_type;
+
+  typedef circular_buffer_iterator<T, T&, T*>             iterator;
+  typedef circular_buffer_iterator<T, const T&, const T*> const_iterator;
+  typedef mystl::reverse_iterator<iterator>               reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>         const_reverse_iterator;
+
+  allocator_type get_allocator() const { return alloc_; }
+
+private:
+  data_allocator       alloc_;
+  pointer              buf_;    // 存放元素的空间
+  size_type            cap_;    // 容量，0 或 2 的幂
+  size_type            head_;   // front 所在的物理下标
+  size_type            size_;   // 元素个数
+  circular_buffer_mode mode_;   // 已满时的处理方式
+
+public:
+  // 构造、复制、移动、析构函数
+  circular_buffer() noexcept
+    :buf_(nullptr), cap_(0), head_(0), size_(0), mode_(circular_buffer_mode::overwrite)
+  {
+  }
+
+  // 容量向上取整到 2 的幂
+  explicit circular_buffer(size_type capacity,
+                           circular_buffer_mode mode = circular_buffer_mode::overwrite,
+                           const allocator_type& alloc = allocator_type())
+    :alloc_(alloc), buf_(nullptr), cap_(0), head_(0), size_(0), mode_(mode)
+  {
+    init_space(capacity);
+  }
+
+  circular_buffer(size_type capacity, std::initializer_list<value_type> ilist,
+                  circular_buffer_mode mode = circular_buffer_mode::overwrite)
+    :buf_(nullptr), cap_(0), head_(0), size_(0), mode_(mode)
+  {
+    init_space(capacity);
+    init_range(ilist.begin(), ilist.end());
+  }
+
+  circular_buffer(const circular_buffer& rhs)
+    :alloc_(rhs.alloc_), buf_(nullptr), cap_(0), head_(0), size_(0), mode_(rhs.mode_)
+  {
+    init_space(rhs.cap_);
+    init_range(rhs.begin(), rhs.end());
+  }
+
+  circular_buffer(circular_buffer&& rhs) noexcept
+    :alloc_(rhs.alloc_), buf_(rhs.buf_), cap_(rhs.cap_), head_(rhs.head_),
+     size_(rhs.size_), mode_(rhs.mode_)
+  {
+    rhs.buf_ = nullptr;
+    rhs.cap_ = 0;
+    rhs.head_ = 0;
+    rhs.size_ = 0;
+  }
+
+  circular_buffer& operator=(const circular_buffer& rhs)
+  {
+    if (this != &rhs)
+    {
+      circular_buffer tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  circular_buffer& operator=(circular_buffer&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      circular_buffer tmp(mystl::move(rhs));
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  ~circular_buffer()
+  {
+    clear();
+    alloc_.deallocate(buf_, cap_);
+    buf_ = nullptr;
+  }
+
+public:
+  // 迭代器相关操作
+  iterator               begin()         noexcept
+  { return iterator(buf_, cap_ - 1, head_); }
+  const_iterator         begin()   const noexcept
+  { return const_iterator(buf_, cap_ - 1, head_); }
+  iterator               end()           noexcept
+  { return iterator(buf_, cap_ - 1, head_ + size_); }
+  const_iterator         end()     const noexcept
+  { return const_iterator(buf_, cap_ - 1, head_ + size_); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关操作
+  bool      empty()     const noexcept { return size_ == 0; }
+  bool      full()      const noexcept { return size_ == cap_; }
+  size_type size()      const noexcept { return size_; }
+  size_type capacity()  const noexcept { return cap_; }
+  size_type available() const noexcept { return cap_ - size_; }  // 剩余空位
+
+  circular_buffer_mode mode() const noexcept        { return mode_; }
+  void set_mode(circular_buffer_mode mode) noexcept { mode_ = mode; }
+
+  // 访问元素相关操作
+  reference operator[](size_type n)
+  {
+    MYSTL_DEBUG(n < size_);
+    return buf_[(head_ + n) & (cap_ - 1)];
+  }
+  const_reference operator[](size_type n) const
+  {
+    MYSTL_DEBUG(n < size_);
+    return buf_[(head_ + n) & (cap_ - 1)];
+  }
+  reference at(size_type n)
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size_), "circular_buffer<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size_), "circular_buffer<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+
+  reference front()
+  {
+    MYSTL_DEBUG(!empty());
+    return buf_[head_];
+  }
+  const_reference front() const
+  {
+    MYSTL_DEBUG(!empty());
+    return buf_[head_];
+  }
+  reference back()
+  {
+    MYSTL_DEBUG(!empty());
+    return buf_[(head_ + size_ - 1) & (cap_ - 1)];
+  }
+  const_reference back() const
+  {
+    MYSTL_DEBUG(!empty());
+    return buf_[(head_ + size_ - 1) & (cap_ - 1)];
+  }
+
+  // 按存放顺序的两段连续空间：array_one 从 front 开始，array_two 是绕回缓冲区开头的部分（可能为空）
+  span<value_type>       array_one()
+  { return span<value_type>(buf_ + head_, first_run()); }
+  span<const value_type> array_one() const
+  { return span<const value_type>(buf_ + head_, first_run()); }
+  span<value_type>       array_two()
+  { return span<value_type>(buf_, size_ - first_run()); }
+  span<const value_type> array_two() const
+  { return span<const value_type>(buf_, size_ - first_run()); }
+
+  // 修改容器相关操作
+  // 插入成功返回 true；reject 模式下已满（或容量为 0）时返回 false
+  template <class ...Args>
+  bool emplace_back(Args&& ...args);
+  template <class ...Args>
+  bool emplace_front(Args&& ...args);
+
+  bool push_back(const value_type& value)  { return emplace_back(value); }
+  bool push_back(value_type&& value)       { return emplace_back(mystl::move(value)); }
+  bool push_front(const value_type& value) { return emplace_front(value); }
+  bool push_front(value_type&& value)      { return emplace_front(mystl::move(value)); }
+
+  void pop_front()
+  {
+    MYSTL_DEBUG(!empty());
+    mystl::destroy(buf_ + head_);
+    head_ = (head_ + 1) & (cap_ - 1);
+    --size_;
+  }
+  void pop_back()
+  {
+    MYSTL_DEBUG(!empty());
+    mystl::destroy(buf_ + ((head_ + size_ - 1) & (cap_ - 1)));
+    --size_;
+  }
+
+  // 从头部删除 n 个元素，按两段连续空间析构
+  void pop_front_n(size_type n);
+
+  // 在尾部追加 [first, last)，返回写入的元素个数
+  // overwrite 模式下超出容量的部分挤掉最旧的元素（输入本身超过容量时只保留最后 capacity() 个）
+  // reject 模式下只写入剩余空位能容纳的部分；[first, last) 不能指向本容器中的元素
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  size_type append_range(Iter first, Iter last)
+  { return append_range_aux(first, last, iterator_category(first)); }
+
+  void clear() noexcept
+  {
+    pop_front_n(size_);
+    head_ = 0;
+  }
+
+  void swap(circular_buffer& rhs) noexcept;
+
+private:
+  // helper functions
+
+  // initialize
+  void init_space(size_type capacity);
+  template <class Iter>
+  void init_range(Iter first, Iter last);
+
+  // front 所在的那一段连续空间的长度
+  size_type first_run() const noexcept
+  { return mystl::min(size_, cap_ - head_); }
+
+  // 为尾部腾出一个位置，返回 false 表示不能插入
+  bool make_room_back();
+
+  template <class InputIter>
+  size_type append_range_aux(InputIter first, InputIter last, input_iterator_tag);
+  template <class ForwardIter>
+  size_type append_range_aux(ForwardIter first, ForwardIter last, forward_iterator_tag);
+};
+
+/*****************************************************************************************/
+
+// 分配空间，容量向上取整到 2 的幂
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::init_space(size_type capacity)
+{
+  if (capacity == 0)
+    return;
+  THROW_LENGTH_ERROR_IF(capacity > (static_cast<size_type>(-1) >> 1) / sizeof(T) + 1,
+                        "circular_buffer<T>'s capacity too big");
+  size_type cap = 1;
+  while (cap < capacity)
+    cap <<= 1;
+  buf_ = alloc_.allocate(cap);
+  cap_ = cap;
+}
+
+// 构造函数中写入初始元素，失败时释放空间
+template <class T, class Alloc>
+template <class Iter>
+void circular_buffer<T, Alloc>::init_range(Iter first, Iter last)
+{
+  try
+  {
+    append_range(first, last);
+  }
+  catch (...)
+  {
+    clear();
+    alloc_.deallocate(buf_, cap_);
+    buf_ = nullptr;
+    cap_ = 0;
+    throw;
+  }
+}
+
+template <class T, class Alloc>
+bool circular_buffer<T, Alloc>::make_room_back()
+{
+  if (size_ != cap_)
+    return true;
+  if (mode_ == circular_buffer_mode::reject || cap_ == 0)
+    return false;
+  pop_front();
+  return true;
+}
+
+// 在尾部构造元素，已满时参数可能引用要被挤掉的 front，先构造出来
+template <class T, class Alloc>
+template <class ...Args>
+bool circular_buffer<T, Alloc>::emplace_back(Args&& ...args)
+{
+  if (size_ != cap_)
+  {
+    mystl::construct(buf_ + ((head_ + size_) & (cap_ - 1)), mystl::forward<Args>(args)...);
+    ++size_;
+    return true;
+  }
+  if (mode_ == circular_buffer_mode::reject || cap_ == 0)
+    return false;
+  value_type tmp(mystl::forward<Args>(args)...);
+  pop_front();
+  mystl::construct(buf_ + ((head_ + size_) & (cap_ - 1)), mystl::move(tmp));
+  ++size_;
+  return true;
+}
+
+// 在头部构造元素，已满时挤掉 back
+template <class T, class Alloc>
+template <class ...Args>
+bool circular_buffer<T, Alloc>::emplace_front(Args&& ...args)
+{
+  if (size_ != cap_)
+  {
+    const size_type new_head = (head_ - 1) & (cap_ - 1);
+    mystl::construct(buf_ + new_head, mystl::forward<Args>(args)...);
+    head_ = new_head;
+    ++size_;
+    return true;
+  }
+  if (mode_ == circular_buffer_mode::reject || cap_ == 0)
+    return false;
+  value_type tmp(mystl::forward<Args>(args)...);
+  pop_back();
+  const size_type new_head = (head_ - 1) & (cap_ - 1);
+  mystl::construct(buf_ + new_head, mystl::move(tmp));
+  head_ = new_head;
+  ++size_;
+  return true;
+}
+
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::pop_front_n(size_type n)
+{
+  MYSTL_DEBUG(n <= size_);
+  if (n == 0)
+    return;
+  const size_type len1 = mystl::min(n, cap_ - head_);
+  mystl::destroy(buf_ + head_, buf_ + head_ + len1);
+  mystl::destroy(buf_, buf_ + (n - len1));
+  head_ = (head_ + n) & (cap_ - 1);
+  size_ -= n;
+}
+
+// 输入迭代器只能逐个插入
+template <class T, class Alloc>
+template <class InputIter>
+typename circular_buffer<T, Alloc>::size_type
+circular_buffer<T, Alloc>::append_range_aux(InputIter first, InputIter last, input_iterator_tag)
+{
+  size_type n = 0;
+  for (; first != last; ++first)
+  {
+    if (!make_room_back())
+      break;
+    mystl::construct(buf_ + ((head_ + size_) & (cap_ - 1)), *first);
+    ++size_;
+    ++n;
+  }
+  return n;
+}
+
+// 前向迭代器先算出最终写入的区间，再分两段拷贝进尾部的空位
+template <class T, class Alloc>
+template <class ForwardIter>
+typename circular_buffer<T, Alloc>::size_type
+circular_buffer<T, Alloc>::append_range_aux(ForwardIter first, ForwardIter last, forward_iterator_tag)
+{
+  size_type n = static_cast<size_type>(mystl::distance(first, last));
+  if (mode_ == circular_buffer_mode::reject)
+  {
+    n = mystl::min(n, cap_ - size_);
+  }
+  else
+  {
+    if (n > cap_)
+    { // 前面的元素写进去也会被后面的挤掉，直接跳过
+      mystl::advance(first, n - cap_);
+      n = cap_;
+    }
+    if (n > cap_ - size_)
+      pop_front_n(n - (cap_ - size_));
+  }
+  if (n == 0)
+    return 0;
+  const size_type tail = (head_ + size_) & (cap_ - 1);
+  const size_type len1 = mystl::min(n, cap_ - tail);
+  auto mid = first;
+  mystl::advance(mid, len1);
+  mystl::uninitialized_copy(first, mid, buf_ + tail);
+  size_ += len1;
+  if (len1 != n)
+  {
+    auto end = mid;
+    mystl::advance(end, n - len1);
+    mystl::uninitialized_copy(mid, end, buf_);
+    size_ += n - len1;
+  }
+  return n;
+}
+
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::swap(circular_buffer& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    mystl::swap(alloc_, rhs.alloc_);
+    mystl::swap(buf_, rhs.buf_);
+    mystl::swap(cap_, rhs.cap_);
+    mystl::swap(head_, rhs.head_);
+    mystl::swap(size_, rhs.size_);
+    mystl::swap(mode_, rhs.mode_);
+  }
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+
+template <class T, class Alloc>
+bool operator==(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs)
+{
+  return lhs.size() == rhs.size() &&
+    mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc>
+bool operator<(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs)
+{
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Alloc>
+bool operator!=(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+bool operator>(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class T, class Alloc>
+bool operator<=(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class T, class Alloc>
+bool operator>=(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 元素在堆上，迭代器不指向对象本身，circular_buffer 对象可以按字节搬移
+template <class T, class Alloc>
+struct is_trivially_relocatable<circular_buffer<T, Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<Alloc>::value> {};
+
+// 重载 mystl 的 swap
+template <class T, class Alloc>
+void swap(circular_buffer<T, Alloc>& lhs, circular_buffer<T, Alloc>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYSTL_CIRCULAR_BUFFER_H
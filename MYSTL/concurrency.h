@@ -0,0 +1,181 @@
+#ifndef MYSTL_CONCURRENCY_H
+#define MYSTL_CONCURRENCY_H
+
+// 这个头文件包含并发容器共用的一些工具
+// cache_line_size : 按 cache line 隔开被不同线程写的变量，避免伪共享
+// cpu_relax       : 自旋等待时提示 CPU 让出流水线
+// backoff         : 等待前的退避，先自旋，再让出时间片，仍不成功才睡眠
+// event_count     : 无锁结构上的等待 / 唤醒，没有等待者时 notify 只有一次 fence 和一次读
+//                   Linux 上直接用 futex，其它平台用 mutex + condition_variable
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <climits>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace mystl
+{
+
+static constexpr size_t cache_line_size = 64;
+
+inline void cpu_relax() noexcept
+{
+#if defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+// 类 backoff
+// 每次等待前调用 pause()，返回 false 表示自旋和让出都已用完，应当睡眠
+// 让出时间片这一步对线程数多于核数的情形很重要：对方线程可能正等着被调度
+class backoff
+{
+public:
+  static const int spin_limit = 128;
+  static const int yield_limit = 16;
+
+  backoff() noexcept
+    :count_(0)
+  {
+  }
+
+  bool pause() noexcept
+  {
+    if (count_ < spin_limit)
+      cpu_relax();
+    else if (count_ < spin_limit + yield_limit)
+      std::this_thread::yield();
+    else
+      return false;
+    ++count_;
+    return true;
+  }
+
+  void reset() noexcept { count_ = 0; }
+
+private:
+  int count_;
+};
+
+// 类 event_count
+// 等待方先 prepare_wait 取得 key，再检查一次条件：条件满足就 cancel_wait，否则 commit_wait(key) 睡眠
+// 通知方先让条件成立（如 release 写入下标），再 notify_all
+// prepare_wait 与 notify_all 中的 seq_cst fence 保证两边至少有一方看到对方的写入，不会丢失唤醒
+class event_count
+{
+public:
+  event_count() noexcept
+    :epoch_(0), waiters_(0)
+  {
+  }
+
+  event_count(const event_count&) = delete;
+  event_count& operator=(const event_count&) = delete;
+
+  uint32_t prepare_wait() noexcept
+  {
+    waiters_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return epoch_.load(std::memory_order_acquire);
+  }
+
+  void cancel_wait() noexcept
+  {
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void commit_wait(uint32_t key) noexcept
+  {
+    while (epoch_.load(std::memory_order_acquire) == key)
+      wait_on(key, nullptr);
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // 最多等待 rel_time，被唤醒返回 true，超时返回 false
+  template <class Rep, class Period>
+  bool commit_wait_for(uint32_t key, const std::chrono::duration<Rep, Period>& rel_time) noexcept
+  {
+    typedef std::chrono::steady_clock clock;
+    const auto deadline = clock::now() + rel_time;
+    bool woken = true;
+    while (epoch_.load(std::memory_order_acquire) == key)
+    {
+      const auto now = clock::now();
+      if (now >= deadline)
+      {
+        woken = false;
+        break;
+      }
+      const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+      wait_on(key, &ns);
+    }
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    return woken;
+  }
+
+  void notify_all() noexcept
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) == 0)
+      return;
+#if defined(__linux__)
+    epoch_.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, INT_MAX,
+            nullptr, nullptr, 0);
+#else
+    std::lock_guard<std::mutex> lock(mutex_);
+    epoch_.fetch_add(1, std::memory_order_release);
+    cv_.notify_all();
+#endif
+  }
+
+private:
+  // epoch 仍等于 key 时睡眠，可能因信号或超时提前返回，由调用者重新检查
+  void wait_on(uint32_t key, const std::chrono::nanoseconds* rel_time) noexcept
+  {
+#if defined(__linux__)
+    struct timespec ts;
+    struct timespec* pts = nullptr;
+    if (rel_time != nullptr)
+    {
+      ts.tv_sec = static_cast<time_t>(rel_time->count() / 1000000000);
+      ts.tv_nsec = static_cast<long>(rel_time->count() % 1000000000);
+      pts = &ts;
+    }
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE, key,
+            pts, nullptr, 0);
+#else
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (epoch_.load(std::memory_order_acquire) != key)
+      return;
+    if (rel_time != nullptr)
+      cv_.wait_for(lock, *rel_time);
+    else
+      cv_.wait(lock);
+#endif
+  }
+
+private:
+  std::atomic<uint32_t> epoch_;    // 每次唤醒加一
+  std::atomic<uint32_t> waiters_;  // 已 prepare_wait 尚未结束的等待者数
+#if !defined(__linux__)
+  std::mutex              mutex_;
+  std::condition_variable cv_;
+#endif
+};
+
+} // namespace mystl
+#endif // !MYSTL_CONCURRENCY_H
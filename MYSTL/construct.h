@@ -68,7 +68,7 @@ template <class ForwardIter>
 void destroy_cat(ForwardIter first, ForwardIter last, std::false_type)
 { //! 释放多个对象
   for (; first != last; ++first)
-    destroy(&*first);
+    mystl::destroy_one(&*first, std::false_type{});
 }
 
 template <class Ty>
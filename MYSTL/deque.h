@@ -22,18 +22,48 @@ namespace mystl{
 #define DEQUE_MAP_INIT_SIZE 8
 #endif
 
-template <class T>
+// deque 缓存的空闲缓冲区的最大个数
+// 两端弹出时腾空的缓冲区先留下来，另一端需要新缓冲区时直接取用，队列深度稳定时不再分配内存
+#ifndef DEQUE_SPARE_BLOCKS
+#define DEQUE_SPARE_BLOCKS 4
+#endif
+
+namespace deque_detail
+{
+
+// 不大于 n 的最大的 2 的幂
+constexpr size_t floor_pow2(size_t n, size_t p = 1)
+{ return p <= n / 2 ? floor_pow2(n, p * 2) : p; }
+
+// 不小于 n 的最小的 2 的幂
+constexpr size_t ceil_pow2(size_t n, size_t p = 1)
+{ return p >= n ? p : ceil_pow2(n, p * 2); }
+
+// n 为 2 的幂，返回 log2(n)
+constexpr size_t log2_pow2(size_t n)
+{ return n <= 1 ? 0 : 1 + log2_pow2(n >> 1); }
+
+} // namespace deque_detail
+
+// 每个缓冲区的元素个数，总是 2 的幂，这样定位元素只需要移位和掩码
+// BufSize 为 0 时取不超过 4096 字节的最大的 2 的幂（元素不小于 256 字节时为 16），否则向上取整到 2 的幂
+template <class T, size_t BufSize = 0>
 struct  deque_buf_size
 {
-  static constexpr size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+  static constexpr size_t value = BufSize != 0
+    ? deque_detail::ceil_pow2(BufSize)
+    : deque_detail::floor_pow2(sizeof(T) < 256 ? 4096 / sizeof(T) : 16);
 };
 
 // deque 的迭代器设计
-template <class T, class Ref, class Ptr>
+// 模板参数 BufSize 为每个缓冲区的元素个数，必须是 2 的幂
+template <class T, class Ref, class Ptr, size_t BufSize = deque_buf_size<T>::value>
 struct deque_iterator : public iterator<random_access_iterator_tag, T>
 {
-    typedef deque_iterator<T, T&, T*>             iterator;
-    typedef deque_iterator<T, const T&, const T*> const_iterator;
+    static_assert((BufSize & (BufSize - 1)) == 0, "deque buffer size must be a power of two");
+
+    typedef deque_iterator<T, T&, T*, BufSize>             iterator;
+    typedef deque_iterator<T, const T&, const T*, BufSize> const_iterator;
     typedef deque_iterator                        self;
     // 迭代器的5种基本属性
     typedef T            value_type;
@@ -45,7 +75,9 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T>
     typedef T*           value_pointer;
     typedef T**          map_pointer;
 
-    static const size_type buffer_size = deque_buf_size<T>::value;
+    static const size_type buffer_size = BufSize;
+    static const size_type buffer_shift = deque_detail::log2_pow2(BufSize);
+    static const size_type buffer_mask = BufSize - 1;
 
     // 表示迭代器的数据结构
     value_pointer cur;     // 指向所在缓冲区的当前元素
@@ -99,7 +131,7 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T>
     difference_type operator-(const self& x) const
     {
         return static_cast<difference_type>(buffer_size) * (node - x.node)
-            + (cur - first)  + (x.cur - x.first);
+            + (cur - first) - (x.cur - x.first);
     }
 
     // 前置++
@@ -115,7 +147,7 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T>
     }
 
     // 后置++ ： 先返回， 在加
-    self& operator++(int)
+    self operator++(int)
     {
         self tmp = *this;
         ++*this;
@@ -143,18 +175,18 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T>
 
     self& operator += (difference_type n)
     {
-        const auto offset = n + (cur - first);
-        // 仍在当前的缓冲区
-        if(offset >= 0 && offset < static_cast<difference_type>(buffer_size)){
+        const difference_type offset = n + (cur - first);
+        // 仍在当前的缓冲区（offset 为负时转成无符号数后一定不小于 buffer_size）
+        if(static_cast<size_type>(offset) < buffer_size){
             cur += n;
         }
-        // 跳到其他的缓冲区
+        // 跳到其他的缓冲区，缓冲区大小为 2 的幂，用移位和掩码代替除法和取余
         else{
-            const auto node_offset = offset > 0
-                ? offset / static_cast<difference_type>(buffer_size)
-                : -static_cast<difference_type>((-offset - 1) / buffer_size) - 1;
+            const difference_type node_offset = offset > 0
+                ? static_cast<difference_type>(static_cast<size_type>(offset) >> buffer_shift)
+                : -static_cast<difference_type>(static_cast<size_type>(-offset - 1) >> buffer_shift) - 1;
             set_node(node + node_offset);
-            cur = first + (offset - node_offset * static_cast<difference_type>(buffer_size));
+            cur = first + (static_cast<size_type>(offset) & buffer_mask);
         }
         return *this;
     }
@@ -190,14 +222,319 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T>
 
 };
 
-template <class T>
+/*****************************************************************************************/
+// deque 迭代器上的算法
+// 区间被缓冲区切成若干段连续空间，逐段交给 algobase 中以指针为参数的版本，
+// 这样段内可以用上 memmove/memset，迭代器也不必在每次 ++ 时检查是否跨过缓冲区
+/*****************************************************************************************/
+namespace deque_detail
+{
+
+// 在一段连续空间上拷贝或移动
+template <class InputIter, class OutputIter>
+OutputIter copy_or_move(InputIter first, InputIter last, OutputIter result, std::false_type)
+{ return mystl::copy(first, last, result); }
+template <class InputIter, class OutputIter>
+OutputIter copy_or_move(InputIter first, InputIter last, OutputIter result, std::true_type)
+{ return mystl::move(first, last, result); }
+
+template <class InputIter, class OutputIter>
+OutputIter copy_or_move_backward(InputIter first, InputIter last, OutputIter result, std::false_type)
+{ return mystl::copy_backward(first, last, result); }
+template <class InputIter, class OutputIter>
+OutputIter copy_or_move_backward(InputIter first, InputIter last, OutputIter result, std::true_type)
+{ return mystl::move_backward(first, last, result); }
+
+// 从 deque 拷贝到任意位置：逐段处理源区间
+template <class T, class Ref, class Ptr, size_t BufSize, class OutputIter, class IsMove>
+OutputIter segment_copy(deque_iterator<T, Ref, Ptr, BufSize> first,
+                        deque_iterator<T, Ref, Ptr, BufSize> last,
+                        OutputIter result, IsMove is_move)
+{
+  while (first.node != last.node)
+  {
+    result = copy_or_move(first.cur, first.last, result, is_move);
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+  return copy_or_move(first.cur, last.cur, result, is_move);
+}
+
+// 从 deque 拷贝到 deque：每次取两边剩余连续空间中较短的一段
+template <class T1, class Ref, class Ptr, size_t BufSize1, class T2, size_t BufSize2, class IsMove>
+deque_iterator<T2, T2&, T2*, BufSize2>
+segment_copy(deque_iterator<T1, Ref, Ptr, BufSize1> first,
+             deque_iterator<T1, Ref, Ptr, BufSize1> last,
+             deque_iterator<T2, T2&, T2*, BufSize2> result, IsMove is_move)
+{
+  for (auto n = last - first; n > 0;)
+  {
+    auto len = mystl::min(n, mystl::min(first.last - first.cur, result.last - result.cur));
+    copy_or_move(first.cur, first.cur + len, result.cur, is_move);
+    first += len;
+    result += len;
+    n -= len;
+  }
+  return result;
+}
+
+// 从连续空间拷贝到 deque：逐段处理目的区间
+template <class Tp, class T, size_t BufSize, class IsMove>
+deque_iterator<T, T&, T*, BufSize>
+segment_copy(Tp* first, Tp* last, deque_iterator<T, T&, T*, BufSize> result, IsMove is_move)
+{
+  for (auto n = last - first; n > 0;)
+  {
+    auto len = mystl::min(n, result.last - result.cur);
+    copy_or_move(first, first + len, result.cur, is_move);
+    first += len;
+    result += len;
+    n -= len;
+  }
+  return result;
+}
+
+template <class T, class Ref, class Ptr, size_t BufSize, class BidirectionalIter, class IsMove>
+BidirectionalIter segment_copy_backward(deque_iterator<T, Ref, Ptr, BufSize> first,
+                                        deque_iterator<T, Ref, Ptr, BufSize> last,
+                                        BidirectionalIter result, IsMove is_move)
+{
+  while (first.node != last.node)
+  {
+    result = copy_or_move_backward(last.first, last.cur, result, is_move);
+    last.set_node(last.node - 1);
+    last.cur = last.last;
+  }
+  return copy_or_move_backward(first.cur, last.cur, result, is_move);
+}
+
+// 从后往前时，位于缓冲区头部的迭代器要看前一个缓冲区
+template <class T1, class Ref, class Ptr, size_t BufSize1, class T2, size_t BufSize2, class IsMove>
+deque_iterator<T2, T2&, T2*, BufSize2>
+segment_copy_backward(deque_iterator<T1, Ref, Ptr, BufSize1> first,
+                      deque_iterator<T1, Ref, Ptr, BufSize1> last,
+                      deque_iterator<T2, T2&, T2*, BufSize2> result, IsMove is_move)
+{
+  for (auto n = last - first; n > 0;)
+  {
+    auto llen = last.cur - last.first;
+    T1* lend = last.cur;
+    if (llen == 0)
+    {
+      llen = static_cast<decltype(llen)>(BufSize1);
+      lend = *(last.node - 1) + BufSize1;
+    }
+    auto rlen = result.cur - result.first;
+    T2* rend = result.cur;
+    if (rlen == 0)
+    {
+      rlen = static_cast<decltype(rlen)>(BufSize2);
+      rend = *(result.node - 1) + BufSize2;
+    }
+    auto len = mystl::min(n, mystl::min(llen, rlen));
+    copy_or_move_backward(lend - len, lend, rend, is_move);
+    last -= len;
+    result -= len;
+    n -= len;
+  }
+  return result;
+}
+
+} // namespace deque_detail
+
+// copy / move / copy_backward / move_backward
+template <class T, class Ref, class Ptr, size_t BufSize, class OutputIter>
+OutputIter copy(deque_iterator<T, Ref, Ptr, BufSize> first,
+                deque_iterator<T, Ref, Ptr, BufSize> last, OutputIter result)
+{
+  return deque_detail::segment_copy(first, last, result, std::false_type());
+}
+
+template <class Tp, class T, size_t BufSize>
+deque_iterator<T, T&, T*, BufSize>
+copy(Tp* first, Tp* last, deque_iterator<T, T&, T*, BufSize> result)
+{
+  return deque_detail::segment_copy(first, last, result, std::false_type());
+}
+
+template <class T, class Ref, class Ptr, size_t BufSize, class OutputIter>
+OutputIter move(deque_iterator<T, Ref, Ptr, BufSize> first,
+                deque_iterator<T, Ref, Ptr, BufSize> last, OutputIter result)
+{
+  return deque_detail::segment_copy(first, last, result, std::true_type());
+}
+
+template <class Tp, class T, size_t BufSize>
+deque_iterator<T, T&, T*, BufSize>
+move(Tp* first, Tp* last, deque_iterator<T, T&, T*, BufSize> result)
+{
+  return deque_detail::segment_copy(first, last, result, std::true_type());
+}
+
+template <class T, class Ref, class Ptr, size_t BufSize, class BidirectionalIter>
+BidirectionalIter copy_backward(deque_iterator<T, Ref, Ptr, BufSize> first,
+                                deque_iterator<T, Ref, Ptr, BufSize> last,
+                                BidirectionalIter result)
+{
+  return deque_detail::segment_copy_backward(first, last, result, std::false_type());
+}
+
+template <class T, class Ref, class Ptr, size_t BufSize, class BidirectionalIter>
+BidirectionalIter move_backward(deque_iterator<T, Ref, Ptr, BufSize> first,
+                                deque_iterator<T, Ref, Ptr, BufSize> last,
+                                BidirectionalIter result)
+{
+  return deque_detail::segment_copy_backward(first, last, result, std::true_type());
+}
+
+// fill / fill_n
+template <class T, size_t BufSize, class U>
+void fill(deque_iterator<T, T&, T*, BufSize> first,
+          deque_iterator<T, T&, T*, BufSize> last, const U& value)
+{
+  while (first.node != last.node)
+  {
+    mystl::fill(first.cur, first.last, value);
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+  mystl::fill(first.cur, last.cur, value);
+}
+
+template <class T, size_t BufSize, class Size, class U>
+deque_iterator<T, T&, T*, BufSize>
+fill_n(deque_iterator<T, T&, T*, BufSize> first, Size n, const U& value)
+{
+  if (n <= 0)
+    return first;
+  auto last = first + n;
+  mystl::fill(first, last, value);
+  return last;
+}
+
+// find / find_if
+template <class T, class Ref, class Ptr, size_t BufSize, class U>
+deque_iterator<T, Ref, Ptr, BufSize>
+find(deque_iterator<T, Ref, Ptr, BufSize> first,
+     deque_iterator<T, Ref, Ptr, BufSize> last, const U& value)
+{
+  while (true)
+  {
+    T* const end = first.node == last.node ? last.cur : first.last;
+    for (T* p = first.cur; p != end; ++p)
+    {
+      if (*p == value)
+        return deque_iterator<T, Ref, Ptr, BufSize>(p, first.node);
+    }
+    if (first.node == last.node)
+      return last;
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+}
+
+template <class T, class Ref, class Ptr, size_t BufSize, class UnaryPredicate>
+deque_iterator<T, Ref, Ptr, BufSize>
+find_if(deque_iterator<T, Ref, Ptr, BufSize> first,
+        deque_iterator<T, Ref, Ptr, BufSize> last, UnaryPredicate unary_pred)
+{
+  while (true)
+  {
+    T* const end = first.node == last.node ? last.cur : first.last;
+    for (T* p = first.cur; p != end; ++p)
+    {
+      if (unary_pred(*p))
+        return deque_iterator<T, Ref, Ptr, BufSize>(p, first.node);
+    }
+    if (first.node == last.node)
+      return last;
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+}
+
+// count / count_if
+template <class T, class Ref, class Ptr, size_t BufSize, class U>
+size_t count(deque_iterator<T, Ref, Ptr, BufSize> first,
+             deque_iterator<T, Ref, Ptr, BufSize> last, const U& value)
+{
+  size_t n = 0;
+  while (true)
+  {
+    T* const end = first.node == last.node ? last.cur : first.last;
+    for (T* p = first.cur; p != end; ++p)
+      n += (*p == value) ? 1 : 0;
+    if (first.node == last.node)
+      return n;
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+}
+
+template <class T, class Ref, class Ptr, size_t BufSize, class UnaryPredicate>
+size_t count_if(deque_iterator<T, Ref, Ptr, BufSize> first,
+                deque_iterator<T, Ref, Ptr, BufSize> last, UnaryPredicate unary_pred)
+{
+  size_t n = 0;
+  while (true)
+  {
+    T* const end = first.node == last.node ? last.cur : first.last;
+    for (T* p = first.cur; p != end; ++p)
+      n += unary_pred(*p) ? 1 : 0;
+    if (first.node == last.node)
+      return n;
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+}
+
+// for_each
+template <class T, class Ref, class Ptr, size_t BufSize, class Function>
+Function for_each(deque_iterator<T, Ref, Ptr, BufSize> first,
+                  deque_iterator<T, Ref, Ptr, BufSize> last, Function f)
+{
+  while (true)
+  {
+    T* const end = first.node == last.node ? last.cur : first.last;
+    for (Ptr p = first.cur; p != end; ++p)
+      f(*p);
+    if (first.node == last.node)
+      return f;
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+}
+
+// equal
+template <class T, class Ref, class Ptr, size_t BufSize, class InputIter>
+bool equal(deque_iterator<T, Ref, Ptr, BufSize> first1,
+           deque_iterator<T, Ref, Ptr, BufSize> last1, InputIter first2)
+{
+  while (true)
+  {
+    T* const end = first1.node == last1.node ? last1.cur : first1.last;
+    for (T* p = first1.cur; p != end; ++p, ++first2)
+    {
+      if (*p != *first2)
+        return false;
+    }
+    if (first1.node == last1.node)
+      return true;
+    first1.set_node(first1.node + 1);
+    first1.cur = first1.first;
+  }
+}
+
+// 模板类 deque
+// 模板参数 T 代表类型，Alloc 代表空间配置器，缺省使用 mystl::allocator
+template <class T, class Alloc = mystl::allocator<T>, size_t BufSize = 0>
 class deque 
 {
 public:
   // deque 的型别定义
-    typedef mystl::allocator<T>                      allocator_type;
-    typedef mystl::allocator<T>                      data_allocator;
-    typedef mystl::allocator<T*>                     map_allocator;
+    typedef Alloc                                    allocator_type;
+    typedef Alloc                                    data_allocator;
+    typedef typename Alloc::template rebind<T*>::other map_allocator;
 
     typedef typename allocator_type::value_type      value_type;
     typedef typename allocator_type::pointer         pointer;
@@ -209,55 +546,79 @@ public:
     typedef pointer*                                 map_pointer;
     typedef const_pointer*                           const_map_pointer;
 
-    typedef deque_iterator<T, T&, T*>                iterator;
-    typedef deque_iterator<T, const T&, const T*>    const_iterator;
+    static const size_type buffer_size = deque_buf_size<T, BufSize>::value;
+
+    typedef deque_iterator<T, T&, T*, buffer_size>             iterator;
+    typedef deque_iterator<T, const T&, const T*, buffer_size> const_iterator;
     typedef mystl::reverse_iterator<iterator>        reverse_iterator;
     typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
 
-    allocator_type get_allocator() { return allocator_type(); }
-
-    static const size_type buffer_size = deque_buf_size<T>::value;
+    allocator_type get_allocator() const { return alloc_; }
 
 private:
+    // 配置器实例： alloc_ 负责缓冲区， map_alloc_ 负责控制中心
+    data_allocator     alloc_;
+    map_allocator      map_alloc_;
     // 以下四种数据结构来表示一个deque
     iterator           begin_; // 指向第一个节点， 其实是指向第一个节点的第一个元素
     iterator           end_;   // 指向最后一个节点， 其实是指向最后一个缓冲区的最后一个元素
     map_pointer        map_; // 指向一块map, map 中的每个元素都是一个指针， 指向一个缓冲区
     size_type          map_size_; // map 内指针的数目， 控制中心的大小
+    // 空闲缓冲区的缓存，map 中 [begin_.node, end_.node] 以外的位置始终为 nullptr
+    pointer            spare_[DEQUE_SPARE_BLOCKS];
+    size_type          spare_count_ = 0;
 
 
 public:
     // 构造函数
     deque()
     { fill_init(0, value_type()); }
+
+    explicit deque(const allocator_type& alloc)
+        : alloc_(alloc), map_alloc_(alloc)
+    { fill_init(0, value_type()); }
     
-    deque(size_type n)
+    explicit deque(size_type n, const allocator_type& alloc = allocator_type())
+        : alloc_(alloc), map_alloc_(alloc)
     { fill_init(n, value_type()); }
 
-    deque(size_type n, const value_type& value)
+    deque(size_type n, const value_type& value,
+          const allocator_type& alloc = allocator_type())
+        : alloc_(alloc), map_alloc_(alloc)
     { fill_init(n, value); }
 
     template <class IIter, typename std::enable_if<
         mystl::is_input_iterator<IIter>::value, int>::type = 0>
-    deque(IIter first, IIter last)
+    deque(IIter first, IIter last, const allocator_type& alloc = allocator_type())
+        : alloc_(alloc), map_alloc_(alloc)
     { copy_init(first, last, iterator_category(first)); }
 
-    deque(std::initializer_list<value_type> ilist)
+    deque(std::initializer_list<value_type> ilist,
+          const allocator_type& alloc = allocator_type())
+        : alloc_(alloc), map_alloc_(alloc)
     {
         copy_init(ilist.begin(), ilist.end(), mystl::forward_iterator_tag());
     }
     // 拷贝构造函数
-    deque(const deque& rhs){
+    deque(const deque& rhs)
+        : alloc_(rhs.alloc_), map_alloc_(rhs.map_alloc_)
+    {
         copy_init(rhs.begin(), rhs.end(), mystl::forward_iterator_tag());
     }
 
     // 移动构造函数
     deque(deque&& rhs)
-        : begin_(mystl::move(rhs.begin_)),
+        : alloc_(rhs.alloc_),
+        map_alloc_(rhs.map_alloc_),
+        begin_(mystl::move(rhs.begin_)),
         end_(mystl::move(rhs.end_)),
         map_(rhs.map_),
-        map_size_(rhs.map_size_)
+        map_size_(rhs.map_size_),
+        spare_count_(rhs.spare_count_)
     {
+        for (size_type i = 0; i < spare_count_; ++i)
+            spare_[i] = rhs.spare_[i];
+        rhs.spare_count_ = 0;
         rhs.map_ = nullptr;
         rhs.map_size_ = 0;
     }
@@ -267,7 +628,7 @@ public:
 
     deque& operator=(std::initializer_list<value_type> ilist)  // 列表初始化
     {
-    deque tmp(ilist);
+    deque tmp(ilist, alloc_);
     swap(tmp);
     return *this;
     }
@@ -277,9 +638,10 @@ public:
         if(map_ != nullptr)
         {
             clear();  // 元素清零
-            data_allocator::deallocate(*begin_.node, buffer_size); // 释放每个节点所占的内存
+            alloc_.deallocate(*begin_.node, buffer_size); // 释放每个节点所占的内存
             *begin_.node = nullptr;
-            map_allocator::deallocate(map_, map_size_); // 释放控制中心的内存
+            release_spares();
+            map_alloc_.deallocate(map_, map_size_); // 释放控制中心的内存
             map_ = nullptr;
         }      
     }
@@ -326,16 +688,19 @@ public:
     void shrink_to_fit()  noexcept;    
 
     // 访问元素相关操作
+    // n 不为负，直接由偏移量的高位和低位得到缓冲区和位置，不必经过迭代器的 +=
     reference  operator[](size_type n)
     {
         assert(n < size());
-        return begin_[n];
+        const size_type offset = n + (begin_.cur - begin_.first);
+        return begin_.node[offset >> iterator::buffer_shift][offset & iterator::buffer_mask];
     }
 
     const_reference  operator[](size_type n)  const
     {
         assert(n < size());
-        return begin_[n];
+        const size_type offset = n + (begin_.cur - begin_.first);
+        return begin_.node[offset >> iterator::buffer_shift][offset & iterator::buffer_mask];
     }
 
     reference     at(size_type n)
@@ -421,6 +786,9 @@ public:
     map_pointer create_map(size_type size);
     void        create_buffer(map_pointer nstart,  map_pointer nfinish);
     void        destroy_buffer(map_pointer nstart, map_pointer nfinish);
+    pointer     allocate_block();
+    void        release_block(pointer block) noexcept;
+    void        release_spares() noexcept;
 
     //initialize
     void        map_init(size_type nelem);
@@ -464,8 +832,8 @@ public:
 
 
 // 拷贝赋值
-template <class T>
-deque<T>& deque<T>::operator=(const deque& rhs){
+template <class T, class Alloc, size_t BufSize>
+deque<T, Alloc, BufSize>& deque<T, Alloc, BufSize>::operator=(const deque& rhs){
     if(this !=  &rhs){
         const auto len = size();
         if(len >= rhs.size()){   // 旧的 > 新的
@@ -481,32 +849,27 @@ deque<T>& deque<T>::operator=(const deque& rhs){
 }
 
 // 移动赋值
-template <class T>
-deque<T>& deque<T>::operator=(deque&& rhs){
-    clear(); // 将dq 清零
-    
-    begin_ = mystl::move(rhs.begin_);
-    end_ = mystl::move(rhs.end_);
-    map_ = rhs.map_;
-    map_size_ = rhs.map_size_;
-    map_ = nullptr;
-    map_size_ = 0;
+template <class T, class Alloc, size_t BufSize>
+deque<T, Alloc, BufSize>& deque<T, Alloc, BufSize>::operator=(deque&& rhs){
+    // 原有的空间交给 tmp 用它自己的配置器释放，再接管 rhs 的空间和配置器
+    deque tmp(mystl::move(rhs));
+    swap(tmp);
     return *this;
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class ...Args>
-void deque<T>::emplace_front(Args&& ...args){
+void deque<T, Alloc, BufSize>::emplace_front(Args&& ...args){
     // 当前节点不是首节点
     if(begin_.cur != begin_.first){
-        data_allocator::construct(begin_.cur - 1, mystl::forward<Args>(args)...);
+        mystl::construct(begin_.cur - 1, mystl::forward<Args>(args)...);
         --begin_.cur;
     }
     else{   // 当前节点是首节点
         requrie_capacity(1, true);
         try{
-            --begin_.cur;
-            data_allocator::construct(begin_.cur, mystl::forward<Args>(args)...);
+            --begin_;
+            mystl::construct(begin_.cur, mystl::forward<Args>(args)...);
         }
         catch(...){
             ++begin_;
@@ -516,24 +879,24 @@ void deque<T>::emplace_front(Args&& ...args){
 }
 
 // 在尾部插入元素
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class ...Args>
-void deque<T>::emplace_back(Args&& ...args){
+void deque<T, Alloc, BufSize>::emplace_back(Args&& ...args){
     // 当前节点不是尾节点
     if(end_.cur != end_.last - 1){
-        data_allocator::construct(end_.cur, mystl::forward<Args>(args)...);
+        mystl::construct(end_.cur, mystl::forward<Args>(args)...);
         ++end_.cur;
     }
     else{   // 当前节点是首节点
-        requrie_capacity(1, true);
-        data_allocator::construct(end_.cur, mystl::forward<Args>(args)...);
+        requrie_capacity(1, false);
+        mystl::construct(end_.cur, mystl::forward<Args>(args)...);
         ++end_;
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class ...Args>
-typename deque<T>::iterator deque<T>::emplace(iterator pos, Args&& ...args){
+typename deque<T, Alloc, BufSize>::iterator deque<T, Alloc, BufSize>::emplace(iterator pos, Args&& ...args){
     // 在队首插入
     if(pos.cur == begin_.cur){
         emplace_front(mystl::forward<Args>(args)...);
@@ -550,19 +913,19 @@ typename deque<T>::iterator deque<T>::emplace(iterator pos, Args&& ...args){
 
 
 // 在头部插入元素
-template <class T>
-void deque<T>::push_front(const value_type& value){
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::push_front(const value_type& value){
 
     // 当前节点不是首节点
     if(begin_.cur != begin_.first){
-        data_allocator::construct(begin_.cur - 1, value);
+        mystl::construct(begin_.cur - 1, value);
         --begin_.cur;
     }
     else{   // 当前节点是首节点
         requrie_capacity(1, true);
         try{
-            --begin_.cur;
-            data_allocator::construct(begin_.cur, value);
+            --begin_;
+            mystl::construct(begin_.cur, value);
         }
         catch(...){
             ++begin_;
@@ -571,16 +934,16 @@ void deque<T>::push_front(const value_type& value){
     }
 }
 // 在尾部添加元素
-template <class T>
-void deque<T>::push_back(const value_type& value){
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::push_back(const value_type& value){
     // 当前节点不是尾节点
     if(end_.cur != end_.last - 1){
-        data_allocator::construct(end_.cur, value);
+        mystl::construct(end_.cur, value);
         ++end_.cur;
     }
     else{   // 当前节点是首节点
         requrie_capacity(1, false);
-        data_allocator::construct(end_.cur, value);
+        mystl::construct(end_.cur, value);
         ++end_;
     }
 }
@@ -589,41 +952,41 @@ void deque<T>::push_back(const value_type& value){
 
 
 // 弹出头部元素
-template <class T>
-void deque<T>::pop_front()
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::pop_front()
 {   // 非空才能弹出
     assert(!empty());
     if(begin_.cur != begin_.last - 1){   // 如果第一个缓冲区有两个或者更多的元素
-        data_allocator::destroy(begin_.cur);
+        mystl::destroy(begin_.cur);
         ++begin_.cur;
     }
     else{              // 如果第一个缓冲区只有一个元素
-        data_allocator::destroy(begin_.cur);
+        mystl::destroy(begin_.cur);
         ++begin_;
         destroy_buffer(begin_.node - 1, begin_.node - 1);  // 这种情况， 要将缓冲区释放
     }
 }
 
 // 弹出尾部元素
-template <class T>
-void deque<T>::pop_back()
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::pop_back()
 {   // 非空才弹出
     assert(!empty());
     if(end_.cur != end_.first){  // 最后一个缓冲区有两个或者更多元素
         --end_.cur;
-        data_allocator::destroy(end_.cur);
+        mystl::destroy(end_.cur);
     }
     else{                        // 最后一个缓冲区只有
         --end_;
-        data_allocator::destroy(end_.cur);
+        mystl::destroy(end_.cur);
         destroy_buffer(end_.node + 1, end_.node + 1);
     }
 }
 
 // 在 position 处插入元素
-template <class T>
-typename deque<T>::iterator         // 传入参数是个左值，需要调用push_back 和 push_front
-deque<T>::insert(iterator position, const value_type& value)
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator         // 传入参数是个左值，需要调用push_back 和 push_front
+deque<T, Alloc, BufSize>::insert(iterator position, const value_type& value)
 {
   if (position.cur == begin_.cur)
   {
@@ -643,9 +1006,9 @@ deque<T>::insert(iterator position, const value_type& value)
   }
 }
 
-template <class T>
-typename deque<T>::iterator           // 传入参数是个右值，需要调用emplace_back 和emplace_front
-deque<T>::insert(iterator position, value_type&& value)
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator           // 传入参数是个右值，需要调用emplace_back 和emplace_front
+deque<T, Alloc, BufSize>::insert(iterator position, value_type&& value)
 {
   if (position.cur == begin_.cur)
   {
@@ -667,8 +1030,8 @@ deque<T>::insert(iterator position, value_type&& value)
 
 
 // 在pos 位置上插入n个值
-template <class T>
-void deque<T>::insert(iterator pos, size_type n, const value_type& value){
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::insert(iterator pos, size_type n, const value_type& value){
     // 插入点在最前端
     if(pos.cur == begin_.cur){
         requrie_capacity(n, true);
@@ -696,13 +1059,13 @@ void deque<T>::insert(iterator pos, size_type n, const value_type& value){
 
 
 // 清空 deque
-template <class T>
-void deque<T>::clear()
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::clear()
 {
   //! clear 会保留头部的缓冲区
   for (map_pointer cur = begin_.node + 1; cur < end_.node; ++cur)
   { // 释放map中对应的每个buffer
-    data_allocator::destroy(*cur, *cur + buffer_size);
+    mystl::destroy(*cur, *cur + buffer_size);
   }
   if (begin_.node != end_.node)
   { // 有两个以上的缓冲区
@@ -713,14 +1076,14 @@ void deque<T>::clear()
   {
     mystl::destroy(begin_.cur, end_.cur);
   }
-  shrink_to_fit();
   end_ = begin_;
+  shrink_to_fit();  // 先收拢 end_，才能连同中间的缓冲区一起释放
 }
 
 // 删除pos 位置上的元素
-template <class T>
-typename deque<T>::iterator
-deque<T>::erase(iterator position)
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator
+deque<T, Alloc, BufSize>::erase(iterator position)
 {
   auto next = position;
   ++next;
@@ -739,9 +1102,9 @@ deque<T>::erase(iterator position)
 }
 
 // 删除[first, last) 上的元素
-template <class T>
-typename deque<T>::iterator
-deque<T>::erase(iterator first, iterator last){
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator
+deque<T, Alloc, BufSize>::erase(iterator first, iterator last){
     if(first == begin_ && last == end_){
         clear();
         return end_;
@@ -752,13 +1115,15 @@ deque<T>::erase(iterator first, iterator last){
         if(elems_before < (size() - len) / 2){
             mystl::copy_backward(begin_, first, last);
             auto new_begin = begin_ + len;
-            data_allocator::destroy(begin_.cur, new_begin.cur);
+            mystl::destroy(begin_, new_begin);
+            destroy_buffer(begin_.node, new_begin.node - 1);  // 腾空的缓冲区交还
             begin_ = new_begin;
         }
         else{
             mystl::copy(last, end_, first); 
             auto new_end = end_ - len;
-            data_allocator::destroy(new_end.cur, end_.cur);  // 释放多余空间
+            mystl::destroy(new_end, end_);  // 释放多余空间
+            destroy_buffer(new_end.node + 1, end_.node);
             end_ = new_end;  
         }
         return begin_ + elems_before;
@@ -767,15 +1132,20 @@ deque<T>::erase(iterator first, iterator last){
 
 
 // 交换两个 deque
-template <class T>
-void deque<T>::swap(deque& rhs) noexcept
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::swap(deque& rhs) noexcept
 {
   if (this != &rhs)
-  { // 交换代表deque 数据结构的四个属性
+  { // 交换代表deque 数据结构的四个属性，以及对应的配置器
+    mystl::swap(alloc_, rhs.alloc_);
+    mystl::swap(map_alloc_, rhs.map_alloc_);
     mystl::swap(begin_, rhs.begin_);
     mystl::swap(end_, rhs.end_);
     mystl::swap(map_, rhs.map_);
     mystl::swap(map_size_, rhs.map_size_);
+    for (size_type i = 0; i < DEQUE_SPARE_BLOCKS; ++i)
+      mystl::swap(spare_[i], rhs.spare_[i]);
+    mystl::swap(spare_count_, rhs.spare_count_);
   }
 }
 
@@ -786,11 +1156,11 @@ void deque<T>::swap(deque& rhs) noexcept
 // helper functions
 
 // create_map 函数
-template <class T>
-typename deque<T>::map_pointer
-deque<T>::create_map(size_type size){
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::map_pointer
+deque<T, Alloc, BufSize>::create_map(size_type size){
     map_pointer mp = nullptr;
-    mp = map_allocator::allocate(size);
+    mp = map_alloc_.allocate(size);
     for(size_type i=0; i<size; ++i){
         *(mp + i) = nullptr;
     }
@@ -798,19 +1168,19 @@ deque<T>::create_map(size_type size){
 }
 
 // create_buffer 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::
 create_buffer(map_pointer nstart, map_pointer nfinish){
     map_pointer cur;
     try{
         for(cur = nstart; cur <= nfinish; cur++){
-            *cur = data_allocator::allocate(buffer_size);
+            *cur = allocate_block();
         }
     }
     catch(...){
         while(cur != nstart){
             --cur;
-            data_allocator::deallocate(*cur, buffer_size);
+            release_block(*cur);
             *cur = nullptr;
         }
         throw;
@@ -818,22 +1188,51 @@ create_buffer(map_pointer nstart, map_pointer nfinish){
 }
 
 // destroy_buffer 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::
 destroy_buffer(map_pointer nstart, map_pointer nfinish)
 {
   for (map_pointer n = nstart; n <= nfinish; ++n)
-  { // 释放每一个buffer空间
-    data_allocator::deallocate(*n, buffer_size);
+  { // 释放每一个buffer空间，先放入缓存
+    release_block(*n);
     *n = nullptr;
   }
 }
 
+// 取一个缓冲区，缓存中有空闲的就不再分配
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::pointer
+deque<T, Alloc, BufSize>::allocate_block()
+{
+  if (spare_count_ != 0)
+    return spare_[--spare_count_];
+  return alloc_.allocate(buffer_size);
+}
+
+// 归还一个缓冲区，缓存已满时才真正释放
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::release_block(pointer block) noexcept
+{
+  if (block == nullptr)
+    return;
+  if (spare_count_ < DEQUE_SPARE_BLOCKS)
+    spare_[spare_count_++] = block;
+  else
+    alloc_.deallocate(block, buffer_size);
+}
+
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::release_spares() noexcept
+{
+  while (spare_count_ != 0)
+    alloc_.deallocate(spare_[--spare_count_], buffer_size);
+}
+
 
 
 // map_init 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::
 map_init(size_type nElem)
 {
     const size_type nNode = nElem / buffer_size + 1; // 需要分配的缓冲区数量
@@ -859,7 +1258,7 @@ map_init(size_type nElem)
         create_buffer(nstart, nfinish);
     }
     catch(...){
-        map_allocator::deallocate(map_, map_size_);
+        map_alloc_.deallocate(map_, map_size_);
         map_ = nullptr;
         map_size_ = 0;
         throw;
@@ -872,8 +1271,8 @@ map_init(size_type nElem)
 }
 
 // fill_init 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::
 fill_init(size_type n, const value_type& value)
 {
     map_init(n);
@@ -887,9 +1286,9 @@ fill_init(size_type n, const value_type& value)
 }
 
 // copy_init 函数
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class IIter>
-void deque<T>::
+void deque<T, Alloc, BufSize>::
 copy_init(IIter first, IIter last, input_iterator_tag) // 用于构造函数中
 {
   const size_type n = mystl::distance(first, last);
@@ -898,9 +1297,9 @@ copy_init(IIter first, IIter last, input_iterator_tag) // 用于构造函数中
     emplace_back(*first);    // 通过迭代器， 利用一个dq 去初始化另一个dq
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class FIter>
-void deque<T>::
+void deque<T, Alloc, BufSize>::
 copy_init(FIter first, FIter last, forward_iterator_tag) //TODO 没看懂
 {
   const size_type n = mystl::distance(first, last);
@@ -919,27 +1318,28 @@ copy_init(FIter first, FIter last, forward_iterator_tag) //TODO 没看懂
 
 
 // 减小容器容量
-template <class T>
-void deque<T>::shrink_to_fit() noexcept
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::shrink_to_fit() noexcept
 {
   // 至少会留下头部缓冲区
   // 遍历map, 依次释放每个map 节点对应的缓冲区空间
   // 删除begin之前的空间
   for (auto cur = map_; cur < begin_.node; ++cur)
   {
-    data_allocator::deallocate(*cur, buffer_size);
+    alloc_.deallocate(*cur, buffer_size);
     *cur = nullptr;
   }
   // 删除end之后的空间
   for (auto cur = end_.node + 1; cur < map_ + map_size_; ++cur)
   {
-    data_allocator::deallocate(*cur, buffer_size);
+    alloc_.deallocate(*cur, buffer_size);
     *cur = nullptr;
   }
+  release_spares();
 }
 
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::
 fill_insert(iterator pos, size_type n, const value_type& value){
     const size_type elems_before = pos - begin_;
     const size_type len = size();
@@ -1009,8 +1409,8 @@ fill_insert(iterator pos, size_type n, const value_type& value){
 }
 
 // fill_assign 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::
 fill_assign(size_type n, const value_type& value)
 {
   if (n > size())
@@ -1026,9 +1426,9 @@ fill_assign(size_type n, const value_type& value)
 }
 
 // copy_assign 函数
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class IIter>
-void deque<T>::
+void deque<T, Alloc, BufSize>::
 copy_assign(IIter first, IIter last, input_iterator_tag)
 {
   auto first1 = begin();
@@ -1047,9 +1447,9 @@ copy_assign(IIter first, IIter last, input_iterator_tag)
   }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class FIter>
-void deque<T>::
+void deque<T, Alloc, BufSize>::
 copy_assign(FIter first, FIter last, forward_iterator_tag)
 {  
   const size_type len1 = size();
@@ -1069,10 +1469,10 @@ copy_assign(FIter first, FIter last, forward_iterator_tag)
 
 
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class ...Args>
-typename deque<T>::iterator
-deque<T>::insert_aux(iterator pos, Args&& ...args){
+typename deque<T, Alloc, BufSize>::iterator
+deque<T, Alloc, BufSize>::insert_aux(iterator pos, Args&& ...args){
     const size_type elems_before = pos - begin_;
     value_type value_copy = value_type(mystl::forward<Args>(args)...);
     // 插入点之前的元素比较少， 在前半段插入
@@ -1101,9 +1501,9 @@ deque<T>::insert_aux(iterator pos, Args&& ...args){
 }
 
 // insert_dispatch 函数
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class IIter>
-void deque<T>::
+void deque<T, Alloc, BufSize>::
 insert_dispatch(iterator position, IIter first, IIter last, input_iterator_tag)
 {
   if (last <= first)  return;
@@ -1125,9 +1525,9 @@ insert_dispatch(iterator position, IIter first, IIter last, input_iterator_tag)
   }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class FIter>
-void deque<T>::
+void deque<T, Alloc, BufSize>::
 insert_dispatch(iterator position, FIter first, FIter last, forward_iterator_tag)
 {
   if (last <= first)  return;
@@ -1171,9 +1571,9 @@ insert_dispatch(iterator position, FIter first, FIter last, forward_iterator_tag
 }
 
 // copy_insert
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class FIter>
-void deque<T>::
+void deque<T, Alloc, BufSize>::
 copy_insert(iterator position, FIter first, FIter last, size_type n)
 {
   const size_type elems_before = position - begin_;
@@ -1253,11 +1653,12 @@ copy_insert(iterator position, FIter first, FIter last, size_type n)
 
 
 // require_capacity 函数
-template <class T>
-void deque<T>::requrie_capacity(size_type n, bool front){
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::requrie_capacity(size_type n, bool front){
                                 // 头部备用空间不够分配， 必须重新开辟空间
     if(front && (static_cast<size_type>(begin_.cur - begin_.first) < n)){
-        const size_type need_buffer = (n - (begin_.cur - begin_.first)) / buffer_size + 1;
+        // 向上取整；多分配的缓冲区落在 begin_ 之外，之后会被覆盖而泄漏
+        const size_type need_buffer = (n - (begin_.cur - begin_.first) - 1) / buffer_size + 1;
         if(need_buffer > static_cast<size_type>(begin_.node - map_)){
             reallocate_map_at_front(need_buffer);
             return;
@@ -1275,8 +1676,20 @@ void deque<T>::requrie_capacity(size_type n, bool front){
 }
 
 // reallocate_map_at_front 函数
-template <class T>
-void deque<T>::reallocate_map_at_front(size_type need_buffer){
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::reallocate_map_at_front(size_type need_buffer){
+    const size_type live_buffer = end_.node - begin_.node + 1;
+    if(map_size_ >= 2 * (live_buffer + need_buffer)){
+        // map 有一半以上是空的，说明只是使用位置偏到了一端，把已用的指针移回中间
+        auto begin = map_ + (map_size_ - live_buffer - need_buffer) / 2;
+        auto mid = begin + need_buffer;
+        mystl::copy_backward(begin_.node, end_.node + 1, mid + live_buffer);
+        mystl::fill(begin_.node, mid, nullptr);
+        begin_.node = mid;
+        end_.node = mid + live_buffer - 1;
+        create_buffer(begin, mid - 1);
+        return;
+    }
     // 二倍扩容机制
     const size_type new_map_size = mystl::max(map_size_ << 1, 
                                                map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
@@ -1290,21 +1703,32 @@ void deque<T>::reallocate_map_at_front(size_type need_buffer){
     auto end = mid + old_buffer;
     create_buffer(begin, mid-1); // 为新开辟的map创建buffer
 
-    // 将原来的值复制到新的map 中
-    for(auto begin1 = mid, begin2 = begin_.node; begin1 != end; ++begin1, ++begin2)
-        *begin1 = *begin2;
+    // 将原来的缓冲区指针搬到新的map 中
+    mystl::uninitialized_relocate(begin_.node, end_.node + 1, mid);
 
     // 更新数据
-    map_allocator::deallocate(map_, map_size_); // 释放原来的空间
+    map_alloc_.deallocate(map_, map_size_); // 释放原来的空间
     map_ = new_map;
     map_size_ = new_map_size;
     begin_ = iterator(*mid + (begin_.cur - begin_.first), mid);
     end_ = iterator(*(end - 1) + (end_.cur - end_.first), end - 1);
 }
 
-template <class T>
-void deque<T>::reallocate_map_at_back(size_type need_buffer)
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::reallocate_map_at_back(size_type need_buffer)
 {
+  const size_type live_buffer = end_.node - begin_.node + 1;
+  if (map_size_ >= 2 * (live_buffer + need_buffer))
+  { // 同上，原地移回中间，队列式的使用不会让 map 无限增长
+    auto begin = map_ + (map_size_ - live_buffer - need_buffer) / 2;
+    auto mid = begin + live_buffer;
+    mystl::copy(begin_.node, end_.node + 1, begin);
+    mystl::fill(mid, end_.node + 1, nullptr);
+    begin_.node = begin;
+    end_.node = mid - 1;
+    create_buffer(mid, mid + need_buffer - 1);
+    return;
+  }
   const size_type new_map_size = mystl::max(map_size_ << 1,
                                             map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
   map_pointer new_map = create_map(new_map_size);
@@ -1315,12 +1739,11 @@ void deque<T>::reallocate_map_at_back(size_type need_buffer)
   auto begin = new_map + ((new_map_size - new_buffer) / 2);
   auto mid = begin + old_buffer;
   auto end = mid + need_buffer;
-  for (auto begin1 = begin, begin2 = begin_.node; begin1 != mid; ++begin1, ++begin2)
-    *begin1 = *begin2;
+  mystl::uninitialized_relocate(begin_.node, end_.node + 1, begin);
   create_buffer(mid, end - 1);
 
   // 更新数据
-  map_allocator::deallocate(map_, map_size_);
+  map_alloc_.deallocate(map_, map_size_);
   map_ = new_map;
   map_size_ = new_map_size;
   begin_ = iterator(*begin + (begin_.cur - begin_.first), begin);
@@ -1328,47 +1751,52 @@ void deque<T>::reallocate_map_at_back(size_type need_buffer)
 }
 
 // 重载比较操作符
-template <class T>
-bool operator==(const deque<T>& lhs, const deque<T>& rhs)
+template <class T, class Alloc, size_t BufSize>
+bool operator==(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs)
 {
   return lhs.size() == rhs.size() && 
     mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T>
-bool operator<(const deque<T>& lhs, const deque<T>& rhs)
+template <class T, class Alloc, size_t BufSize>
+bool operator<(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs)
 {
   return mystl::lexicographical_compare(
     lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T>
-bool operator!=(const deque<T>& lhs, const deque<T>& rhs)
+template <class T, class Alloc, size_t BufSize>
+bool operator!=(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs)
 {
   return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const deque<T>& lhs, const deque<T>& rhs)
+template <class T, class Alloc, size_t BufSize>
+bool operator>(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs)
 {
   return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const deque<T>& lhs, const deque<T>& rhs)
+template <class T, class Alloc, size_t BufSize>
+bool operator<=(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs)
 {
   return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const deque<T>& lhs, const deque<T>& rhs)
+template <class T, class Alloc, size_t BufSize>
+bool operator>=(const deque<T, Alloc, BufSize>& lhs, const deque<T, Alloc, BufSize>& rhs)
 {
   return !(lhs < rhs);
 }
 
+// map 和缓冲区都在堆上，迭代器也只指向堆上的空间，deque 对象可以按字节搬移
+template <class T, class Alloc, size_t BufSize>
+struct is_trivially_relocatable<deque<T, Alloc, BufSize>>
+  : std::integral_constant<bool, is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
-template <class T>
-void swap(deque<T>& lhs, deque<T>& rhs)
+template <class T, class Alloc, size_t BufSize>
+void swap(deque<T, Alloc, BufSize>& lhs, deque<T, Alloc, BufSize>& rhs)
 {
   lhs.swap(rhs);
 }
@@ -0,0 +1,581 @@
+#ifndef MYSTL_DYNAMIC_BITSET_H
+#define MYSTL_DYNAMIC_BITSET_H
+
+// 这个头文件包含一个模板类 basic_dynamic_bitset 及其别名 dynamic_bitset
+// dynamic_bitset : 长度可变的位集合，每 64 位打包成一个字存放在 vector 中，内存只有 vector<char> 的 1/8
+// count / any / none 使用 popcount，&= |= ^= and_not 在支持 AVX2 的 x86 上每次处理 256 位，
+// find_first / find_next 用 tzcnt 直接跳到下一个置位
+
+#include <cstdint>
+#include <string>
+
+#include "platform.h"
+#include "vector.h"
+#include "exceptdef.h"
+
+#if (defined(REDBUD_GNUC) || defined(REDBUD_CLANG)) && (defined(__x86_64__) || defined(__i386__))
+  #include <immintrin.h>
+  #define MYSTL_BITSET_AVX2 1
+  #define MYSTL_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#endif
+
+#if defined(REDBUD_MSVC)
+  #include <intrin.h>
+#endif
+
+namespace mystl
+{
+
+namespace bitset_detail
+{
+
+typedef uint64_t word_type;
+
+static constexpr size_t bits_per_word = 64;
+
+inline size_t popcount64(word_type w) noexcept
+{
+#if defined(REDBUD_MSVC) && defined(_M_X64)
+  return static_cast<size_t>(__popcnt64(w));
+#elif defined(REDBUD_MSVC)
+  w = w - ((w >> 1) & 0x5555555555555555ULL);
+  w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+  w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return static_cast<size_t>((w * 0x0101010101010101ULL) >> 56);
+#else
+  return static_cast<size_t>(__builtin_popcountll(w));
+#endif
+}
+
+// w 不能为 0
+inline size_t ctz64(word_type w) noexcept
+{
+#if defined(REDBUD_MSVC) && defined(_M_X64)
+  unsigned long idx;
+  _BitScanForward64(&idx, w);
+  return static_cast<size_t>(idx);
+#elif defined(REDBUD_MSVC)
+  size_t n = 0;
+  while (!(w & 1)) { w >>= 1; ++n; }
+  return n;
+#else
+  return static_cast<size_t>(__builtin_ctzll(w));
+#endif
+}
+
+// 逐字运算
+struct op_and    { static word_type apply(word_type a, word_type b) noexcept { return a & b; } };
+struct op_or     { static word_type apply(word_type a, word_type b) noexcept { return a | b; } };
+struct op_xor    { static word_type apply(word_type a, word_type b) noexcept { return a ^ b; } };
+struct op_andnot { static word_type apply(word_type a, word_type b) noexcept { return a & ~b; } };
+
+template <class Op>
+inline void combine_scalar(word_type* dst, const word_type* src, size_t n) noexcept
+{
+  for (size_t i = 0; i < n; ++i)
+    dst[i] = Op::apply(dst[i], src[i]);
+}
+
+inline size_t popcount_scalar(const word_type* p, size_t n) noexcept
+{
+  size_t c = 0;
+  for (size_t i = 0; i < n; ++i)
+    c += popcount64(p[i]);
+  return c;
+}
+
+#if MYSTL_BITSET_AVX2
+
+// 编译选项中没有 -mavx2 时，按 CPU 的实际支持情况在运行时选择
+inline bool has_avx2() noexcept
+{
+#if defined(__AVX2__)
+  return true;
+#else
+  static const bool r = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+  return r;
+#endif
+}
+
+MYSTL_TARGET_AVX2 inline __m256i avx2_apply(op_and, __m256i a, __m256i b)    { return _mm256_and_si256(a, b); }
+MYSTL_TARGET_AVX2 inline __m256i avx2_apply(op_or, __m256i a, __m256i b)     { return _mm256_or_si256(a, b); }
+MYSTL_TARGET_AVX2 inline __m256i avx2_apply(op_xor, __m256i a, __m256i b)    { return _mm256_xor_si256(a, b); }
+MYSTL_TARGET_AVX2 inline __m256i avx2_apply(op_andnot, __m256i a, __m256i b) { return _mm256_andnot_si256(b, a); }
+
+template <class Op>
+MYSTL_TARGET_AVX2 void combine_avx2(word_type* dst, const word_type* src, size_t n) noexcept
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+    __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i + 4));
+    __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 4));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), avx2_apply(Op(), a0, b0));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 4), avx2_apply(Op(), a1, b1));
+  }
+  for (; i < n; ++i)
+    dst[i] = Op::apply(dst[i], src[i]);
+}
+
+// 每个字节拆成高低两个半字节查表求 1 的个数，再用 sad 把 32 个字节累加到 4 个 64 位计数中
+// 字节计数每轮最多加 8，累加 31 轮内不会溢出
+MYSTL_TARGET_AVX2 inline size_t popcount_avx2(const word_type* p, size_t n) noexcept
+{
+  const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                          0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i total = _mm256_setzero_si256();
+  size_t i = 0;
+  while (i + 4 <= n)
+  {
+    __m256i local = _mm256_setzero_si256();
+    for (int k = 0; k < 31 && i + 4 <= n; ++k, i += 4)
+    {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+      const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low_mask));
+      const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+      local = _mm256_add_epi8(local, _mm256_add_epi8(lo, hi));
+    }
+    total = _mm256_add_epi64(total, _mm256_sad_epu8(local, _mm256_setzero_si256()));
+  }
+  // _mm256_extract_epi64 只在 x86_64 上提供，存到内存再相加，32 位平台也能用
+  alignas(32) uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+  size_t c = static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+  for (; i < n; ++i)
+    c += static_cast<size_t>(__builtin_popcountll(p[i]));
+  return c;
+}
+
+// 任意一个字不为 0 即返回 true，每次检查 256 位
+MYSTL_TARGET_AVX2 inline bool any_avx2(const word_type* p, size_t n) noexcept
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    if (!_mm256_testz_si256(v, v))
+      return true;
+  }
+  for (; i < n; ++i)
+    if (p[i])
+      return true;
+  return false;
+}
+
+#endif // MYSTL_BITSET_AVX2
+
+template <class Op>
+inline void combine(word_type* dst, const word_type* src, size_t n) noexcept
+{
+#if MYSTL_BITSET_AVX2
+  if (has_avx2())
+  {
+    combine_avx2<Op>(dst, src, n);
+    return;
+  }
+#endif
+  combine_scalar<Op>(dst, src, n);
+}
+
+inline size_t popcount(const word_type* p, size_t n) noexcept
+{
+#if MYSTL_BITSET_AVX2
+  if (has_avx2())
+    return popcount_avx2(p, n);
+#endif
+  return popcount_scalar(p, n);
+}
+
+inline bool any(const word_type* p, size_t n) noexcept
+{
+#if MYSTL_BITSET_AVX2
+  if (has_avx2())
+    return any_avx2(p, n);
+#endif
+  for (size_t i = 0; i < n; ++i)
+    if (p[i])
+      return true;
+  return false;
+}
+
+} // namespace bitset_detail
+
+// 模板类: basic_dynamic_bitset
+// 模板参数 Alloc 为存放字的空间配置器，大位集可以使用 huge_page_allocator<uint64_t>
+// 始终保持最后一个字中超出 size() 的位为 0，count / any / 比较等操作可以直接按字处理
+template <class Alloc = mystl::allocator<uint64_t>>
+class basic_dynamic_bitset
+{
+public:
+  typedef bitset_detail::word_type                 word_type;
+  typedef Alloc                                    allocator_type;
+  typedef size_t                                   size_type;
+
+  static constexpr size_type bits_per_word = bitset_detail::bits_per_word;
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+  // 单个位的代理引用
+  class reference
+  {
+    friend class basic_dynamic_bitset;
+    word_type* word_;
+    word_type  mask_;
+
+    reference(word_type* w, size_type bit) noexcept
+      :word_(w), mask_(word_type(1) << bit) {}
+
+  public:
+    reference& operator=(bool v) noexcept
+    {
+      if (v) *word_ |= mask_;
+      else   *word_ &= ~mask_;
+      return *this;
+    }
+    reference& operator=(const reference& rhs) noexcept { return *this = static_cast<bool>(rhs); }
+    operator bool() const noexcept { return (*word_ & mask_) != 0; }
+    bool operator~() const noexcept { return (*word_ & mask_) == 0; }
+    reference& flip() noexcept { *word_ ^= mask_; return *this; }
+  };
+
+private:
+  typedef mystl::vector<word_type, Alloc> storage_type;
+
+  storage_type words_;  // 按字存放的位，第 i 位在 words_[i / 64] 的第 i % 64 位
+  size_type    size_;   // 位数
+
+public:
+  // 构造、复制、移动、析构函数
+  basic_dynamic_bitset() noexcept
+    :words_(), size_(0)
+  {
+  }
+
+  explicit basic_dynamic_bitset(const allocator_type& alloc) noexcept
+    :words_(alloc), size_(0)
+  {
+  }
+
+  explicit basic_dynamic_bitset(size_type n, bool value = false,
+                                const allocator_type& alloc = allocator_type())
+    :words_(words_for(n), value ? ~word_type(0) : word_type(0), alloc), size_(n)
+  {
+    clear_unused_bits();
+  }
+
+  basic_dynamic_bitset(const basic_dynamic_bitset& rhs) = default;
+  basic_dynamic_bitset(basic_dynamic_bitset&& rhs) noexcept
+    :words_(mystl::move(rhs.words_)), size_(rhs.size_)
+  {
+    rhs.size_ = 0;
+  }
+
+  basic_dynamic_bitset& operator=(const basic_dynamic_bitset& rhs) = default;
+  basic_dynamic_bitset& operator=(basic_dynamic_bitset&& rhs) noexcept
+  {
+    words_ = mystl::move(rhs.words_);
+    size_ = rhs.size_;
+    rhs.size_ = 0;
+    return *this;
+  }
+
+  ~basic_dynamic_bitset() = default;
+
+public:
+  // 容量相关操作
+  bool      empty()     const noexcept { return size_ == 0; }
+  size_type size()      const noexcept { return size_; }
+  size_type num_words() const noexcept { return words_.size(); }
+  size_type capacity()  const noexcept { return words_.capacity() * bits_per_word; }
+  void      reserve(size_type n)       { words_.reserve(words_for(n)); }
+  void      shrink_to_fit()            { words_.shrink_to_fit(); }
+
+  allocator_type get_allocator() const { return words_.get_allocator(); }
+
+  // 直接访问底层的字，可以交给其他按字处理的代码；修改后需保证超出 size() 的位为 0
+  word_type*       data()       noexcept { return words_.data(); }
+  const word_type* data() const noexcept { return words_.data(); }
+
+  // 访问元素相关操作
+  bool operator[](size_type pos) const
+  {
+    MYSTL_DEBUG(pos < size_);
+    return (words_[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+  }
+  reference operator[](size_type pos)
+  {
+    MYSTL_DEBUG(pos < size_);
+    return reference(&words_[pos / bits_per_word], pos % bits_per_word);
+  }
+  bool test(size_type pos) const
+  {
+    THROW_OUT_OF_RANGE_IF(!(pos < size_), "dynamic_bitset<Alloc>::test() subscript out of range");
+    return (*this)[pos];
+  }
+
+  // 修改单个位或全部位
+  basic_dynamic_bitset& set(size_type pos, bool value = true)
+  {
+    THROW_OUT_OF_RANGE_IF(!(pos < size_), "dynamic_bitset<Alloc>::set() subscript out of range");
+    (*this)[pos] = value;
+    return *this;
+  }
+  basic_dynamic_bitset& reset(size_type pos) { return set(pos, false); }
+  basic_dynamic_bitset& flip(size_type pos)
+  {
+    THROW_OUT_OF_RANGE_IF(!(pos < size_), "dynamic_bitset<Alloc>::flip() subscript out of range");
+    words_[pos / bits_per_word] ^= word_type(1) << (pos % bits_per_word);
+    return *this;
+  }
+
+  basic_dynamic_bitset& set();
+  basic_dynamic_bitset& reset();
+  basic_dynamic_bitset& flip();
+
+  // 统计与查找
+  size_type count() const noexcept
+  { return bitset_detail::popcount(words_.data(), words_.size()); }
+  bool      any()   const noexcept
+  { return bitset_detail::any(words_.data(), words_.size()); }
+  bool      none()  const noexcept { return !any(); }
+  bool      all()   const noexcept;
+
+  // 返回第一个 / pos 之后第一个为 1 的位的下标，没有时返回 npos
+  size_type find_first() const noexcept { return find_from(0); }
+  size_type find_next(size_type pos) const noexcept
+  { return pos == npos ? npos : find_from(pos + 1); }
+
+  // 按位运算，两个位集的长度必须相同
+  basic_dynamic_bitset& operator&=(const basic_dynamic_bitset& rhs)
+  { return combine<bitset_detail::op_and>(rhs); }
+  basic_dynamic_bitset& operator|=(const basic_dynamic_bitset& rhs)
+  { return combine<bitset_detail::op_or>(rhs); }
+  basic_dynamic_bitset& operator^=(const basic_dynamic_bitset& rhs)
+  { return combine<bitset_detail::op_xor>(rhs); }
+  // *this &= ~rhs，不生成 ~rhs 的临时对象
+  basic_dynamic_bitset& and_not(const basic_dynamic_bitset& rhs)
+  { return combine<bitset_detail::op_andnot>(rhs); }
+  basic_dynamic_bitset& operator-=(const basic_dynamic_bitset& rhs)
+  { return and_not(rhs); }
+
+  basic_dynamic_bitset  operator~() const
+  {
+    basic_dynamic_bitset tmp(*this);
+    tmp.flip();
+    return tmp;
+  }
+
+  // 修改容器相关操作
+  void push_back(bool value)
+  {
+    if (size_ % bits_per_word == 0)
+      words_.push_back(word_type(0));
+    if (value)
+      words_.back() |= word_type(1) << (size_ % bits_per_word);
+    ++size_;
+  }
+
+  void pop_back()
+  {
+    MYSTL_DEBUG(size_ != 0);
+    --size_;
+    if (size_ % bits_per_word == 0)
+      words_.pop_back();
+    else
+      clear_unused_bits();
+  }
+
+  void resize(size_type n, bool value = false);
+  void clear() noexcept
+  {
+    words_.clear();
+    size_ = 0;
+  }
+
+  void swap(basic_dynamic_bitset& rhs) noexcept
+  {
+    words_.swap(rhs.words_);
+    mystl::swap(size_, rhs.size_);
+  }
+
+  // 高位在前转换为 '0' / '1' 组成的字符串，与 std::bitset 一致
+  std::string to_string() const;
+
+  friend bool operator==(const basic_dynamic_bitset& lhs, const basic_dynamic_bitset& rhs)
+  { return lhs.size_ == rhs.size_ && lhs.words_ == rhs.words_; }
+
+private:
+  // helper functions
+  static size_type words_for(size_type n) noexcept
+  { return n / bits_per_word + (n % bits_per_word != 0); }
+
+  // 把最后一个字中超出 size() 的位清零
+  void clear_unused_bits() noexcept
+  {
+    const size_type extra = size_ % bits_per_word;
+    if (extra != 0)
+      words_.back() &= (word_type(1) << extra) - 1;
+  }
+
+  size_type find_from(size_type pos) const noexcept;
+
+  template <class Op>
+  basic_dynamic_bitset& combine(const basic_dynamic_bitset& rhs)
+  {
+    THROW_LENGTH_ERROR_IF(size_ != rhs.size_, "dynamic_bitset<Alloc> sizes differ");
+    bitset_detail::combine<Op>(words_.data(), rhs.words_.data(), words_.size());
+    return *this;
+  }
+};
+
+/*****************************************************************************************/
+
+template <class Alloc>
+constexpr typename basic_dynamic_bitset<Alloc>::size_type basic_dynamic_bitset<Alloc>::bits_per_word;
+
+template <class Alloc>
+constexpr typename basic_dynamic_bitset<Alloc>::size_type basic_dynamic_bitset<Alloc>::npos;
+
+// 全部置 1
+template <class Alloc>
+basic_dynamic_bitset<Alloc>& basic_dynamic_bitset<Alloc>::set()
+{
+  mystl::fill(words_.begin(), words_.end(), ~word_type(0));
+  clear_unused_bits();
+  return *this;
+}
+
+// 全部置 0
+template <class Alloc>
+basic_dynamic_bitset<Alloc>& basic_dynamic_bitset<Alloc>::reset()
+{
+  mystl::fill(words_.begin(), words_.end(), word_type(0));
+  return *this;
+}
+
+// 全部取反
+template <class Alloc>
+basic_dynamic_bitset<Alloc>& basic_dynamic_bitset<Alloc>::flip()
+{
+  for (auto& w : words_)
+    w = ~w;
+  clear_unused_bits();
+  return *this;
+}
+
+// 是否全部为 1
+template <class Alloc>
+bool basic_dynamic_bitset<Alloc>::all() const noexcept
+{
+  const size_type full = size_ / bits_per_word;
+  for (size_type i = 0; i < full; ++i)
+  {
+    if (words_[i] != ~word_type(0))
+      return false;
+  }
+  const size_type extra = size_ % bits_per_word;
+  return extra == 0 || words_[full] == (word_type(1) << extra) - 1;
+}
+
+// 从 pos 开始查找第一个 1，整字为 0 时直接跳过
+template <class Alloc>
+typename basic_dynamic_bitset<Alloc>::size_type
+basic_dynamic_bitset<Alloc>::find_from(size_type pos) const noexcept
+{
+  if (pos >= size_)
+    return npos;
+  size_type i = pos / bits_per_word;
+  word_type w = words_[i] & (~word_type(0) << (pos % bits_per_word));
+  const size_type n = words_.size();
+  while (w == 0)
+  {
+    if (++i == n)
+      return npos;
+    w = words_[i];
+  }
+  return i * bits_per_word + bitset_detail::ctz64(w);
+}
+
+// 改变位数，新增的位都置为 value
+template <class Alloc>
+void basic_dynamic_bitset<Alloc>::resize(size_type n, bool value)
+{
+  const size_type extra = size_ % bits_per_word;
+  if (n > size_ && value && extra != 0)
+    words_.back() |= ~word_type(0) << extra;  // 原最后一个字中新增的位
+  words_.resize(words_for(n), value ? ~word_type(0) : word_type(0));
+  size_ = n;
+  clear_unused_bits();
+}
+
+template <class Alloc>
+std::string basic_dynamic_bitset<Alloc>::to_string() const
+{
+  std::string s(size_, '0');
+  for (size_type i = find_first(); i != npos; i = find_next(i))
+    s[size_ - 1 - i] = '1';
+  return s;
+}
+
+// 二元按位运算
+
+template <class Alloc>
+basic_dynamic_bitset<Alloc> operator&(const basic_dynamic_bitset<Alloc>& lhs,
+                                      const basic_dynamic_bitset<Alloc>& rhs)
+{
+  basic_dynamic_bitset<Alloc> tmp(lhs);
+  tmp &= rhs;
+  return tmp;
+}
+
+template <class Alloc>
+basic_dynamic_bitset<Alloc> operator|(const basic_dynamic_bitset<Alloc>& lhs,
+                                      const basic_dynamic_bitset<Alloc>& rhs)
+{
+  basic_dynamic_bitset<Alloc> tmp(lhs);
+  tmp |= rhs;
+  return tmp;
+}
+
+template <class Alloc>
+basic_dynamic_bitset<Alloc> operator^(const basic_dynamic_bitset<Alloc>& lhs,
+                                      const basic_dynamic_bitset<Alloc>& rhs)
+{
+  basic_dynamic_bitset<Alloc> tmp(lhs);
+  tmp ^= rhs;
+  return tmp;
+}
+
+template <class Alloc>
+basic_dynamic_bitset<Alloc> operator-(const basic_dynamic_bitset<Alloc>& lhs,
+                                      const basic_dynamic_bitset<Alloc>& rhs)
+{
+  basic_dynamic_bitset<Alloc> tmp(lhs);
+  tmp.and_not(rhs);
+  return tmp;
+}
+
+template <class Alloc>
+bool operator!=(const basic_dynamic_bitset<Alloc>& lhs, const basic_dynamic_bitset<Alloc>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+typedef basic_dynamic_bitset<> dynamic_bitset;
+
+// 只持有一个 vector，可以随 vector 一起按字节搬移
+template <class Alloc>
+struct is_trivially_relocatable<basic_dynamic_bitset<Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<mystl::vector<uint64_t, Alloc>>::value> {};
+
+// 重载 mystl 的 swap
+template <class Alloc>
+void swap(basic_dynamic_bitset<Alloc>& lhs, basic_dynamic_bitset<Alloc>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYSTL_DYNAMIC_BITSET_H
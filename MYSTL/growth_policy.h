@@ -0,0 +1,116 @@
+#ifndef MYSTL_GROWTH_POLICY_H
+#define MYSTL_GROWTH_POLICY_H
+
+// 这个头文件包含 vector 的增长策略
+// 每个策略提供静态函数 new_capacity(cap, required, elem_size, max_n)：
+// 当前容量为 cap、至少需要 required 个元素时返回新的容量，结果不小于 required、不大于 max_n
+// 使用方式：mystl::vector<int, mystl::allocator<int>, mystl::growth_2x> v;
+
+#include <cstddef>
+
+namespace mystl
+{
+
+namespace growth_detail
+{
+
+// 按 factor_num / factor_den 倍扩容，容量为 0 时至少取 min_cap
+inline size_t geometric(size_t cap, size_t required, size_t max_n,
+                        size_t factor_num, size_t factor_den, size_t min_cap) noexcept
+{
+  if (cap == 0)
+    return required > min_cap ? required : (min_cap < max_n ? min_cap : max_n);
+  if (cap > max_n / factor_num * factor_den)  // 再扩容会超出 max_n
+    return required;
+  const size_t grown = cap / factor_den * factor_num + cap % factor_den * factor_num / factor_den;
+  return grown > required ? grown : required;
+}
+
+// 把 n 个元素占用的字节数向上取整到 align 的倍数，再换算回元素个数
+inline size_t round_elements(size_t n, size_t elem_size, size_t align, size_t max_n) noexcept
+{
+  if (n > (static_cast<size_t>(-1) - align) / elem_size)
+    return n;
+  const size_t bytes = (n * elem_size + align - 1) / align * align;
+  const size_t r = bytes / elem_size;
+  return r > max_n ? n : r;
+}
+
+// 与常见 malloc（jemalloc / tcmalloc 等）的大小分级一致：
+// 16 字节以内取 16，之后每个 2 的幂区间再均分为 4 级
+inline size_t size_class(size_t bytes) noexcept
+{
+  if (bytes <= 16)
+    return 16;
+  size_t high = 16;
+  while (high < bytes && high <= (static_cast<size_t>(-1) >> 1))
+    high <<= 1;
+  const size_t step = high / 8 < 16 ? 16 : high / 8;  // (high / 2, high] 之间分为 4 级
+  if (bytes > static_cast<size_t>(-1) - step)
+    return bytes;
+  return (bytes + step - 1) / step * step;
+}
+
+} // namespace growth_detail
+
+// 1.5 倍扩容，第一次至少分配 16 个元素（vector 的缺省策略）
+struct growth_1_5x
+{
+  static size_t new_capacity(size_t cap, size_t required, size_t, size_t max_n) noexcept
+  {
+    return growth_detail::geometric(cap, required, max_n, 3, 2, 16);
+  }
+};
+
+// 2 倍扩容，第一次至少分配 16 个元素
+struct growth_2x
+{
+  static size_t new_capacity(size_t cap, size_t required, size_t, size_t max_n) noexcept
+  {
+    return growth_detail::geometric(cap, required, max_n, 2, 1, 16);
+  }
+};
+
+// 第一次恰好分配所需的个数，之后按 Base 的倍数扩容
+// 适合大小事先已知、很少再增长的 vector
+template <class Base = growth_1_5x>
+struct growth_exact_then
+{
+  static size_t new_capacity(size_t cap, size_t required, size_t elem_size, size_t max_n) noexcept
+  {
+    return cap == 0 ? required : Base::new_capacity(cap, required, elem_size, max_n);
+  }
+};
+
+typedef growth_exact_then<growth_1_5x> growth_exact_then_geometric;
+
+// 在 Base 的基础上，把占用的字节数取整到 PageSize 的倍数，多出来的部分直接作为容量
+// 适合大块内存，与 huge_page_allocator 一起使用时不会浪费映射的尾部
+template <class Base = growth_1_5x, size_t PageSize = 4096>
+struct growth_page_rounded
+{
+  static_assert((PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+  static size_t new_capacity(size_t cap, size_t required, size_t elem_size, size_t max_n) noexcept
+  {
+    const size_t n = Base::new_capacity(cap, required, elem_size, max_n);
+    return growth_detail::round_elements(n, elem_size, PageSize, max_n);
+  }
+};
+
+// 在 Base 的基础上，把占用的字节数取整到 malloc 的大小分级，分配器本来就会多给的空间算入容量
+template <class Base = growth_1_5x>
+struct growth_size_class
+{
+  static size_t new_capacity(size_t cap, size_t required, size_t elem_size, size_t max_n) noexcept
+  {
+    const size_t n = Base::new_capacity(cap, required, elem_size, max_n);
+    if (n > static_cast<size_t>(-1) / elem_size)
+      return n;
+    const size_t r = growth_detail::size_class(n * elem_size) / elem_size;
+    return r < n || r > max_n ? n : r;
+  }
+};
+
+} // namespace mystl
+#endif // !MYSTL_GROWTH_POLICY_H
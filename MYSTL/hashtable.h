@@ -117,14 +117,14 @@ struct ht_value_traits
 
 
 // 声明
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class Alloc>
 class hashtable;
 
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class Alloc>
 class ht_iterator;
 
 
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class Alloc>
 class ht_const_iterator;
 
 template <class T>
@@ -135,20 +135,20 @@ struct ht_const_local_iterator;
 
 // ht_iterator
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 struct ht_iterator_base :public mystl::iterator<mystl::forward_iterator_tag, T>
 { // 内嵌型别
-  typedef mystl::hashtable<T, Hash, KeyEqual>         hashtable;
-  typedef ht_iterator_base<T, Hash, KeyEqual>         base;
-  typedef mystl::ht_iterator<T, Hash, KeyEqual>       iterator;
-  typedef mystl::ht_const_iterator<T, Hash, KeyEqual> const_iterator;
-  typedef hashtable_node<T>*                          node_ptr;
-  typedef hashtable*                                  contain_ptr;
-  typedef const node_ptr                              const_node_ptr;
-  typedef const contain_ptr                           const_contain_ptr;
-
-  typedef size_t                                      size_type;
-  typedef ptrdiff_t                                   difference_type;
+  typedef mystl::hashtable<T, Hash, KeyEqual, Alloc>         hashtable;
+  typedef ht_iterator_base<T, Hash, KeyEqual, Alloc>         base;
+  typedef mystl::ht_iterator<T, Hash, KeyEqual, Alloc>       iterator;
+  typedef mystl::ht_const_iterator<T, Hash, KeyEqual, Alloc> const_iterator;
+  typedef hashtable_node<T>*                                 node_ptr;
+  typedef hashtable*                                         contain_ptr;
+  typedef const node_ptr                                     const_node_ptr;
+  typedef const contain_ptr                                  const_contain_ptr;
+
+  typedef size_t                                             size_type;
+  typedef ptrdiff_t                                          difference_type;
 
   node_ptr    node;  // 迭代器当前所指节点
   contain_ptr ht;    // 保持与容器的连结
@@ -159,10 +159,10 @@ struct ht_iterator_base :public mystl::iterator<mystl::forward_iterator_tag, T>
   bool operator!=(const base& rhs) const { return node != rhs.node; }
 };
 
-template <class T, class Hash, class KeyEqual>
-struct ht_iterator: public ht_iterator_base<T, Hash, KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct ht_iterator: public ht_iterator_base<T, Hash, KeyEqual, Alloc>
 {
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
+    typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
     typedef typename base::hashtable            hashtable;
     typedef typename base::iterator             iterator;
     typedef typename base::const_iterator       const_iterator;
@@ -243,10 +243,10 @@ struct ht_iterator: public ht_iterator_base<T, Hash, KeyEqual>
     }
 };
 
-template <class T, class Hash, class KeyEqual>
-struct ht_const_iterator :public ht_iterator_base<T, Hash, KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct ht_const_iterator :public ht_iterator_base<T, Hash, KeyEqual, Alloc>
 {
-  typedef ht_iterator_base<T, Hash, KeyEqual> base;
+  typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
   typedef typename base::hashtable            hashtable;
   typedef typename base::iterator             iterator;
   typedef typename base::const_iterator       const_iterator;
@@ -468,11 +468,12 @@ inline size_t ht_next_prime(size_t n)
 
 // 模板类 hashtable
 // 参数一代表数据类型，参数二代表哈希函数， 参数三代表键值比较相等的函数
-template <class T, class Hash, class KeyEqual>
+// 参数四代表空间配置器，节点与 bucket 数组的配置器都由它 rebind 得到
+template <class T, class Hash, class KeyEqual, class Alloc>
 class hashtable
 {
-    friend struct mystl::ht_iterator<T, Hash, KeyEqual>;
-    friend struct mystl::ht_const_iterator<T, Hash, KeyEqual>;
+    friend struct mystl::ht_iterator<T, Hash, KeyEqual, Alloc>;
+    friend struct mystl::ht_const_iterator<T, Hash, KeyEqual, Alloc>;
 
 public:
     // hashtable 的型别定义
@@ -483,13 +484,14 @@ public:
     typedef Hash                                        hasher;
     typedef KeyEqual                                    key_equal;
 
+    typedef Alloc                                       allocator_type;
+    typedef Alloc                                       data_allocator;
+
     typedef hashtable_node<T>                           node_type;
     typedef node_type*                                  node_ptr;
-    typedef mystl::vector<node_ptr>                     bucket_type;
-
-    typedef mystl::allocator<T>                         allocator_type;
-    typedef mystl::allocator<T>                         data_allocator;
-    typedef mystl::allocator<node_type>                 node_allocator;
+    typedef typename Alloc::template rebind<node_type>::other node_allocator;
+    typedef typename Alloc::template rebind<node_ptr>::other  bucket_allocator;
+    typedef mystl::vector<node_ptr, bucket_allocator>   bucket_type;
 
     typedef typename allocator_type::pointer            pointer;
     typedef typename allocator_type::const_pointer      const_pointer;
@@ -498,14 +500,15 @@ public:
     typedef typename allocator_type::size_type          size_type;
     typedef typename allocator_type::difference_type    difference_type;
 
-    typedef mystl::ht_iterator<T, Hash, KeyEqual>       iterator;
-    typedef mystl::ht_const_iterator<T, Hash, KeyEqual> const_iterator;
+    typedef mystl::ht_iterator<T, Hash, KeyEqual, Alloc>       iterator;
+    typedef mystl::ht_const_iterator<T, Hash, KeyEqual, Alloc> const_iterator;
     typedef mystl::ht_local_iterator<T>                 local_iterator;
     typedef mystl::ht_const_local_iterator<T>           const_local_iterator;
 
-    allocator_type get_allocator() const { return allocator_type(); }
+    allocator_type get_allocator() const { return allocator_type(node_alloc_); }
 
 private:
+    node_allocator node_alloc_; // 节点的配置器
     // 用以下六个参数来表现 hashtable
     bucket_type buckets_;       // vector<node>
     size_type   bucket_size_;   // bucket 的数量
@@ -555,8 +558,10 @@ private:
     // 构造函数
     explicit hashtable(size_type bucket_count,
                         const Hash& hash = Hash(),
-                        const KeyEqual& equal = KeyEqual())
-        :size_(0), mlf_(1.0f), hash_(hash), equal_(equal)
+                        const KeyEqual& equal = KeyEqual(),
+                        const allocator_type& alloc = allocator_type())
+        :node_alloc_(alloc), buckets_(bucket_allocator(alloc)),
+        size_(0), mlf_(1.0f), hash_(hash), equal_(equal)
     {
         init(bucket_count);
     }
@@ -566,28 +571,32 @@ private:
     hashtable(Iter first, Iter last,
               size_type bucket_count,
               const Hash& hash = Hash(),
-              const KeyEqual& equal = KeyEqual())
-    :size_(mystl::distance(first, last)), mlf_(1.0f), hash_(hash), equal_(equal)
+              const KeyEqual& equal = KeyEqual(),
+              const allocator_type& alloc = allocator_type())
+    :node_alloc_(alloc), buckets_(bucket_allocator(alloc)),
+    size_(mystl::distance(first, last)), mlf_(1.0f), hash_(hash), equal_(equal)
     {
         init(mystl::max(bucket_count, static_cast<size_type>(mystl::distance(first, last))));
     }
 
     // 拷贝构造函数
     hashtable(const hashtable& rhs)
-        : hash_(rhs.hash_), equal_(rhs.equal_)
+        : node_alloc_(rhs.node_alloc_), buckets_(rhs.buckets_.get_allocator()),
+        hash_(rhs.hash_), equal_(rhs.equal_)
     {
         copy_init(rhs);
     }
 
     // 移动构造函数
     hashtable(hashtable&& rhs) noexcept
-        : bucket_size_(rhs.bucket_size_),
+        : node_alloc_(rhs.node_alloc_),
+        buckets_(mystl::move(rhs.buckets_)),
+        bucket_size_(rhs.bucket_size_),
         size_(rhs.size_),
         mlf_(rhs.mlf_),
         hash_(rhs.hash_),
         equal_(rhs.equal_)
     {
-        buckets_ = mystl::move(rhs.buckets_);
         rhs.bucket_size_ = 0;
         rhs.size_ = 0;
         rhs.mlf_ = 0.0f;
@@ -827,9 +836,9 @@ private:
 //************************************************************************************************
 
 // 拷贝赋值
-template <class T, class Hash, class KeyEqual>
-hashtable<T, Hash, KeyEqual>&
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+hashtable<T, Hash, KeyEqual, Alloc>&
+hashtable<T, Hash, KeyEqual, Alloc>::
 operator=(const hashtable& rhs)
 {
   if (this != &rhs)
@@ -841,9 +850,9 @@ operator=(const hashtable& rhs)
 }
 
 // 移动赋值
-template <class T, class Hash, class KeyEqual>
-hashtable<T, Hash, KeyEqual>&
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+hashtable<T, Hash, KeyEqual, Alloc>&
+hashtable<T, Hash, KeyEqual, Alloc>::
 operator=(hashtable&& rhs) noexcept
 {
     hashtable tmp(mystl::move(rhs));
@@ -851,10 +860,10 @@ operator=(hashtable&& rhs) noexcept
     return *this;
 }
 
-template <class T, class Hash, class keyEqual>
+template <class T, class Hash, class keyEqual, class Alloc>
 template <class ...Args>
-typename hashtable<T,Hash,keyEqual>::iterator
-hashtable<T,Hash,keyEqual>::
+typename hashtable<T, Hash, keyEqual, Alloc>::iterator
+hashtable<T, Hash, keyEqual, Alloc>::
 emplace_multi(Args&& ...args)
 {   // 创建要插入的节点
     auto np = create_node(mystl::forward<Args>(args)...);
@@ -873,10 +882,10 @@ emplace_multi(Args&& ...args)
 }
 
 
-template <class T, class Hash, class keyEqual>
+template <class T, class Hash, class keyEqual, class Alloc>
 template <class ...Args>
-pair<typename hashtable<T,Hash,keyEqual>::iterator,bool>
-hashtable<T,Hash,keyEqual>::
+pair<typename hashtable<T, Hash, keyEqual, Alloc>::iterator,bool>
+hashtable<T, Hash, keyEqual, Alloc>::
 emplace_unique(Args&& ...args)
 {   // 创建要插入的节点
     auto np = create_node(mystl::forward<Args>(args)...);
@@ -895,9 +904,9 @@ emplace_unique(Args&& ...args)
 }
 
 // 在不需要重新创建表格的情况下插入新节点，键值不允许重复
-template <class T, class Hash, class keyEqual>
-pair<typename hashtable<T,Hash,keyEqual>::iterator,bool>
-hashtable<T,Hash,keyEqual>::
+template <class T, class Hash, class keyEqual, class Alloc>
+pair<typename hashtable<T, Hash, keyEqual, Alloc>::iterator,bool>
+hashtable<T, Hash, keyEqual, Alloc>::
 insert_unique_noresize(const value_type& value)
 {
     const auto n = hash(value_traits::get_key(value));
@@ -918,9 +927,9 @@ insert_unique_noresize(const value_type& value)
 
 
 // 在不需要重新创建表格的情况下插入新节点，键值不允许重复
-template <class T, class Hash, class keyEqual>
-typename hashtable<T,Hash,keyEqual>::iterator
-hashtable<T,Hash,keyEqual>::
+template <class T, class Hash, class keyEqual, class Alloc>
+typename hashtable<T, Hash, keyEqual, Alloc>::iterator
+hashtable<T, Hash, keyEqual, Alloc>::
 insert_multi_noresize(const value_type& value)
 {
     const auto n = hash(value_traits::get_key(value));
@@ -947,8 +956,8 @@ insert_multi_noresize(const value_type& value)
 }
 
 // 删除迭代器所指向的节点
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 erase(const_iterator position)
 {
     auto p = position.node;
@@ -987,8 +996,8 @@ erase(const_iterator position)
 }
 
 // 删除[first, last) 内的节点
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 erase(const_iterator first, const_iterator last)
 {
     if(first.node == last.node)
@@ -1021,26 +1030,27 @@ erase(const_iterator first, const_iterator last)
 }
 
 // 删除键值为 key 的节点
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::
 erase_multi(const key_type& key)
 {   // p 是一个pair, 即等于键值的范围的前后迭代器
     auto p = equal_range_multi(key);
     if(p.first.node != nullptr)
     {
+        // 返回被删除的节点数量，要在删除之前计算
+        const size_type n = mystl::distance(p.first, p.second);
         erase(p.first, p.second);
-        // 返回被删除的节点数量
-        return mystl::distance(p.first, p.second);
+        return n;
     }
     // 说明没找到
     return 0; 
 }
 
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::
 erase_unique(const key_type& key)
 {
     const auto n = hash(key);
@@ -1074,12 +1084,13 @@ erase_unique(const key_type& key)
             }
         }
     }
+    return 0;
 }
 
 // 清空 hash_table
 // 将所有链表清空， 保留vector
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 clear()
 {
     if(size_ != 0)
@@ -1100,9 +1111,9 @@ clear()
 }
 
 // 在某个bucket 节点的数量
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::
 bucket_size(size_type n) const noexcept
 {
     size_type result = 0;
@@ -1115,8 +1126,8 @@ bucket_size(size_type n) const noexcept
 
 
 // 重新对元素进行一遍哈希， 插入到新的位置
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 rehash(size_type count)
 {   // 新的bucket 数量
     auto n = ht_next_prime(count);
@@ -1136,9 +1147,9 @@ rehash(size_type count)
 }
 
 // 查找键值为 key 的节点， 返回迭代器
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, Alloc>::
 find(const key_type& key)
 {
     const auto n = hash(key);
@@ -1147,9 +1158,9 @@ find(const key_type& key)
     return iterator(first, this);
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::const_iterator
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator
+hashtable<T, Hash, KeyEqual, Alloc>::
 find(const key_type& key) const
 {
   const auto n = hash(key);
@@ -1159,9 +1170,9 @@ find(const key_type& key) const
 }
 
 // 查找键值为 Key 出现的次数
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::
 count(const key_type& key) const
 {
     const auto n = hash(key);
@@ -1175,10 +1186,10 @@ count(const key_type& key) const
 }
 
 // 查找与键值 key 相等的区间， 返回一个pair, 指向相等的区间
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-    typename hashtable<T, Hash, KeyEqual>::iterator>
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator,
+    typename hashtable<T, Hash, KeyEqual, Alloc>::iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::
 equal_range_multi(const key_type& key)
 {
     const auto n = hash(key);
@@ -1205,10 +1216,10 @@ equal_range_multi(const key_type& key)
     return mystl::make_pair(end(), end());
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-  typename hashtable<T, Hash, KeyEqual>::const_iterator>
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator,
+  typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::
 equal_range_multi(const key_type& key) const
 {
   const auto n = hash(key);
@@ -1232,10 +1243,10 @@ equal_range_multi(const key_type& key) const
   return mystl::make_pair(cend(), cend());
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-  typename hashtable<T, Hash, KeyEqual>::iterator>
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator,
+  typename hashtable<T, Hash, KeyEqual, Alloc>::iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::
 equal_range_unique(const key_type& key)
 {
   const auto n = hash(key);
@@ -1256,10 +1267,10 @@ equal_range_unique(const key_type& key)
   return mystl::make_pair(end(), end());
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-  typename hashtable<T, Hash, KeyEqual>::const_iterator>
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator,
+  typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::
 equal_range_unique(const key_type& key) const
 {
   const auto n = hash(key);
@@ -1280,12 +1291,13 @@ equal_range_unique(const key_type& key) const
   return mystl::make_pair(cend(), cend());
 }
 
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 swap(hashtable& rhs) noexcept
 {
     if (this != &rhs)
     {
+        mystl::swap(node_alloc_, rhs.node_alloc_);
         buckets_.swap(rhs.buckets_);
         mystl::swap(bucket_size_, rhs.bucket_size_);
         mystl::swap(size_, rhs.size_);
@@ -1298,8 +1310,8 @@ swap(hashtable& rhs) noexcept
 //*****************************************************************************************************
 // helper function
 // init 函数
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 init(size_type n)
 {   // bucket 的数量
     const auto bucket_nums = next_size(n);
@@ -1317,8 +1329,8 @@ init(size_type n)
     bucket_size_ = buckets_.size();
 }
 
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 copy_init(const hashtable& ht)
 {
     bucket_size_ = 0;
@@ -1352,66 +1364,66 @@ copy_init(const hashtable& ht)
 }
 
 // create_node 函数
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class ...Args>
-typename hashtable<T, Hash, KeyEqual>::node_ptr
-hashtable<T, Hash, KeyEqual>::
+typename hashtable<T, Hash, KeyEqual, Alloc>::node_ptr
+hashtable<T, Hash, KeyEqual, Alloc>::
 create_node(Args&& ...args)
 {
-  node_ptr tmp = node_allocator::allocate(1);
+  node_ptr tmp = node_alloc_.allocate(1);
   try
   {
-    data_allocator::construct(mystl::address_of(tmp->value), mystl::forward<Args>(args)...);
+    mystl::construct(mystl::address_of(tmp->value), mystl::forward<Args>(args)...);
     tmp->next = nullptr;
   }
   catch (...)
   {
-    node_allocator::deallocate(tmp);
+    node_alloc_.deallocate(tmp, 1);
     throw;
   }
   return tmp;
 }
 
 // destroy_node 函数
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 destroy_node(node_ptr node)
 { // 析构对象
-  data_allocator::destroy(mystl::address_of(node->value));
+  mystl::destroy(mystl::address_of(node->value));
   // 释放内存
-  node_allocator::deallocate(node);
+  node_alloc_.deallocate(node, 1);
   node = nullptr;
 }
 
 // next_size 函数
 // 返回合适的bucket 数量
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::next_size(size_type n) const
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::next_size(size_type n) const
 {
   return ht_next_prime(n);
 }
 
 // hash 函数
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::
 hash(const key_type& key, size_type n) const
 {
     return hash_(key) % n;
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::
 hash(const key_type& key) const
 {
     return hash_(key) % bucket_size_;
 }
 
 // rehash_if_need 函数
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 rehash_if_need(size_type n)
 {
   if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor())
@@ -1419,9 +1431,9 @@ rehash_if_need(size_type n)
 }
 
 // copy_insert
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class InputIter>
-void hashtable<T, Hash, KeyEqual>::
+void hashtable<T, Hash, KeyEqual, Alloc>::
 copy_insert_multi(InputIter first, InputIter last, mystl::input_iterator_tag)
 {
   rehash_if_need(mystl::distance(first, last));
@@ -1429,9 +1441,9 @@ copy_insert_multi(InputIter first, InputIter last, mystl::input_iterator_tag)
     insert_multi_noresize(*first);
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class ForwardIter>
-void hashtable<T, Hash, KeyEqual>::
+void hashtable<T, Hash, KeyEqual, Alloc>::
 copy_insert_multi(ForwardIter first, ForwardIter last, mystl::forward_iterator_tag)
 {
   size_type n = mystl::distance(first, last);
@@ -1440,9 +1452,9 @@ copy_insert_multi(ForwardIter first, ForwardIter last, mystl::forward_iterator_t
     insert_multi_noresize(*first);
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class InputIter>
-void hashtable<T, Hash, KeyEqual>::
+void hashtable<T, Hash, KeyEqual, Alloc>::
 copy_insert_unique(InputIter first, InputIter last, mystl::input_iterator_tag)
 {
   rehash_if_need(mystl::distance(first, last));
@@ -1450,9 +1462,9 @@ copy_insert_unique(InputIter first, InputIter last, mystl::input_iterator_tag)
     insert_unique_noresize(*first);
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class ForwardIter>
-void hashtable<T, Hash, KeyEqual>::
+void hashtable<T, Hash, KeyEqual, Alloc>::
 copy_insert_unique(ForwardIter first, ForwardIter last, mystl::forward_iterator_tag)
 {
   size_type n = mystl::distance(first, last);
@@ -1462,9 +1474,9 @@ copy_insert_unique(ForwardIter first, ForwardIter last, mystl::forward_iterator_
 }
 
 // insert_node 函数
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, Alloc>::
 insert_node_multi(node_ptr np)
 {
     const auto n = hash(value_traits::get_key(np->value));
@@ -1494,9 +1506,9 @@ insert_node_multi(node_ptr np)
 }
 
 // insert_node_unique 函数
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+hashtable<T, Hash, KeyEqual, Alloc>::
 insert_node_unique(node_ptr np)
 {
   const auto n = hash(value_traits::get_key(np->value));
@@ -1510,7 +1522,8 @@ insert_node_unique(node_ptr np)
   for (; cur; cur = cur->next)
   {
     if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value)))
-    { // 如果遇到相等的节点， 则直接插入失败
+    { // 如果遇到相等的节点， 则直接插入失败，并释放新建的节点
+      destroy_node(np);
       return mystl::make_pair(iterator(cur, this), false);
     }
   }
@@ -1521,22 +1534,23 @@ insert_node_unique(node_ptr np)
 }
 
 // replace_bucket 函数
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 replace_bucket(size_type bucket_count)
 { // 创建bucket
-  bucket_type bucket(bucket_count);
+  bucket_type bucket(bucket_count, nullptr, buckets_.get_allocator());
   if (size_ != 0)
   { // 遍历每一个bucket
     for (size_type i = 0; i < bucket_size_; ++i)
-    { // 遍历 bucket 上的链表
-      for (auto first = buckets_[i]; first; first = first->next)
-      {                       // first 指向原来的元素
-        auto tmp = create_node(first->value);
+    { // 遍历 bucket 上的链表，直接把原节点挂到新的 bucket 上，不再重新分配
+      for (auto first = buckets_[i], next = first; first; first = next)
+      {
+        next = first->next;
+        auto tmp = first;
         const auto n = hash(value_traits::get_key(first->value), bucket_count);
         auto f = bucket[n];
         bool is_inserted = false;
-        //!  这个for 循环没看懂，在每个元素内为什么还要进行for循环
+        // 相等的键值要挂在一起
         for (auto cur = f; cur; cur = cur->next)
         {
           if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(first->value)))
@@ -1561,8 +1575,8 @@ replace_bucket(size_type bucket_count)
 
 // erase_bucket 函数
 // 在第 n 个bucket内， 删除[first, last) 的节点
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 erase_bucket(size_type n, node_ptr first, node_ptr last)
 {
     auto cur = buckets_[n];
@@ -1588,8 +1602,8 @@ erase_bucket(size_type n, node_ptr first, node_ptr last)
 
 // erase_bucket 函数
 // 在第 n 个bucket 内， 删除[buckets_[n], last) 的节点
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::
 erase_bucket(size_type n, node_ptr last)
 {
     auto cur = buckets_[n];
@@ -1605,8 +1619,8 @@ erase_bucket(size_type n, node_ptr last)
 
 // equal_to 函数
 // 判断两个hashtable 是否相等
-template <class T, class Hash, class KeyEqual>
-bool hashtable<T, Hash, KeyEqual>::equal_to_multi(const hashtable& other)
+template <class T, class Hash, class KeyEqual, class Alloc>
+bool hashtable<T, Hash, KeyEqual, Alloc>::equal_to_multi(const hashtable& other)
 {
   if (size_ != other.size_)
     return false;
@@ -1622,8 +1636,8 @@ bool hashtable<T, Hash, KeyEqual>::equal_to_multi(const hashtable& other)
   return true;
 }
 
-template <class T, class Hash, class KeyEqual>
-bool hashtable<T, Hash, KeyEqual>::equal_to_unique(const hashtable& other)
+template <class T, class Hash, class KeyEqual, class Alloc>
+bool hashtable<T, Hash, KeyEqual, Alloc>::equal_to_unique(const hashtable& other)
 {
   if (size_ != other.size_)
     return false;
@@ -1636,10 +1650,17 @@ bool hashtable<T, Hash, KeyEqual>::equal_to_unique(const hashtable& other)
   return true;
 }
 
+// 节点和 bucket 都在堆上，函数对象与配置器可以搬移时 hashtable 可以按字节搬移
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct is_trivially_relocatable<hashtable<T, Hash, KeyEqual, Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<Hash>::value &&
+                                 is_trivially_relocatable<KeyEqual>::value &&
+                                 is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
-template <class T, class Hash, class KeyEqual>
-void swap(hashtable<T, Hash, KeyEqual>& lhs,
-          hashtable<T, Hash, KeyEqual>& rhs) noexcept
+template <class T, class Hash, class KeyEqual, class Alloc>
+void swap(hashtable<T, Hash, KeyEqual, Alloc>& lhs,
+          hashtable<T, Hash, KeyEqual, Alloc>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
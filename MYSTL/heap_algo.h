@@ -2,8 +2,11 @@
 #define MYSTL_HEAP_ALGO_H_
 
 // 这个头文件包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap
+// 以及 d 叉堆的版本 : dary_push_heap, dary_pop_heap, dary_make_heap
 
 #include "iterator.h"
+#include "util.h"
+#include "functional.h"
 
 namespace mystl
 {
@@ -222,6 +225,149 @@ void make_heap(RandomIter first, RandomIter last, Compared comp)
   mystl::make_heap_aux(first, last, distance_type(first), comp);
 }
 
+/*****************************************************************************************/
+// dary_push_heap / dary_pop_heap / dary_make_heap
+// 每个节点有 D 个子节点的堆，节点 i 的子节点为 D * i + 1 ... D * i + D，父节点为 (i - 1) / D
+// 树高从 log2(n) 降为 logD(n)，下溯的层数和访问的 cache line 数随之减少，代价是每层要比较 D - 1 次，
+// 能否快过二叉堆取决于元素大小、比较的代价和缓存，应以实测为准
+// 模板参数 D 需显式给出，如 mystl::dary_push_heap<4>(first, last)
+/*****************************************************************************************/
+template <size_t D, class RandomIter, class Distance, class T, class Compared>
+void dary_sift_up(RandomIter first, Distance holeIndex, Distance topIndex, T value,
+                  Compared comp)
+{
+  while (holeIndex > topIndex)
+  {
+    const Distance parent = (holeIndex - 1) / static_cast<Distance>(D);
+    if (!comp(*(first + parent), value))
+      break;
+    *(first + holeIndex) = mystl::move(*(first + parent));
+    holeIndex = parent;
+  }
+  *(first + holeIndex) = mystl::move(value);
+}
+
+// 从 holeIndex 开始下溯，每层在 D 个子节点中选出最大的一个
+template <size_t D, class RandomIter, class Distance, class T, class Compared>
+void dary_sift_down(RandomIter first, Distance holeIndex, Distance len, T value,
+                    Compared comp)
+{
+  while (true)
+  {
+    const Distance child = static_cast<Distance>(D) * holeIndex + 1;
+    if (child >= len)
+      break;
+    const Distance last_child = len - child > static_cast<Distance>(D)
+      ? child + static_cast<Distance>(D) : len;
+    Distance best = child;
+    for (Distance c = child + 1; c < last_child; ++c)
+      best = comp(*(first + best), *(first + c)) ? c : best;
+    if (!comp(value, *(first + best)))
+      break;
+    *(first + holeIndex) = mystl::move(*(first + best));
+    holeIndex = best;
+  }
+  *(first + holeIndex) = mystl::move(value);
+}
+
+// 新元素应该已置于底部容器的最尾端
+template <size_t D, class RandomIter, class Compared>
+void dary_push_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+  typedef typename iterator_traits<RandomIter>::difference_type Distance;
+  typedef typename iterator_traits<RandomIter>::value_type      T;
+  const Distance len = last - first;
+  if (len < 2)
+    return;
+  T value = mystl::move(*(last - 1));
+  mystl::dary_sift_up<D>(first, len - 1, static_cast<Distance>(0), mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter>
+void dary_push_heap(RandomIter first, RandomIter last)
+{
+  mystl::dary_push_heap<D>(first, last,
+                           mystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+// 与 adjust_heap 相同，先把空洞沿较大的子节点一路下移到叶子，再把 value 上溯
+// 尾部元素通常很小，这样每层省去一次与 value 的比较
+template <size_t D, class RandomIter, class Distance, class T, class Compared>
+void dary_adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value,
+                      Compared comp)
+{
+  const Distance topIndex = holeIndex;
+  const Distance d = static_cast<Distance>(D);
+  Distance child = d * holeIndex + 1;
+  while (len - child >= d)
+  { // 有 D 个子节点
+    Distance best = child;
+    for (Distance c = child + 1; c < child + d; ++c)
+      best = comp(*(first + best), *(first + c)) ? c : best;
+    *(first + holeIndex) = mystl::move(*(first + best));
+    holeIndex = best;
+    child = d * holeIndex + 1;
+  }
+  if (child < len)
+  { // 最后一层不满
+    Distance best = child;
+    for (Distance c = child + 1; c < len; ++c)
+      best = comp(*(first + best), *(first + c)) ? c : best;
+    *(first + holeIndex) = mystl::move(*(first + best));
+    holeIndex = best;
+  }
+  mystl::dary_sift_up<D>(first, holeIndex, topIndex, mystl::move(value), comp);
+}
+
+// 将堆顶移到 last - 1，调整 [first, last - 1)
+template <size_t D, class RandomIter, class Compared>
+void dary_pop_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+  typedef typename iterator_traits<RandomIter>::difference_type Distance;
+  typedef typename iterator_traits<RandomIter>::value_type      T;
+  const Distance len = last - first;
+  if (len < 2)
+    return;
+  T value = mystl::move(*(last - 1));
+  *(last - 1) = mystl::move(*first);
+  mystl::dary_adjust_heap<D>(first, static_cast<Distance>(0), len - 1, mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter>
+void dary_pop_heap(RandomIter first, RandomIter last)
+{
+  mystl::dary_pop_heap<D>(first, last,
+                          mystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+// 自底向上逐个下溯，O(n)
+template <size_t D, class RandomIter, class Compared>
+void dary_make_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+  typedef typename iterator_traits<RandomIter>::difference_type Distance;
+  typedef typename iterator_traits<RandomIter>::value_type      T;
+  const Distance len = last - first;
+  if (len < 2)
+    return;
+  for (Distance holeIndex = (len - 2) / static_cast<Distance>(D); ; --holeIndex)
+  {
+    T value = mystl::move(*(first + holeIndex));
+    mystl::dary_sift_down<D>(first, holeIndex, len, mystl::move(value), comp);
+    if (holeIndex == 0)
+      return;
+  }
+}
+
+template <size_t D, class RandomIter>
+void dary_make_heap(RandomIter first, RandomIter last)
+{
+  mystl::dary_make_heap<D>(first, last,
+                           mystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
 } // namespace mystl
 #endif // !MYTINYSTL_HEAP_ALGO_H_
 
@@ -0,0 +1,206 @@
+#ifndef MYSTL_HUGE_PAGE_ALLOCATOR_H
+#define MYSTL_HUGE_PAGE_ALLOCATOR_H
+
+// 这个头文件包含一个模板类 huge_page_allocator，给大数组使用
+// 所有分配都按 Align（缺省 64 字节，即一条 cache line）对齐，便于 SIMD 访问；
+// 达到 MmapThreshold 的分配直接 mmap，并按 2MB 对齐、用 madvise(MADV_HUGEPAGE) 提示内核使用透明大页，减少 TLB miss
+// Linux 下还提供 reallocate，用 mremap 直接扩大映射，vector 增长时不必复制整块数据
+// 使用方式：mystl::vector<double, mystl::huge_page_allocator<double>> v;
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+#include "platform.h"
+#include "construct.h"
+#include "util.h"
+#include "exceptdef.h"
+
+#if defined(REDBUD_LINUX) || defined(REDBUD_OSX)
+#include <sys/mman.h>
+#define MYSTL_HAS_MMAP 1
+#if defined(REDBUD_LINUX) && defined(MREMAP_MAYMOVE)
+#define MYSTL_HAS_MREMAP 1
+#endif
+#endif
+
+namespace mystl
+{
+
+namespace hp_detail
+{
+
+const size_t huge_page_size = 2 * 1024 * 1024;
+
+inline size_t round_up(size_t n, size_t align) noexcept
+{
+  return (n + align - 1) & ~(align - 1);
+}
+
+// 按 align 对齐的 operator new：多申请一段空间，在返回地址之前记下原始指针
+inline void* aligned_new(size_t bytes, size_t align)
+{
+  char* raw = static_cast<char*>(::operator new(bytes + align + sizeof(void*)));
+  char* p = reinterpret_cast<char*>(
+    round_up(reinterpret_cast<uintptr_t>(raw + sizeof(void*)), align));
+  reinterpret_cast<void**>(p)[-1] = raw;
+  return p;
+}
+
+inline void aligned_delete(void* p) noexcept
+{
+  ::operator delete(static_cast<void**>(p)[-1]);
+}
+
+#ifdef MYSTL_HAS_MMAP
+// 映射的长度取整到大页，起始地址也按大页对齐，这样整段都能被大页覆盖
+inline size_t map_length(size_t bytes) noexcept
+{
+  return round_up(bytes, huge_page_size);
+}
+
+inline void* map_huge(size_t bytes)
+{
+  const size_t len = map_length(bytes);
+  // 多映射一个大页，再把首尾多出的部分还回去
+  void* raw = ::mmap(nullptr, len + huge_page_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED)
+    throw std::bad_alloc();
+  char* begin = static_cast<char*>(raw);
+  char* p = reinterpret_cast<char*>(round_up(reinterpret_cast<uintptr_t>(begin), huge_page_size));
+  if (p != begin)
+    ::munmap(begin, p - begin);
+  char* end = begin + len + huge_page_size;
+  if (p + len != end)
+    ::munmap(p + len, end - (p + len));
+#ifdef MADV_HUGEPAGE
+  ::madvise(p, len, MADV_HUGEPAGE);  // 只是提示，失败时仍然可以使用普通页
+#endif
+  return p;
+}
+
+inline void unmap_huge(void* p, size_t bytes) noexcept
+{
+  ::munmap(p, map_length(bytes));
+}
+
+#ifdef MYSTL_HAS_MREMAP
+// 扩大一段 map_huge 得到的映射，只改页表不复制数据；内核可能把映射搬到别处，失败时返回 nullptr，原映射不变
+inline void* remap_huge(void* p, size_t old_bytes, size_t new_bytes) noexcept
+{
+  const size_t old_len = map_length(old_bytes);
+  const size_t new_len = map_length(new_bytes);
+  if (old_len == new_len)
+    return p;
+  void* q = ::mremap(p, old_len, new_len, MREMAP_MAYMOVE);
+  if (q == MAP_FAILED)
+    return nullptr;
+#ifdef MADV_HUGEPAGE
+  ::madvise(q, new_len, MADV_HUGEPAGE);
+#endif
+  return q;
+}
+#endif
+#endif
+
+} // namespace hp_detail
+
+// 模板类 huge_page_allocator
+// 参数一代表数据类型，参数二代表对齐字节数，参数三代表改用 mmap 的最小字节数
+// 释放时的 n 必须与分配时相同，据此判断这块内存来自 mmap 还是 operator new
+template <class T, size_t Align = 64, size_t MmapThreshold = hp_detail::huge_page_size>
+class huge_page_allocator
+{
+  static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+  static_assert(Align >= alignof(T), "Align must not be smaller than alignof(T)");
+
+public:
+  typedef T            value_type;
+  typedef T*           pointer;
+  typedef const T*     const_pointer;
+  typedef T&           reference;
+  typedef const T&     const_reference;
+  typedef size_t       size_type;
+  typedef ptrdiff_t    difference_type;
+
+  template <class U>
+  struct rebind
+  {
+    typedef huge_page_allocator<U, (Align < alignof(U) ? alignof(U) : Align), MmapThreshold> other;
+  };
+
+public:
+  huge_page_allocator() noexcept = default;
+  template <class U, size_t A>
+  huge_page_allocator(const huge_page_allocator<U, A, MmapThreshold>&) noexcept {}
+
+  static T* allocate(size_type n)
+  {
+    if (n == 0)
+      return nullptr;
+    THROW_LENGTH_ERROR_IF(n > static_cast<size_type>(-1) / sizeof(T),
+                          "huge_page_allocator<T>'s size too big");
+    const size_t bytes = n * sizeof(T);
+#ifdef MYSTL_HAS_MMAP
+    if (bytes >= MmapThreshold)
+      return static_cast<T*>(hp_detail::map_huge(bytes));
+#endif
+    return static_cast<T*>(hp_detail::aligned_new(bytes, Align));
+  }
+
+  static void deallocate(T* ptr, size_type n)
+  {
+    if (ptr == nullptr)
+      return;
+#ifdef MYSTL_HAS_MMAP
+    if (n * sizeof(T) >= MmapThreshold)
+    {
+      hp_detail::unmap_huge(ptr, n * sizeof(T));
+      return;
+    }
+#endif
+    hp_detail::aligned_delete(ptr);
+  }
+
+  // 把 old_n 个元素的空间扩大到 new_n 个，内容保持不变
+  // 只对新旧大小都走 mmap 的空间有效，其余情况返回 nullptr，由调用者自行分配并搬移；
+  // 成功后原指针失效，元素按字节原样出现在新地址上，所以只适用于可以按位复制的类型
+  static T* reallocate(T* ptr, size_type old_n, size_type new_n) noexcept
+  {
+#ifdef MYSTL_HAS_MREMAP
+    if (ptr != nullptr && new_n >= old_n &&
+        new_n <= static_cast<size_type>(-1) / sizeof(T) &&
+        old_n * sizeof(T) >= MmapThreshold)
+      return static_cast<T*>(hp_detail::remap_huge(ptr, old_n * sizeof(T), new_n * sizeof(T)));
+#else
+    (void)ptr; (void)old_n; (void)new_n;
+#endif
+    return nullptr;
+  }
+
+  template <class... Args>
+  static void construct(T* ptr, Args&& ...args)
+  {
+    mystl::construct(ptr, mystl::forward<Args>(args)...);
+  }
+
+  static void destroy(T* ptr)            { mystl::destroy(ptr); }
+  static void destroy(T* first, T* last) { mystl::destroy(first, last); }
+};
+
+// 没有状态，所有实例都可以互相释放对方分配的内存
+template <class T, size_t A1, class U, size_t A2, size_t M>
+bool operator==(const huge_page_allocator<T, A1, M>&, const huge_page_allocator<U, A2, M>&) noexcept
+{
+  return true;
+}
+
+template <class T, size_t A1, class U, size_t A2, size_t M>
+bool operator!=(const huge_page_allocator<T, A1, M>&, const huge_page_allocator<U, A2, M>&) noexcept
+{
+  return false;
+}
+
+} // namespace mystl
+#endif // !MYSTL_HUGE_PAGE_ALLOCATOR_H
@@ -195,15 +195,17 @@ struct list_const_iterator : public iterator<bidirectional_iterator_tag, T>
   bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
 };
 
-template <class T>
+// 模板类 list
+// 模板参数 T 代表类型，Alloc 代表空间配置器，节点和根节点的配置器都由它 rebind 得到
+template <class T, class Alloc = mystl::allocator<T>>
 class list{
 
 public:
     // list 的嵌套型别定义
-    typedef mystl::allocator<T>                      allocator_type;
-    typedef mystl::allocator<T>                      data_allocator;
-    typedef mystl::allocator<list_node_base<T>>      base_allocator;
-    typedef mystl::allocator<list_node<T>>           node_allocator;
+    typedef Alloc                                    allocator_type;
+    typedef Alloc                                    data_allocator;
+    typedef typename Alloc::template rebind<list_node_base<T>>::other base_allocator;
+    typedef typename Alloc::template rebind<list_node<T>>::other      node_allocator;
 
     typedef typename allocator_type::value_type      value_type;
     typedef typename allocator_type::pointer         pointer;
@@ -221,9 +223,11 @@ public:
     typedef typename node_traits<T>::base_ptr        base_ptr;
     typedef typename node_traits<T>::node_ptr        node_ptr;
 
-    allocator_type get_allocator() { return node_allocator(); }
+    allocator_type get_allocator() const { return allocator_type(node_alloc_); }
 
 private:
+    node_allocator node_alloc_; // 数据节点的配置器
+    base_allocator base_alloc_; // 根节点的配置器
     base_ptr node_; // 指向末尾的节点
     size_type size_; // 大小
 
@@ -231,25 +235,34 @@ public:
     // 构造函数
     list()
     { fill_init(0, value_type()); }
-    explicit list(size_type n)
+    explicit list(const allocator_type& alloc)
+        : node_alloc_(alloc), base_alloc_(alloc)
+    { fill_init(0, value_type()); }
+    explicit list(size_type n, const allocator_type& alloc = allocator_type())
+        : node_alloc_(alloc), base_alloc_(alloc)
     { fill_init(n, value_type()); }
-    list(size_type n, const T& value)
+    list(size_type n, const T& value, const allocator_type& alloc = allocator_type())
+        : node_alloc_(alloc), base_alloc_(alloc)
     { fill_init(n, value); }
 
     template <class Iter, typename std::enable_if<
         mystl::is_input_iterator<Iter>::value, int>::type = 0>
-    list(Iter first, Iter last)
+    list(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : node_alloc_(alloc), base_alloc_(alloc)
     { copy_init(first, last); }
 
-    list(std::initializer_list<T> ilist)
+    list(std::initializer_list<T> ilist, const allocator_type& alloc = allocator_type())
+        : node_alloc_(alloc), base_alloc_(alloc)
     { copy_init(ilist.begin(), ilist.end()); }
 
     // 拷贝构造函数
     list(const list& rhs)
+        : node_alloc_(rhs.node_alloc_), base_alloc_(rhs.base_alloc_)
     { copy_init(rhs.cbegin(), rhs.cend()); }
     // 移动构造函数
     list(list&& rhs) noexcept
-        : node_(rhs.node_), size_(rhs.size_)
+        : node_alloc_(rhs.node_alloc_), base_alloc_(rhs.base_alloc_),
+        node_(rhs.node_), size_(rhs.size_)
     {
         rhs.node_ = nullptr;
         rhs.size_ = 0;
@@ -267,15 +280,15 @@ public:
 
     // 移动赋值
     list& operator= (list&& rhs) noexcept
-    {
-        clear();
-        splice(end(), rhs);
+    {   // 节点连同配置器一起接管，原有节点交给 tmp 释放
+        list tmp(mystl::move(rhs));
+        swap(tmp);
         return *this;
     }
     // 列表初始化
     list& operator=(std::initializer_list<T> ilist)
     {
-        list tmp(ilist.begin(), ilist.end());
+        list tmp(ilist.begin(), ilist.end(), get_allocator());
         swap(tmp);
         return *this;
     }
@@ -285,7 +298,7 @@ public:
         if(node_)
         {
             clear();
-            base_allocator::deallocate(node_);
+            base_alloc_.deallocate(node_, 1);
             node_ = nullptr;
             size_ = 0;
         }
@@ -497,6 +510,8 @@ public:
 
     void swap(list& rhs) noexcept
     {
+        mystl::swap(node_alloc_, rhs.node_alloc_);
+        mystl::swap(base_alloc_, rhs.base_alloc_);
         mystl::swap(node_, rhs.node_);
         mystl::swap(size_, rhs.size_);
     }
@@ -505,6 +520,7 @@ public:
     void    reverse();
 
     // list相关操作
+    // splice / merge 直接搬移节点，要求两个 list 的配置器相等
     void    splice(const_iterator pos, list& other);
     void    splice(const_iterator pos, list& other, const_iterator it);
     void    splice(const_iterator pos, list& other, const_iterator first, const_iterator last);
@@ -561,9 +577,9 @@ private:
 //-----------------------------------------------------------------------------------------------------------
 
 // 删除 pos 处的位置
-template <class T>
-typename list<T>::iterator
-list<T>::erase(const_iterator pos)
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::erase(const_iterator pos)
 {
     assert(pos != cend());
     auto n = pos.node_;
@@ -576,9 +592,9 @@ list<T>::erase(const_iterator pos)
 }
 
 // 删除[first, last) 内的元素
-template <class T>
-typename list<T>::iterator
-list<T>::erase(const_iterator first, const_iterator last){
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::erase(const_iterator first, const_iterator last){
     if(first != last)
     {
         unlink_nodes(first.node_, last.node_->prev);
@@ -594,8 +610,8 @@ list<T>::erase(const_iterator first, const_iterator last){
 }
 
 // 清空list
-template <class T>
-void list<T>::clear()
+template <class T, class Alloc>
+void list<T, Alloc>::clear()
 {
     if(size_ != 0)
     {   // 首节点
@@ -613,8 +629,8 @@ void list<T>::clear()
 
 
 // 将 List x 接于 pos 之前
-template <class T>
-void list<T>::splice(const_iterator pos, list& x)
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x)
 {
     assert(this != &x);
     if(!x.empty())
@@ -632,8 +648,8 @@ void list<T>::splice(const_iterator pos, list& x)
 
 // 将 it 所指的节点 接合于 pos 之前
 // 只添加一个节点
-template <class T>
-void list<T>::splice(const_iterator pos, list& x, const_iterator it)
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x, const_iterator it)
 {
     if(pos.node_ != it.node_ && pos.node_ != it.node_->next)
     {
@@ -649,8 +665,8 @@ void list<T>::splice(const_iterator pos, list& x, const_iterator it)
 }
 
 // 将list x 的[first, last) 内的节点接合于 pos 之前
-template <class T>
-void list<T>::splice(const_iterator pos, list& x, const_iterator first, const_iterator last)
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x, const_iterator first, const_iterator last)
 {
     if(first != last && this != &x){
         
@@ -668,8 +684,8 @@ void list<T>::splice(const_iterator pos, list& x, const_iterator first, const_it
 }
 
 // 重置容器大小
-template <class T>
-void list<T>::resize(size_type new_size, const value_type& value)
+template <class T, class Alloc>
+void list<T, Alloc>::resize(size_type new_size, const value_type& value)
 {
     auto i = begin();
     size_type len = 0;
@@ -687,9 +703,9 @@ void list<T>::resize(size_type new_size, const value_type& value)
 }
 
 // 与另一个 list 合并
-template <class T>
+template <class T, class Alloc>
 template <class Compare>
-void list<T>::merge(list& x, Compare comp)
+void list<T, Alloc>::merge(list& x, Compare comp)
 {
     if(this != &x)
     {
@@ -736,8 +752,8 @@ void list<T>::merge(list& x, Compare comp)
     }
 }
 
-template <class T>
-void list<T>::reverse()
+template <class T, class Alloc>
+void list<T, Alloc>::reverse()
 {
     if(size_ <= 1)
         return ;
@@ -756,40 +772,40 @@ void list<T>::reverse()
 // helper function
 
 // 创建节点
-template <class T>
+template <class T, class Alloc>
 template <class ...Args>
-typename list<T>::node_ptr 
-list<T>::create_node(Args&& ...args)
+typename list<T, Alloc>::node_ptr 
+list<T, Alloc>::create_node(Args&& ...args)
 { 
-  node_ptr p = node_allocator::allocate(1);
+  node_ptr p = node_alloc_.allocate(1);
   try
   {
-    data_allocator::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+    mystl::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
     p->prev = nullptr;
     p->next = nullptr;
   }
   catch (...)
   {
-    node_allocator::deallocate(p);
+    node_alloc_.deallocate(p, 1);
     throw;
   }
   return p;
 }
 
 // 销毁节点
-template <class T>
-void list<T>::destroy_node(node_ptr p)
+template <class T, class Alloc>
+void list<T, Alloc>::destroy_node(node_ptr p)
 {   // 析构对象
-    data_allocator::destroy(mystl::address_of(p->value));
+    mystl::destroy(mystl::address_of(p->value));
     // 释放空间
-    node_allocator::deallocate(p);
+    node_alloc_.deallocate(p, 1);
 }
 
 // 用 n 个元素初始化容器
-template <class T>
-void list<T>::fill_init(size_type n, const value_type& value)
+template <class T, class Alloc>
+void list<T, Alloc>::fill_init(size_type n, const value_type& value)
 { // 创建根节点
-  node_ = base_allocator::allocate(1);
+  node_ = base_alloc_.allocate(1);
   node_->unlink();
   size_ = n;
   try
@@ -804,24 +820,24 @@ void list<T>::fill_init(size_type n, const value_type& value)
   catch (...)
   {
     clear();
-    base_allocator::deallocate(node_);
+    base_alloc_.deallocate(node_, 1);
     node_ = nullptr;
     throw;
   }
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class IIter>
-void list<T>::copy_init(IIter first, IIter last)
+void list<T, Alloc>::copy_init(IIter first, IIter last)
 {
     // 创建根节点
-    node_ = base_allocator::allocate(1);
+    node_ = base_alloc_.allocate(1);
     node_->unlink();
     size_type n = mystl::distance(first, last);
     size_ = n;
     try
     {
-        for(; n > 0; --n){
+        for(; n > 0; --n, ++first){
             // 创建节点
             auto node = create_node(*first);
             link_nodes_at_back(node->as_base(), node->as_base());
@@ -830,16 +846,16 @@ void list<T>::copy_init(IIter first, IIter last)
     catch(...)
     {
         clear();
-        base_allocator::deallocate(node_);
+        base_alloc_.deallocate(node_, 1);
         node_ = nullptr;
         throw;
     } 
 }
 
 // 在 pos 处连接一个节点
-template <class T>
-typename list<T>::iterator 
-list<T>::link_iter_node(const_iterator pos, base_ptr link_node)
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator 
+list<T, Alloc>::link_iter_node(const_iterator pos, base_ptr link_node)
 { 
   if (pos == node_->next)
   {
@@ -858,8 +874,8 @@ list<T>::link_iter_node(const_iterator pos, base_ptr link_node)
 
 
 // 在pos位置之前插入[first, last]的节点
-template <class T>
-void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last)
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes(base_ptr pos, base_ptr first, base_ptr last)
 {
     pos->prev->next = first;
     first->prev = pos->prev;
@@ -867,8 +883,8 @@ void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last)
     last->next = pos;
 }
 // 在头部连接 [first, last] 结点
-template <class T>
-void list<T>::link_nodes_at_front(base_ptr first, base_ptr last)
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes_at_front(base_ptr first, base_ptr last)
 {
   first->prev = node_;
   last->next = node_->next;
@@ -877,8 +893,8 @@ void list<T>::link_nodes_at_front(base_ptr first, base_ptr last)
 }
 
 // 在尾部连接 [first, last] 结点
-template <class T>
-void list<T>::link_nodes_at_back(base_ptr first, base_ptr last)
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes_at_back(base_ptr first, base_ptr last)
 {
   last->next = node_;
   first->prev = node_->prev;
@@ -886,15 +902,15 @@ void list<T>::link_nodes_at_back(base_ptr first, base_ptr last)
   node_->prev = last;
 }
 
-template <class T>
-void list<T>::unlink_nodes(base_ptr first, base_ptr last)
+template <class T, class Alloc>
+void list<T, Alloc>::unlink_nodes(base_ptr first, base_ptr last)
 {
     first->prev->next = last->next;
     last->next->prev = first->prev;
 }
 
-template <class T>
-void list<T>::fill_assign(size_type n, const value_type& value)
+template <class T, class Alloc>
+void list<T, Alloc>::fill_assign(size_type n, const value_type& value)
 {
     auto i = begin();
     auto e = end();
@@ -908,9 +924,9 @@ void list<T>::fill_assign(size_type n, const value_type& value)
     
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class IIter>
-void list<T>::copy_assign(IIter f2, IIter l2)
+void list<T, Alloc>::copy_assign(IIter f2, IIter l2)
 {
   auto f1 = begin();
   auto l1 = end();
@@ -930,9 +946,9 @@ void list<T>::copy_assign(IIter f2, IIter l2)
 
 
 // 在 pos 处插入n个元素
-template <class T>
-typename list<T>::iterator
-list<T>::fill_insert(const_iterator pos, size_type n, const value_type& value)
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::fill_insert(const_iterator pos, size_type n, const value_type& value)
 {
     iterator r(pos.node_);
     if(n != 0)
@@ -972,10 +988,10 @@ list<T>::fill_insert(const_iterator pos, size_type n, const value_type& value)
 }
 // 在 pos 处插入 [first, last) 的元素
 // 和fill_insert 思路一样
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-typename list<T>::iterator 
-list<T>::copy_insert(const_iterator pos, size_type n, Iter first)
+typename list<T, Alloc>::iterator 
+list<T, Alloc>::copy_insert(const_iterator pos, size_type n, Iter first)
 {
   iterator r(pos.node_);
   if (n != 0)
@@ -1014,10 +1030,10 @@ list<T>::copy_insert(const_iterator pos, size_type n, Iter first)
 }
 
 // 对 list 进行归并排序，返回一个迭代器指向区间最小元素的位置
-template <class T>
+template <class T, class Alloc>
 template <class Compared>
-typename list<T>::iterator 
-list<T>::list_sort(iterator f1, iterator l2, size_type n, Compared comp)
+typename list<T, Alloc>::iterator 
+list<T, Alloc>::list_sort(iterator f1, iterator l2, size_type n, Compared comp)
 {
   if (n < 2)
     return f1;
@@ -1091,8 +1107,8 @@ list<T>::list_sort(iterator f1, iterator l2, size_type n, Compared comp)
 }
 
 // 重载比较操作符
-template <class T>
-bool operator==(const list<T>& lhs, const list<T>& rhs)
+template <class T, class Alloc>
+bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs)
 {
   auto f1 = lhs.cbegin();
   auto f2 = rhs.cbegin();
@@ -1103,39 +1119,44 @@ bool operator==(const list<T>& lhs, const list<T>& rhs)
   return f1 == l1 && f2 == l2;
 }
 
-template <class T>
-bool operator<(const list<T>& lhs, const list<T>& rhs)
+template <class T, class Alloc>
+bool operator<(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs)
 {
   return mystl::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
 }
 
-template <class T>
-bool operator!=(const list<T>& lhs, const list<T>& rhs)
+template <class T, class Alloc>
+bool operator!=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs)
 {
   return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const list<T>& lhs, const list<T>& rhs)
+template <class T, class Alloc>
+bool operator>(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs)
 {
   return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const list<T>& lhs, const list<T>& rhs)
+template <class T, class Alloc>
+bool operator<=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs)
 {
   return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const list<T>& lhs, const list<T>& rhs)
+template <class T, class Alloc>
+bool operator>=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs)
 {
   return !(lhs < rhs);
 }
 
+// 尾节点 node_ 分配在堆上，list 对象可以按字节搬移
+template <class T, class Alloc>
+struct is_trivially_relocatable<list<T, Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
-template <class T>
-void swap(list<T>& lhs, list<T>& rhs) noexcept
+template <class T, class Alloc>
+void swap(list<T, Alloc>& lhs, list<T, Alloc>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
@@ -0,0 +1,363 @@
+#ifndef MYSTL_LOCKFREE_STACK_H
+#define MYSTL_LOCKFREE_STACK_H
+
+// 这个头文件包含一个模板类 lockfree_stack
+// lockfree_stack : Treiber 无锁栈，任意多个线程可以同时 push / pop
+// 栈顶指针与一个计数打包在一个 64 位整数里，每次修改栈顶计数加一，CAS 比较的是整个字，
+// 节点被弹出后又以同一地址压回（ABA）时计数已经不同，CAS 会失败
+// 计数有宽度限制，只有当一个线程在读栈顶和 CAS 之间被挂起、期间栈顶恰好被修改了计数的整数倍次，
+// 并且指针又回到原值时才会误判成功
+// 64 位平台上节点按 8 字节对齐，指针去掉低 3 位后占 45 位，只能表示 48 位以内的地址，
+// 计数占 19 位（524288 次修改才回绕）；32 位平台上指针和计数各占 32 位
+// 分配到无法表示的地址（如开启 5 级页表后高于 2^48 的地址）时抛出 runtime_error
+// 弹出的节点不还给空间配置器，而是挂到同样带计数的空闲链表上复用，直到析构才统一释放，
+// 所以其它线程读到已被弹出的节点的 next 也不会访问已释放的内存
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "allocator.h"
+#include "construct.h"
+#include "concurrency.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+namespace lockfree_detail
+{
+
+// 带计数的单链表头，Node 需要有 std::atomic<Node*> next
+template <class Node>
+class tagged_head
+{
+private:
+  static constexpr unsigned addr_bits = sizeof(void*) == 8 ? 48 : 32;  // 可表示的地址位数
+  static constexpr unsigned low_bits  = sizeof(void*) == 8 ? 3 : 0;    // 因对齐恒为 0 的低位
+  static constexpr unsigned ptr_bits  = addr_bits - low_bits;
+  static constexpr uint64_t ptr_mask  = (uint64_t(1) << ptr_bits) - 1;
+
+  static_assert(alignof(Node) >= (size_t(1) << low_bits),
+                "tagged_head requires nodes aligned to 8 bytes on 64-bit platforms");
+
+  static Node*    ptr(uint64_t w) noexcept
+  { return reinterpret_cast<Node*>(static_cast<uintptr_t>((w & ptr_mask) << low_bits)); }
+  static uint64_t next_tag(uint64_t w) noexcept
+  { return (w & ~ptr_mask) + (uint64_t(1) << ptr_bits); }
+  static uint64_t pack(Node* p, uint64_t tag) noexcept
+  {
+    MYSTL_DEBUG(representable(p));
+    return (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p)) >> low_bits) | tag;
+  }
+
+public:
+  // 节点地址能否放进打包的字里，新分配的节点在使用前必须检查
+  static bool representable(const Node* p) noexcept
+  {
+    const uint64_t addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p));
+    return (addr >> addr_bits) == 0;
+  }
+
+
+  tagged_head() noexcept
+    :word_(0)
+  {
+  }
+
+  tagged_head(const tagged_head&) = delete;
+  tagged_head& operator=(const tagged_head&) = delete;
+
+  bool empty() const noexcept
+  { return ptr(word_.load(std::memory_order_relaxed)) == nullptr; }
+
+  // 把已连好的 [first, last] 整段放到链表头部
+  void push_chain(Node* first, Node* last) noexcept
+  {
+    uint64_t old = word_.load(std::memory_order_relaxed);
+    for (backoff bo; ; bo.pause())
+    {
+      last->next.store(ptr(old), std::memory_order_relaxed);
+      if (word_.compare_exchange_weak(old, pack(first, next_tag(old)),
+                                      std::memory_order_release, std::memory_order_relaxed))
+        return;
+    }
+  }
+
+  // 取下头部节点，链表为空时返回 nullptr
+  Node* pop() noexcept
+  {
+    uint64_t old = word_.load(std::memory_order_acquire);
+    for (backoff bo; ptr(old) != nullptr; bo.pause())
+    {
+      Node* n = ptr(old);
+      // n 可能已被其它线程弹出并复用，读到的 next 可能过时，此时计数已变，CAS 必然失败
+      Node* next = n->next.load(std::memory_order_relaxed);
+      if (word_.compare_exchange_weak(old, pack(next, next_tag(old)),
+                                      std::memory_order_acquire, std::memory_order_acquire))
+        return n;
+    }
+    return nullptr;
+  }
+
+  // 一次取下整条链表
+  Node* take_all() noexcept
+  {
+    uint64_t old = word_.load(std::memory_order_relaxed);
+    while (ptr(old) != nullptr &&
+           !word_.compare_exchange_weak(old, pack(nullptr, next_tag(old)),
+                                        std::memory_order_acquire, std::memory_order_relaxed))
+      ;
+    return ptr(old);
+  }
+
+private:
+  std::atomic<uint64_t> word_;
+};
+
+} // namespace lockfree_detail
+
+// 模板类: lockfree_stack
+// 模板参数 T 代表类型，Alloc 代表空间配置器，缺省使用 mystl::allocator
+template <class T, class Alloc = mystl::allocator<T>>
+class lockfree_stack
+{
+public:
+  // lockfree_stack 的嵌套型别定义
+  typedef Alloc                                    allocator_type;
+
+  typedef T                                        value_type;
+  typedef T*                                       pointer;
+  typedef T&                                       reference;
+  typedef const T&                                 const_reference;
+  typedef size_t                                   size_type;
+
+private:
+  struct node
+  {
+    std::atomic<node*> next;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    pointer value() noexcept { return reinterpret_cast<pointer>(&storage); }
+  };
+
+  typedef typename Alloc::template rebind<node>::other node_allocator;
+  typedef lockfree_detail::tagged_head<node>           head_type;
+
+  alignas(cache_line_size) head_type top_;   // 栈
+  alignas(cache_line_size) head_type free_;  // 空闲节点
+  alignas(cache_line_size) node_allocator alloc_;
+
+public:
+  lockfree_stack() = default;
+
+  lockfree_stack(const lockfree_stack&) = delete;
+  lockfree_stack& operator=(const lockfree_stack&) = delete;
+
+  // 析构时不能有线程仍在使用栈
+  ~lockfree_stack()
+  {
+    node* n = top_.take_all();
+    while (n != nullptr)
+    {
+      node* next = n->next.load(std::memory_order_relaxed);
+      mystl::destroy(n->value());
+      alloc_.deallocate(n, 1);
+      n = next;
+    }
+    release_free_nodes();
+  }
+
+public:
+  // 并发修改时只是近似值
+  bool empty() const noexcept { return top_.empty(); }
+
+  // 预先分配 n 个空闲节点，之后的 push 在空闲节点用完之前不再分配内存
+  void reserve(size_type n)
+  {
+    for (; n > 0; --n)
+    {
+      node* p = allocate_node();
+      free_.push_chain(p, p);
+    }
+  }
+
+  // 入栈 ----------------------------------------------------------------------
+
+  template <class ...Args>
+  void emplace(Args&& ...args)
+  {
+    node* n = create_node(mystl::forward<Args>(args)...);
+    top_.push_chain(n, n);
+  }
+
+  void push(const value_type& value) { emplace(value); }
+  void push(value_type&& value)      { emplace(mystl::move(value)); }
+
+  // 先在本线程内把 [first, last) 连成一段，再用一次 CAS 放到栈顶，
+  // 最后一个元素位于栈顶，与逐个 push 的顺序相同
+  template <class IIter>
+  void push_range(IIter first, IIter last);
+
+  // 出栈 ----------------------------------------------------------------------
+
+  // 栈为空时返回 false，移动赋值抛出异常时该元素被丢弃
+  bool try_pop(value_type& value)
+  {
+    node* n = top_.pop();
+    if (n == nullptr)
+      return false;
+    try
+    {
+      value = mystl::move(*n->value());
+    }
+    catch (...)
+    { // 节点已从栈上取下，不回收就会丢失
+      recycle(n);
+      throw;
+    }
+    recycle(n);
+    return true;
+  }
+
+  // 一次取下整个栈，按从栈顶到栈底的顺序移动到 result，返回取出的个数
+  // 移动赋值抛出异常时尚未取出的元素全部被丢弃
+  template <class OutputIter>
+  size_type pop_all(OutputIter result);
+
+  // 丢弃所有元素
+  void clear()
+  {
+    node* n = top_.take_all();
+    while (n != nullptr)
+    {
+      node* next = n->next.load(std::memory_order_relaxed);
+      recycle(n);
+      n = next;
+    }
+  }
+
+  // 归还空闲链表上的节点，弹出中的线程可能还在读这些节点，调用时不能有其它线程在使用栈
+  void shrink_to_fit() noexcept { release_free_nodes(); }
+
+private:
+  template <class ...Args>
+  node* create_node(Args&& ...args)
+  {
+    node* n = free_.pop();
+    if (n == nullptr)
+      n = allocate_node();
+    try
+    {
+      mystl::construct(n->value(), mystl::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      free_.push_chain(n, n);
+      throw;
+    }
+    return n;
+  }
+
+  node* allocate_node()
+  {
+    node* n = alloc_.allocate(1);
+    const bool ok = head_type::representable(n);
+    if (!ok)
+      alloc_.deallocate(n, 1);
+    THROW_RUNTIME_ERROR_IF(!ok, "lockfree_stack<T>'s node address out of range");
+    mystl::construct(&n->next, nullptr);
+    return n;
+  }
+
+  // 析构元素，节点挂回空闲链表
+  void recycle(node* n) noexcept
+  {
+    mystl::destroy(n->value());
+    free_.push_chain(n, n);
+  }
+
+  void release_free_nodes() noexcept
+  {
+    node* n = free_.take_all();
+    while (n != nullptr)
+    {
+      node* next = n->next.load(std::memory_order_relaxed);
+      alloc_.deallocate(n, 1);
+      n = next;
+    }
+  }
+};
+
+/*****************************************************************************************/
+
+template <class T, class Alloc>
+template <class IIter>
+void lockfree_stack<T, Alloc>::push_range(IIter first, IIter last)
+{
+  node* top = nullptr;
+  node* bottom = nullptr;
+  try
+  {
+    for (; first != last; ++first)
+    {
+      node* n = create_node(*first);
+      n->next.store(top, std::memory_order_relaxed);
+      top = n;
+      if (bottom == nullptr)
+        bottom = n;
+    }
+  }
+  catch (...)
+  {
+    while (top != nullptr)
+    {
+      node* next = top->next.load(std::memory_order_relaxed);
+      recycle(top);
+      top = next;
+    }
+    throw;
+  }
+  if (top != nullptr)
+    top_.push_chain(top, bottom);
+}
+
+template <class T, class Alloc>
+template <class OutputIter>
+typename lockfree_stack<T, Alloc>::size_type
+lockfree_stack<T, Alloc>::pop_all(OutputIter result)
+{
+  node* n = top_.take_all();
+  if (n == nullptr)
+    return 0;
+  size_type count = 0;
+  node* first = n;
+  node* last = n;
+  try
+  {
+    for (; n != nullptr; n = n->next.load(std::memory_order_relaxed))
+    { // 取下的链表只属于本线程
+      last = n;
+      *result = mystl::move(*n->value());
+      ++result;
+      mystl::destroy(n->value());
+      ++count;
+    }
+  }
+  catch (...)
+  { // 析构 n 及之后的元素，整条链表挂回空闲链表
+    for (; n != nullptr; n = n->next.load(std::memory_order_relaxed))
+    {
+      mystl::destroy(n->value());
+      last = n;
+    }
+    free_.push_chain(first, last);
+    throw;
+  }
+  free_.push_chain(first, last);
+  return count;
+}
+
+} // namespace mystl
+#endif // !MYSTL_LOCKFREE_STACK_H
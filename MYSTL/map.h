@@ -12,8 +12,10 @@ namespace mystl
 
 // 模板类 map, 键值不允许重复
 // 参数一代表键值类型， 参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl:less
+// 参数四代表空间配置器，缺省使用 mystl::allocator
 
-template <class Key, class T, class Compare = mystl::less<Key>>
+template <class Key, class T, class Compare = mystl::less<Key>,
+          class Alloc = mystl::allocator<mystl::pair<const Key, T>>>
 class map
 {
 public:
@@ -27,7 +29,7 @@ public:
     class value_compare: public binary_function <value_type, value_type, bool>
     {   
         // 声明一个友元类
-        friend class map<Key, T, Compare>;
+        friend class map<Key, T, Compare, Alloc>;
     private:
         Compare comp;
         value_compare(Compare c): comp(c) {}
@@ -40,7 +42,7 @@ public:
 
 private:
     // 以 mystl:rb_tree 作为底层实现
-    typedef mystl::rb_tree<value_type, key_compare> base_type;
+    typedef mystl::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;
 
 public:
@@ -61,14 +63,24 @@ public:
 public:
     // 默认构造函数
     map() = default;
+    explicit map(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        :tree_(comp, alloc)
+    {
+    }
+    explicit map(const allocator_type& alloc)
+        :tree_(key_compare(), alloc)
+    {
+    }
     
     template <class InputIterator>
-    map(InputIterator first, InputIterator last)
-        : tree_()
+    map(InputIterator first, InputIterator last,
+        const allocator_type& alloc = allocator_type())
+        : tree_(key_compare(), alloc)
     { tree_.insert_unique(first, last); }
     // 参数列表初始化
-    map(std::initializer_list<value_type> ilist)
-        : tree_()
+    map(std::initializer_list<value_type> ilist,
+        const allocator_type& alloc = allocator_type())
+        : tree_(key_compare(), alloc)
     {
        tree_.insert_unique(ilist.begin(), ilist.end()); 
     }
@@ -168,7 +180,7 @@ public:
     {   // it->first >= key;
         iterator it = lower_bound(key);
         // 如果it ==end() 或者 key 严格小于 it->first,则需要进一步查找
-        if(it == end() || key_compare()(it->first,key))
+        if(it == end() || key_comp()(key, it->first))
         // 按照 位置提示it 取寻找对应的value
         // 第一次 定义it 已经是it->first >= key, 
         // 第二次 判断 it->first 严格大于 key 
@@ -256,45 +268,51 @@ public:
 };
 
 // 重载比较操作符
-template <class Key, class T, class Compare>
-bool operator==(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
 {
   return lhs == rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
 {
   return lhs < rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator!=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
 {
   return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator>(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
 {
   return rhs < lhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator<=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
 {
   return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator>=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
 {
   return !(lhs < rhs);
 }
 
+// 与底层的 rb_tree 相同
+template <class Key, class T, class Compare, class Alloc>
+struct is_trivially_relocatable<map<Key, T, Compare, Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<Compare>::value &&
+                                 is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
-template <class Key, class T, class Compare>
-void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept
+template <class Key, class T, class Compare, class Alloc>
+void swap(map<Key, T, Compare, Alloc>& lhs, map<Key, T, Compare, Alloc>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
@@ -304,7 +322,9 @@ void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept
 
 // 模板类： multi-map, 键值允许重复
 // 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl::less
-template <class Key, class T, class Compare = mystl::less<Key>>
+// 参数四代表空间配置器，缺省使用 mystl::allocator
+template <class Key, class T, class Compare = mystl::less<Key>,
+          class Alloc = mystl::allocator<mystl::pair<const Key, T>>>
 class multimap
 {
 public:
@@ -317,7 +337,7 @@ public:
   // 定义一个 functor，用来进行元素比较
     class value_compare : public binary_function <value_type, value_type, bool>
     {
-        friend class multimap<Key, T, Compare>;
+        friend class multimap<Key, T, Compare, Alloc>;
     private:
         Compare comp;
         value_compare(Compare c) : comp(c) {}
@@ -330,7 +350,7 @@ public:
 
 private:
   // 用 mystl::rb_tree 作为底层机制
-    typedef mystl::rb_tree<value_type, key_compare>  base_type;
+    typedef mystl::rb_tree<value_type, key_compare, Alloc>  base_type;
     base_type tree_;
 
 public:
@@ -352,13 +372,23 @@ public:
   // 构造、复制、移动函数
 
     multimap() = default;
+    explicit multimap(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        :tree_(comp, alloc)
+    {
+    }
+    explicit multimap(const allocator_type& alloc)
+        :tree_(key_compare(), alloc)
+    {
+    }
 
     template <class InputIterator>
-    multimap(InputIterator first, InputIterator last) 
-        :tree_() 
+    multimap(InputIterator first, InputIterator last,
+             const allocator_type& alloc = allocator_type())
+        :tree_(key_compare(), alloc) 
     { tree_.insert_multi(first, last); }
-    multimap(std::initializer_list<value_type> ilist) 
-        :tree_() 
+    multimap(std::initializer_list<value_type> ilist,
+             const allocator_type& alloc = allocator_type())
+        :tree_(key_compare(), alloc) 
     { tree_.insert_multi(ilist.begin(), ilist.end()); }
 
     multimap(const multimap& rhs)
@@ -502,45 +532,51 @@ public:
 };
 
 // 重载比较操作符
-template <class Key, class T, class Compare>
-bool operator==(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
 {
   return lhs == rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
 {
   return lhs < rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator!=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
 {
   return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator>(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
 {
   return rhs < lhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator<=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
 {
   return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc>
+bool operator>=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
 {
   return !(lhs < rhs);
 }
 
+// 与底层的 rb_tree 相同
+template <class Key, class T, class Compare, class Alloc>
+struct is_trivially_relocatable<multimap<Key, T, Compare, Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<Compare>::value &&
+                                 is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
-template <class Key, class T, class Compare>
-void swap(multimap<Key, T, Compare>& lhs, multimap<Key, T, Compare>& rhs) noexcept
+template <class Key, class T, class Compare, class Alloc>
+void swap(multimap<Key, T, Compare, Alloc>& lhs, multimap<Key, T, Compare, Alloc>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
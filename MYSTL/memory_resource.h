@@ -0,0 +1,657 @@
+#ifndef MYSTL_MEMORY_RESOURCE_H
+#define MYSTL_MEMORY_RESOURCE_H
+
+// 这个头文件包含多态内存资源 memory_resource 及其几种实现，以及配合它们使用的 polymorphic_allocator
+// monotonic_buffer_resource       : 只进不退的线性分配，deallocate 什么也不做，release 时一次归还
+// unsynchronized_pool_resource    : 按大小分级的内存池，不加锁
+// synchronized_pool_resource      : 加锁的 unsynchronized_pool_resource，可以在多个线程间共享
+
+#include <new>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+
+#include "construct.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 类 memory_resource
+// 所有内存资源的抽象基类，派生类实现 do_allocate / do_deallocate / do_is_equal
+class memory_resource
+{
+public:
+  enum : size_t { max_align = alignof(std::max_align_t) };
+
+  virtual ~memory_resource() = default;
+
+  void* allocate(size_t bytes, size_t alignment = max_align)
+  { return do_allocate(bytes, alignment); }
+
+  void  deallocate(void* p, size_t bytes, size_t alignment = max_align)
+  { do_deallocate(p, bytes, alignment); }
+
+  bool  is_equal(const memory_resource& other) const noexcept
+  { return do_is_equal(other); }
+
+private:
+  virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+  virtual void  do_deallocate(void* p, size_t bytes, size_t alignment) = 0;
+  virtual bool  do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource& lhs, const memory_resource& rhs) noexcept
+{
+  return &lhs == &rhs || lhs.is_equal(rhs);
+}
+
+inline bool operator!=(const memory_resource& lhs, const memory_resource& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+namespace mr_detail
+{
+
+inline size_t align_up(size_t n, size_t align) noexcept
+{
+  return (n + align - 1) & ~(align - 1);
+}
+
+inline char* align_up(char* p, size_t align) noexcept
+{
+  return reinterpret_cast<char*>(align_up(reinterpret_cast<size_t>(p), align));
+}
+
+// 使用 operator new 的内存资源，对齐要求超过 max_align 时多申请一段空间，并在返回地址之前记下原始指针
+class new_delete_resource_impl : public memory_resource
+{
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override
+  {
+    if (alignment <= max_align)
+      return ::operator new(bytes);
+    char* raw = static_cast<char*>(::operator new(bytes + alignment + sizeof(void*)));
+    char* p = align_up(raw + sizeof(void*), alignment);
+    reinterpret_cast<void**>(p)[-1] = raw;
+    return p;
+  }
+
+  void do_deallocate(void* p, size_t, size_t alignment) override
+  {
+    if (p == nullptr)
+      return;
+    if (alignment <= max_align)
+      ::operator delete(p);
+    else
+      ::operator delete(static_cast<void**>(p)[-1]);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+// 任何分配请求都失败的内存资源，用于检查 monotonic_buffer_resource 的初始缓冲区是否够用
+class null_resource_impl : public memory_resource
+{
+private:
+  void* do_allocate(size_t, size_t) override
+  {
+    throw std::bad_alloc();
+  }
+
+  void do_deallocate(void*, size_t, size_t) override
+  {
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+} // namespace mr_detail
+
+// 全局的 new / delete 内存资源和空内存资源，对象有意不析构
+inline memory_resource* new_delete_resource() noexcept
+{
+  static memory_resource* r = new mr_detail::new_delete_resource_impl;
+  return r;
+}
+
+inline memory_resource* null_memory_resource() noexcept
+{
+  static memory_resource* r = new mr_detail::null_resource_impl;
+  return r;
+}
+
+namespace mr_detail
+{
+
+inline std::atomic<memory_resource*>& default_resource() noexcept
+{
+  static std::atomic<memory_resource*> r(new_delete_resource());
+  return r;
+}
+
+} // namespace mr_detail
+
+// 默认内存资源，缺省为 new_delete_resource()，polymorphic_allocator 默认构造时使用它
+inline memory_resource* get_default_resource() noexcept
+{
+  return mr_detail::default_resource().load(std::memory_order_acquire);
+}
+
+// 设置默认内存资源，传入 nullptr 表示恢复为 new_delete_resource()，返回原来的值
+inline memory_resource* set_default_resource(memory_resource* r) noexcept
+{
+  if (r == nullptr)
+    r = new_delete_resource();
+  return mr_detail::default_resource().exchange(r, std::memory_order_acq_rel);
+}
+
+/*****************************************************************************************/
+
+// 类 monotonic_buffer_resource
+// 在当前缓冲区上按顺序切分，不够时向上游申请一个更大的缓冲区（几何增长）
+// deallocate 不做任何事，所有内存在 release 或析构时一次性还给上游
+// 适合生命周期很短、一次请求内用完即弃的容器
+class monotonic_buffer_resource : public memory_resource
+{
+private:
+  // 每个向上游申请的缓冲区头部都记录着链表指针和大小
+  struct chunk
+  {
+    chunk* next;
+    size_t size;
+  };
+
+public:
+  enum : size_t { default_initial_size = 1024 };
+
+  monotonic_buffer_resource() noexcept
+    :monotonic_buffer_resource(get_default_resource())
+  {
+  }
+
+  explicit monotonic_buffer_resource(memory_resource* upstream) noexcept
+    :upstream_(upstream), initial_buffer_(nullptr), initial_size_(0),
+     cur_(nullptr), end_(nullptr), next_size_(default_initial_size), chunks_(nullptr)
+  {
+  }
+
+  explicit monotonic_buffer_resource(size_t initial_size,
+                                     memory_resource* upstream = get_default_resource()) noexcept
+    :upstream_(upstream), initial_buffer_(nullptr), initial_size_(0),
+     cur_(nullptr), end_(nullptr), next_size_(initial_size == 0 ? 1 : initial_size), chunks_(nullptr)
+  {
+  }
+
+  // 先使用调用者提供的 buffer，用完后再向上游申请
+  monotonic_buffer_resource(void* buffer, size_t buffer_size,
+                            memory_resource* upstream = get_default_resource()) noexcept
+    :upstream_(upstream), initial_buffer_(static_cast<char*>(buffer)), initial_size_(buffer_size),
+     cur_(static_cast<char*>(buffer)), end_(static_cast<char*>(buffer) + buffer_size),
+     next_size_(buffer_size == 0 ? default_initial_size : buffer_size * 2), chunks_(nullptr)
+  {
+  }
+
+  monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+  monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+  ~monotonic_buffer_resource() { release(); }
+
+public:
+  // 归还所有向上游申请的缓冲区，重新从初始 buffer 开始分配
+  void release() noexcept
+  {
+    while (chunks_ != nullptr)
+    {
+      chunk* next = chunks_->next;
+      upstream_->deallocate(chunks_, chunks_->size, max_align);
+      chunks_ = next;
+    }
+    cur_ = initial_buffer_;
+    end_ = initial_buffer_ == nullptr ? nullptr : initial_buffer_ + initial_size_;
+  }
+
+  memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override
+  {
+    if (bytes == 0)
+      bytes = 1;
+    char* p = cur_ == nullptr ? nullptr : mr_detail::align_up(cur_, alignment);
+    if (p == nullptr || p > end_ || static_cast<size_t>(end_ - p) < bytes)
+    {
+      new_chunk(bytes, alignment);
+      p = mr_detail::align_up(cur_, alignment);
+    }
+    cur_ = p + bytes;
+    return p;
+  }
+
+  void do_deallocate(void*, size_t, size_t) override
+  {
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+
+  void new_chunk(size_t bytes, size_t alignment)
+  {
+    const size_t header = mr_detail::align_up(sizeof(chunk), max_align);
+    size_t size = header + bytes + (alignment > max_align ? alignment : 0);
+    if (size < next_size_)
+      size = next_size_;
+    chunk* c = static_cast<chunk*>(upstream_->allocate(size, max_align));
+    c->next = chunks_;
+    c->size = size;
+    chunks_ = c;
+    cur_ = reinterpret_cast<char*>(c) + header;
+    end_ = reinterpret_cast<char*>(c) + size;
+    next_size_ = size * 2;
+  }
+
+private:
+  memory_resource* upstream_;        // 上游内存资源
+  char*            initial_buffer_;  // 调用者提供的初始缓冲区
+  size_t           initial_size_;    // 初始缓冲区的大小
+  char*            cur_;             // 当前缓冲区中未使用部分的起始位置
+  char*            end_;             // 当前缓冲区的末尾
+  size_t           next_size_;       // 下一次向上游申请的大小
+  chunk*           chunks_;          // 向上游申请的缓冲区链表
+};
+
+/*****************************************************************************************/
+
+// 池资源的参数
+// max_blocks_per_chunk        : 每次为一个池补充的块数上限
+// largest_required_pool_block : 由池负责的最大块，更大的请求直接交给上游
+struct pool_options
+{
+  size_t max_blocks_per_chunk = 0;
+  size_t largest_required_pool_block = 0;
+};
+
+// 类 unsynchronized_pool_resource
+// 按 8、16、32 ... 字节分级，每一级是一个从上游申请 chunk 并切分成定长块的空闲链表
+// 超过 largest_required_pool_block 的请求直接交给上游，但仍会被记录下来，release 时一并归还
+// 不加锁，只能在一个线程内使用
+class unsynchronized_pool_resource : public memory_resource
+{
+private:
+  struct free_block { free_block* next; };
+  struct chunk      { chunk* next; size_t size; };
+
+  // 大块头部，双向链表便于单独归还
+  struct big_block
+  {
+    big_block* prev;
+    big_block* next;
+  };
+
+  struct pool
+  {
+    size_t      block_size;
+    size_t      next_blocks;  // 下一个 chunk 的块数
+    free_block* free;
+    chunk*      chunks;
+  };
+
+  enum : size_t
+  {
+    min_block          = 8,
+    max_pools          = 16,    // 8B ~ 256KB
+    default_largest    = 4096,
+    default_max_blocks = 1024,
+    first_blocks       = 16
+  };
+
+public:
+  unsynchronized_pool_resource()
+    :unsynchronized_pool_resource(pool_options(), get_default_resource())
+  {
+  }
+
+  explicit unsynchronized_pool_resource(memory_resource* upstream)
+    :unsynchronized_pool_resource(pool_options(), upstream)
+  {
+  }
+
+  explicit unsynchronized_pool_resource(const pool_options& opts,
+                                        memory_resource* upstream = get_default_resource())
+    :upstream_(upstream), big_(nullptr)
+  {
+    size_t largest = opts.largest_required_pool_block == 0
+      ? default_largest : opts.largest_required_pool_block;
+    max_blocks_ = opts.max_blocks_per_chunk == 0
+      ? default_max_blocks : opts.max_blocks_per_chunk;
+    pool_count_ = 0;
+    for (size_t size = min_block; pool_count_ < max_pools; size <<= 1)
+    {
+      pools_[pool_count_].block_size = size;
+      pools_[pool_count_].next_blocks = first_blocks < max_blocks_ ? first_blocks : max_blocks_;
+      pools_[pool_count_].free = nullptr;
+      pools_[pool_count_].chunks = nullptr;
+      ++pool_count_;
+      if (size >= largest)
+        break;
+    }
+  }
+
+  unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+  unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+  ~unsynchronized_pool_resource() { release(); }
+
+public:
+  // 归还所有池中的 chunk 以及所有大块
+  void release() noexcept
+  {
+    for (size_t i = 0; i < pool_count_; ++i)
+    {
+      pool& pl = pools_[i];
+      while (pl.chunks != nullptr)
+      {
+        chunk* next = pl.chunks->next;
+        upstream_->deallocate(pl.chunks, pl.chunks->size, max_align);
+        pl.chunks = next;
+      }
+      pl.free = nullptr;
+      pl.next_blocks = first_blocks < max_blocks_ ? first_blocks : max_blocks_;
+    }
+    while (big_ != nullptr)
+    {
+      big_block* next = big_->next;
+      upstream_->deallocate(big_, big_size(big_), max_align);
+      big_ = next;
+    }
+  }
+
+  memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+  pool_options options() const noexcept
+  {
+    pool_options opts;
+    opts.max_blocks_per_chunk = max_blocks_;
+    opts.largest_required_pool_block = pools_[pool_count_ - 1].block_size;
+    return opts;
+  }
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override
+  {
+    const size_t index = pool_index(bytes, alignment);
+    if (index == pool_count_)
+      return allocate_big(bytes, alignment);
+    pool& pl = pools_[index];
+    if (pl.free == nullptr)
+      refill(pl);
+    free_block* p = pl.free;
+    pl.free = p->next;
+    return p;
+  }
+
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override
+  {
+    if (p == nullptr)
+      return;
+    const size_t index = pool_index(bytes, alignment);
+    if (index == pool_count_)
+    {
+      deallocate_big(p, bytes, alignment);
+      return;
+    }
+    free_block* b = static_cast<free_block*>(p);
+    b->next = pools_[index].free;
+    pools_[index].free = b;
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+
+private:
+  // 找到能容纳 bytes 的最小一级，对齐要求超过 max_align 或大小超过最大一级时返回 pool_count_
+  size_t pool_index(size_t bytes, size_t alignment) const noexcept
+  {
+    if (alignment > max_align)
+      return pool_count_;
+    size_t size = bytes < alignment ? alignment : bytes;
+    size_t i = 0;
+    while (i < pool_count_ && pools_[i].block_size < size)
+      ++i;
+    return i;
+  }
+
+  // 为一级池补充一个 chunk，块数按几何增长直到 max_blocks_
+  void refill(pool& pl)
+  {
+    const size_t header = mr_detail::align_up(sizeof(chunk), max_align);
+    const size_t size = header + pl.block_size * pl.next_blocks;
+    chunk* c = static_cast<chunk*>(upstream_->allocate(size, max_align));
+    c->next = pl.chunks;
+    c->size = size;
+    pl.chunks = c;
+    // 从后往前串起来，使分配顺序与地址顺序一致
+    char* first = reinterpret_cast<char*>(c) + header;
+    for (size_t i = pl.next_blocks; i > 0; --i)
+    {
+      free_block* b = reinterpret_cast<free_block*>(first + (i - 1) * pl.block_size);
+      b->next = pl.free;
+      pl.free = b;
+    }
+    if (pl.next_blocks < max_blocks_)
+      pl.next_blocks = pl.next_blocks * 2 < max_blocks_ ? pl.next_blocks * 2 : max_blocks_;
+  }
+
+  static size_t big_header(size_t alignment) noexcept
+  {
+    const size_t align = alignment > max_align ? alignment : max_align;
+    return mr_detail::align_up(sizeof(big_block) + sizeof(size_t), align);
+  }
+
+  // 大块的总大小记录在头部之后、用户数据之前
+  static size_t& big_size(big_block* b) noexcept
+  {
+    return *reinterpret_cast<size_t*>(b + 1);
+  }
+
+  void* allocate_big(size_t bytes, size_t alignment)
+  {
+    const size_t header = big_header(alignment);
+    const size_t size = header + bytes + (alignment > max_align ? alignment : 0);
+    char* raw = static_cast<char*>(upstream_->allocate(size, max_align));
+    char* p = mr_detail::align_up(raw + header, alignment > max_align ? alignment : max_align);
+    // 头部紧挨着用户数据，记录原始地址便于归还
+    big_block* b = reinterpret_cast<big_block*>(raw);
+    b->prev = nullptr;
+    b->next = big_;
+    big_size(b) = size;
+    if (big_ != nullptr)
+      big_->prev = b;
+    big_ = b;
+    reinterpret_cast<big_block**>(p)[-1] = b;
+    return p;
+  }
+
+  void deallocate_big(void* p, size_t, size_t)
+  {
+    big_block* b = static_cast<big_block**>(p)[-1];
+    if (b->prev != nullptr)
+      b->prev->next = b->next;
+    else
+      big_ = b->next;
+    if (b->next != nullptr)
+      b->next->prev = b->prev;
+    upstream_->deallocate(b, big_size(b), max_align);
+  }
+
+private:
+  memory_resource* upstream_;          // 上游内存资源
+  pool             pools_[max_pools];  // 各级池
+  size_t           pool_count_;        // 实际使用的级数
+  size_t           max_blocks_;        // 每个 chunk 的块数上限
+  big_block*       big_;               // 直接向上游申请的大块链表
+};
+
+// 类 synchronized_pool_resource
+// 所有操作都在一把互斥锁下转交给内部的 unsynchronized_pool_resource
+class synchronized_pool_resource : public memory_resource
+{
+public:
+  synchronized_pool_resource()
+    :pool_()
+  {
+  }
+
+  explicit synchronized_pool_resource(memory_resource* upstream)
+    :pool_(upstream)
+  {
+  }
+
+  explicit synchronized_pool_resource(const pool_options& opts,
+                                      memory_resource* upstream = get_default_resource())
+    :pool_(opts, upstream)
+  {
+  }
+
+  synchronized_pool_resource(const synchronized_pool_resource&) = delete;
+  synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
+
+public:
+  void release()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.release();
+  }
+
+  memory_resource* upstream_resource() const noexcept { return pool_.upstream_resource(); }
+  pool_options     options() const noexcept           { return pool_.options(); }
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pool_.allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+
+private:
+  std::mutex                   mutex_;
+  unsynchronized_pool_resource pool_;
+};
+
+/*****************************************************************************************/
+
+// 模板类 polymorphic_allocator
+// 把分配请求转交给一个 memory_resource，所有 mystl 容器都可以通过 Alloc 参数使用它
+// 使用方式：
+//   mystl::monotonic_buffer_resource arena;
+//   mystl::vector<int, mystl::polymorphic_allocator<int>> v(&arena);
+// 容器的拷贝构造、移动和 swap 都会带上内存资源，拷贝赋值保留目标容器原来的内存资源
+template <class T>
+class polymorphic_allocator
+{
+public:
+  typedef T            value_type;
+  typedef T*           pointer;
+  typedef const T*     const_pointer;
+  typedef T&           reference;
+  typedef const T&     const_reference;
+  typedef size_t       size_type;
+  typedef ptrdiff_t    difference_type;
+
+  template <class U>
+  struct rebind
+  {
+    typedef polymorphic_allocator<U> other;
+  };
+
+  template <class U>
+  friend class polymorphic_allocator;
+
+public:
+  polymorphic_allocator() noexcept
+    :resource_(get_default_resource())
+  {
+  }
+
+  polymorphic_allocator(memory_resource* r) noexcept
+    :resource_(r == nullptr ? get_default_resource() : r)
+  {
+  }
+
+  template <class U>
+  polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept
+    :resource_(other.resource_)
+  {
+  }
+
+  polymorphic_allocator& operator=(const polymorphic_allocator&) = default;
+
+public:
+  T* allocate(size_type n)
+  {
+    if (n == 0)
+      return nullptr;
+    THROW_LENGTH_ERROR_IF(n > static_cast<size_type>(-1) / sizeof(T),
+                          "polymorphic_allocator<T>'s size too big");
+    return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, size_type n)
+  {
+    if (ptr == nullptr)
+      return;
+    resource_->deallocate(ptr, n * sizeof(T), alignof(T));
+  }
+
+  template <class... Args>
+  void construct(T* ptr, Args&& ...args)
+  {
+    mystl::construct(ptr, mystl::forward<Args>(args)...);
+  }
+
+  void destroy(T* ptr)            { mystl::destroy(ptr); }
+  void destroy(T* first, T* last) { mystl::destroy(first, last); }
+
+  memory_resource* resource() const noexcept { return resource_; }
+
+private:
+  memory_resource* resource_;
+};
+
+template <class T, class U>
+bool operator==(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept
+{
+  return *lhs.resource() == *rhs.resource();
+}
+
+template <class T, class U>
+bool operator!=(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+} // namespace mystl
+#endif // !MYSTL_MEMORY_RESOURCE_H
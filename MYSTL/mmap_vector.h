@@ -0,0 +1,553 @@
+#ifndef MYSTL_MMAP_VECTOR_H
+#define MYSTL_MMAP_VECTOR_H
+
+// 这个头文件包含一个模板类 mmap_vector
+// mmap_vector : 元素存放在用 mmap 映射的文件中的 vector，只能保存可以按位复制的类型
+// 重新打开文件时直接映射，不需要逐个读入、构造元素；增长时用 ftruncate 加长文件再重新映射
+// 文件开头是 64 字节的文件头，记录魔数、元素大小和元素个数，之后是元素数组
+// 使用方式：
+//   mystl::mmap_vector<uint64_t> v("table.bin", mystl::mmap_mode::create);
+//   v.push_back(1); v.flush();
+//   mystl::mmap_vector<uint64_t> r("table.bin", mystl::mmap_mode::read_only);
+
+#include <new>
+#include <initializer_list>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "platform.h"
+#include "iterator.h"
+#include "algobase.h"
+#include "growth_policy.h"
+#include "exceptdef.h"
+
+#if !defined(REDBUD_LINUX) && !defined(REDBUD_OSX)
+  #error "mmap_vector requires a POSIX system."
+#endif
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace mystl
+{
+
+// 打开文件的方式
+enum class mmap_mode
+{
+  create,          // 新建文件，已存在时清空
+  open_or_create,  // 文件存在时打开原有内容，否则新建
+  read_only        // 只读打开已存在的文件，修改大小的操作抛出 std::runtime_error
+};
+
+namespace mmap_detail
+{
+
+const uint64_t magic = 0x315643455650414dULL;  // "MAPVECV1"
+const size_t   header_size = 64;
+
+struct header
+{
+  uint64_t magic;
+  uint64_t elem_size;
+  uint64_t size;       // 元素个数，直接写在映射中，随文件一起保存
+  uint64_t reserved[5];
+};
+
+static_assert(sizeof(header) == header_size, "mmap_vector header must be 64 bytes");
+
+inline size_t page_size() noexcept
+{
+  static const size_t n = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  return n;
+}
+
+inline size_t round_to_page(size_t bytes) noexcept
+{
+  const size_t page = page_size();
+  return (bytes + page - 1) / page * page;
+}
+
+} // namespace mmap_detail
+
+// 模板类: mmap_vector
+// 模板参数 T 代表元素类型，Growth 代表增长策略（见 growth_policy.h）
+// 文件长度就是容量，增长时按页取整，多出的部分也算入容量
+template <class T, class Growth = mystl::growth_2x>
+class mmap_vector
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "mmap_vector only stores trivially copyable types");
+  static_assert(alignof(T) <= mmap_detail::header_size,
+                "mmap_vector does not support alignment over 64 bytes");
+
+public:
+  // mmap_vector 的嵌套型别定义
+  typedef T                                        value_type;
+  typedef T*                                       pointer;
+  typedef const T*                                 const_pointer;
+  typedef T&                                       reference;
+  typedef const T&                                 const_reference;
+  typedef size_t                                   size_type;
+  typedef ptrdiff_t                                difference_type;
+
+  typedef value_type*                              iterator;
+  typedef const value_type*                        const_iterator;
+  typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+private:
+  int                  fd_;        // 文件描述符
+  mmap_detail::header* hdr_;       // 映射的起始地址，即文件头
+  size_type            map_len_;   // 映射的字节数，等于文件长度
+  bool                 writable_;  // 是否以读写方式打开
+
+public:
+  // 构造、移动、析构函数，不能复制
+  mmap_vector() noexcept
+    :fd_(-1), hdr_(nullptr), map_len_(0), writable_(false)
+  {
+  }
+
+  explicit mmap_vector(const char* path, mmap_mode mode = mmap_mode::open_or_create)
+    :fd_(-1), hdr_(nullptr), map_len_(0), writable_(false)
+  {
+    open(path, mode);
+  }
+
+  mmap_vector(const mmap_vector&) = delete;
+  mmap_vector& operator=(const mmap_vector&) = delete;
+
+  mmap_vector(mmap_vector&& rhs) noexcept
+    :fd_(rhs.fd_), hdr_(rhs.hdr_), map_len_(rhs.map_len_), writable_(rhs.writable_)
+  {
+    rhs.fd_ = -1;
+    rhs.hdr_ = nullptr;
+    rhs.map_len_ = 0;
+    rhs.writable_ = false;
+  }
+
+  mmap_vector& operator=(mmap_vector&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      close();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  ~mmap_vector()
+  {
+    close();
+  }
+
+public:
+  // 打开、关闭文件
+  void open(const char* path, mmap_mode mode = mmap_mode::open_or_create);
+  void close() noexcept;
+  bool is_open()     const noexcept { return hdr_ != nullptr; }
+  bool is_writable() const noexcept { return writable_; }
+
+  // 把修改过的页写回文件；async 为 true 时只安排写回，不等待完成
+  void flush(bool async = false);
+
+  // 迭代器相关操作
+  iterator               begin()         noexcept { return data(); }
+  const_iterator         begin()   const noexcept { return data(); }
+  iterator               end()           noexcept { return data() + size(); }
+  const_iterator         end()     const noexcept { return data() + size(); }
+
+  reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept { return begin(); }
+  const_iterator         cend()    const noexcept { return end(); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept { return rend(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept { return size() == 0; }
+  size_type size()     const noexcept { return hdr_ ? static_cast<size_type>(hdr_->size) : 0; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+  // 只读时容量等于大小，任何增加元素的操作都会走到 grow 并抛出异常
+  size_type capacity() const noexcept
+  { return writable_ ? (map_len_ - mmap_detail::header_size) / sizeof(T) : size(); }
+  void      reserve(size_type n);
+  void      shrink_to_fit();
+
+  // 访问元素相关操作
+  reference operator[](size_type n)
+  {
+    MYSTL_DEBUG(n < size());
+    return data()[n];
+  }
+  const_reference operator[](size_type n) const
+  {
+    MYSTL_DEBUG(n < size());
+    return data()[n];
+  }
+  reference at(size_type n)
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "mmap_vector<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "mmap_vector<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+
+  reference front()
+  {
+    MYSTL_DEBUG(!empty());
+    return data()[0];
+  }
+  const_reference front() const
+  {
+    MYSTL_DEBUG(!empty());
+    return data()[0];
+  }
+  reference back()
+  {
+    MYSTL_DEBUG(!empty());
+    return data()[size() - 1];
+  }
+  const_reference back() const
+  {
+    MYSTL_DEBUG(!empty());
+    return data()[size() - 1];
+  }
+
+  pointer       data()       noexcept
+  { return hdr_ ? reinterpret_cast<pointer>(base() + mmap_detail::header_size) : nullptr; }
+  const_pointer data() const noexcept
+  { return hdr_ ? reinterpret_cast<const_pointer>(base() + mmap_detail::header_size) : nullptr; }
+
+  // 修改容器相关操作
+
+  void assign(size_type n, const value_type& value)
+  {
+    clear();
+    resize(n, value);
+  }
+
+  template <class... Args>
+  void emplace_back(Args&& ...args)
+  {
+    const size_type n = size();
+    if (n == capacity())
+    { // 参数可能引用本容器中的元素，重新映射后会失效，先构造出来
+      const value_type tmp(mystl::forward<Args>(args)...);
+      grow(1);
+      data()[n] = tmp;
+    }
+    else
+    {
+      ::new (static_cast<void*>(data() + n)) value_type(mystl::forward<Args>(args)...);
+    }
+    hdr_->size = n + 1;
+  }
+
+  void push_back(const value_type& value)
+  { emplace_back(value); }
+
+  void pop_back()
+  {
+    MYSTL_DEBUG(!empty());
+    check_writable();
+    --hdr_->size;
+  }
+
+  // 在尾部追加 [first, first + n)，只增长一次后整段复制
+  void append(const value_type* first, size_type n);
+
+  iterator insert(const_iterator pos, const value_type& value)
+  { return insert(pos, 1, value); }
+  iterator insert(const_iterator pos, size_type n, const value_type& value);
+  iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+  { return insert(pos, ilist.begin(), ilist.end()); }
+  iterator insert(const_iterator pos, const value_type* first, const value_type* last);
+
+  iterator erase(const_iterator pos)
+  { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last);
+
+  void clear()
+  {
+    check_writable();
+    if (hdr_)
+      hdr_->size = 0;
+  }
+
+  void resize(size_type new_size) { resize(new_size, value_type()); }
+  void resize(size_type new_size, const value_type& value);
+
+  void swap(mmap_vector& rhs) noexcept
+  {
+    mystl::swap(fd_, rhs.fd_);
+    mystl::swap(hdr_, rhs.hdr_);
+    mystl::swap(map_len_, rhs.map_len_);
+    mystl::swap(writable_, rhs.writable_);
+  }
+
+private:
+  // helper functions
+
+  char*       base()       noexcept { return reinterpret_cast<char*>(hdr_); }
+  const char* base() const noexcept { return reinterpret_cast<const char*>(hdr_); }
+
+  void check_writable() const
+  {
+    THROW_RUNTIME_ERROR_IF(!writable_, "mmap_vector<T> is not opened for writing");
+  }
+
+  void map_file(size_type len);
+  void remap(size_type new_cap);
+  void grow(size_type add_size);
+};
+
+/*****************************************************************************************/
+
+// 打开文件并映射；文件为空或以 create 方式打开时写入新的文件头
+template <class T, class Growth>
+void mmap_vector<T, Growth>::open(const char* path, mmap_mode mode)
+{
+  close();
+  const bool writable = mode != mmap_mode::read_only;
+  int flags = writable ? O_RDWR | O_CREAT : O_RDONLY;
+  if (mode == mmap_mode::create)
+    flags |= O_TRUNC;
+  fd_ = ::open(path, flags | O_CLOEXEC, 0644);
+  THROW_RUNTIME_ERROR_IF(fd_ < 0, "mmap_vector<T> cannot open the file");
+  writable_ = writable;
+  try
+  {
+    struct stat st;
+    THROW_RUNTIME_ERROR_IF(::fstat(fd_, &st) != 0, "mmap_vector<T> cannot stat the file");
+    size_type len = static_cast<size_type>(st.st_size);
+    if (len == 0 && writable)
+    { // 新文件，先留出一页
+      len = mmap_detail::round_to_page(mmap_detail::header_size + sizeof(T));
+      THROW_RUNTIME_ERROR_IF(::ftruncate(fd_, static_cast<off_t>(len)) != 0,
+                             "mmap_vector<T> cannot resize the file");
+      map_file(len);
+      hdr_->magic = mmap_detail::magic;
+      hdr_->elem_size = sizeof(T);
+      hdr_->size = 0;
+      return;
+    }
+    THROW_RUNTIME_ERROR_IF(len < mmap_detail::header_size, "mmap_vector<T> file is too short");
+    map_file(len);
+    THROW_RUNTIME_ERROR_IF(hdr_->magic != mmap_detail::magic, "mmap_vector<T> file has a bad magic");
+    THROW_RUNTIME_ERROR_IF(hdr_->elem_size != sizeof(T), "mmap_vector<T> element size mismatch");
+    THROW_RUNTIME_ERROR_IF(hdr_->size > (len - mmap_detail::header_size) / sizeof(T),
+                           "mmap_vector<T> file is truncated");
+  }
+  catch (...)
+  {
+    close();
+    throw;
+  }
+}
+
+// 解除映射并关闭文件，修改过的页由内核写回
+template <class T, class Growth>
+void mmap_vector<T, Growth>::close() noexcept
+{
+  if (hdr_)
+    ::munmap(hdr_, map_len_);
+  if (fd_ >= 0)
+    ::close(fd_);
+  fd_ = -1;
+  hdr_ = nullptr;
+  map_len_ = 0;
+  writable_ = false;
+}
+
+template <class T, class Growth>
+void mmap_vector<T, Growth>::flush(bool async)
+{
+  if (!hdr_ || !writable_)
+    return;
+  THROW_RUNTIME_ERROR_IF(::msync(hdr_, map_len_, async ? MS_ASYNC : MS_SYNC) != 0,
+                         "mmap_vector<T> cannot sync the file");
+}
+
+// 预留空间
+template <class T, class Growth>
+void mmap_vector<T, Growth>::reserve(size_type n)
+{
+  check_writable();
+  if (capacity() < n)
+  {
+    THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in reserve(n)");
+    remap(n);
+  }
+}
+
+// 把文件截短到刚好容纳现有元素
+template <class T, class Growth>
+void mmap_vector<T, Growth>::shrink_to_fit()
+{
+  check_writable();
+  if (hdr_ && mmap_detail::round_to_page(mmap_detail::header_size + size() * sizeof(T)) < map_len_)
+    remap(size());
+}
+
+template <class T, class Growth>
+void mmap_vector<T, Growth>::append(const value_type* first, size_type n)
+{
+  check_writable();
+  const size_type old_size = size();
+  if (n > capacity() - old_size)
+    grow(n);
+  std::memcpy(data() + old_size, first, n * sizeof(T));
+  hdr_->size = old_size + n;
+}
+
+// 在 pos 处插入 n 个 value
+template <class T, class Growth>
+typename mmap_vector<T, Growth>::iterator
+mmap_vector<T, Growth>::insert(const_iterator pos, size_type n, const value_type& value)
+{
+  MYSTL_DEBUG(pos >= begin() && pos <= end());
+  check_writable();
+  const size_type off = pos - begin();
+  const size_type old_size = size();
+  const value_type tmp = value;  // value 可能是本容器中的元素，增长后会失效
+  if (n > capacity() - old_size)
+    grow(n);
+  auto p = data() + off;
+  std::memmove(p + n, p, (old_size - off) * sizeof(T));
+  mystl::fill_n(p, n, tmp);
+  hdr_->size = old_size + n;
+  return p;
+}
+
+// 在 pos 处插入 [first, last)，区间不能来自本容器
+template <class T, class Growth>
+typename mmap_vector<T, Growth>::iterator
+mmap_vector<T, Growth>::insert(const_iterator pos, const value_type* first, const value_type* last)
+{
+  MYSTL_DEBUG(pos >= begin() && pos <= end() && !(last < first));
+  check_writable();
+  const size_type off = pos - begin();
+  const size_type n = static_cast<size_type>(last - first);
+  const size_type old_size = size();
+  if (n > capacity() - old_size)
+    grow(n);
+  auto p = data() + off;
+  std::memmove(p + n, p, (old_size - off) * sizeof(T));
+  std::memcpy(p, first, n * sizeof(T));
+  hdr_->size = old_size + n;
+  return p;
+}
+
+// 删除 [first, last) 上的元素
+template <class T, class Growth>
+typename mmap_vector<T, Growth>::iterator
+mmap_vector<T, Growth>::erase(const_iterator first, const_iterator last)
+{
+  MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+  check_writable();
+  const auto off = first - begin();
+  auto p = data() + off;
+  std::memmove(p, last, (cend() - last) * sizeof(T));
+  hdr_->size -= static_cast<size_type>(last - first);
+  return p;
+}
+
+// 重置容器大小
+template <class T, class Growth>
+void mmap_vector<T, Growth>::resize(size_type new_size, const value_type& value)
+{
+  check_writable();
+  const size_type old_size = size();
+  if (new_size > old_size)
+  {
+    insert(cend(), new_size - old_size, value);
+  }
+  else if (hdr_)
+  {
+    hdr_->size = new_size;
+  }
+}
+
+/*****************************************************************************************/
+// helper function
+
+template <class T, class Growth>
+void mmap_vector<T, Growth>::map_file(size_type len)
+{
+  const int prot = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+  void* p = ::mmap(nullptr, len, prot, MAP_SHARED, fd_, 0);
+  THROW_RUNTIME_ERROR_IF(p == MAP_FAILED, "mmap_vector<T> cannot map the file");
+  hdr_ = static_cast<mmap_detail::header*>(p);
+  map_len_ = len;
+}
+
+// 把文件长度改为能容纳 new_cap 个元素，再重新映射；Linux 下用 mremap 扩大原映射
+template <class T, class Growth>
+void mmap_vector<T, Growth>::remap(size_type new_cap)
+{
+  THROW_RUNTIME_ERROR_IF(!hdr_, "mmap_vector<T> is not open");
+  const size_type len = mmap_detail::round_to_page(mmap_detail::header_size + new_cap * sizeof(T));
+  const size_type old_len = map_len_;
+  if (len == old_len)
+    return;
+  if (len > old_len)
+  { // 先加长文件，失败时原映射不变
+    THROW_RUNTIME_ERROR_IF(::ftruncate(fd_, static_cast<off_t>(len)) != 0,
+                           "mmap_vector<T> cannot resize the file");
+  }
+#if defined(REDBUD_LINUX) && defined(MREMAP_MAYMOVE)
+  void* p = ::mremap(hdr_, old_len, len, MREMAP_MAYMOVE);
+  THROW_RUNTIME_ERROR_IF(p == MAP_FAILED, "mmap_vector<T> cannot remap the file");
+  hdr_ = static_cast<mmap_detail::header*>(p);
+  map_len_ = len;
+#else
+  ::munmap(hdr_, old_len);
+  hdr_ = nullptr;
+  map_file(len);
+#endif
+  if (len < old_len)  // 缩小时先改小映射，再截短文件
+    (void)::ftruncate(fd_, static_cast<off_t>(len));
+}
+
+template <class T, class Growth>
+void mmap_vector<T, Growth>::grow(size_type add_size)
+{
+  check_writable();
+  THROW_LENGTH_ERROR_IF(size() > max_size() - add_size, "mmap_vector<T>'s size too big");
+  remap(Growth::new_capacity(capacity(), size() + add_size, sizeof(T), max_size()));
+}
+
+// 重载比较操作符
+
+template <class T, class Growth>
+bool operator==(const mmap_vector<T, Growth>& lhs, const mmap_vector<T, Growth>& rhs)
+{
+  return lhs.size() == rhs.size() &&
+    mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Growth>
+bool operator!=(const mmap_vector<T, Growth>& lhs, const mmap_vector<T, Growth>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T, class Growth>
+void swap(mmap_vector<T, Growth>& lhs, mmap_vector<T, Growth>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYSTL_MMAP_VECTOR_H
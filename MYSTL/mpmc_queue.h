@@ -0,0 +1,429 @@
+#ifndef MYSTL_MPMC_QUEUE_H
+#define MYSTL_MPMC_QUEUE_H
+
+// 这个头文件包含一个模板类 mpmc_queue
+// mpmc_queue : 多生产者多消费者的有界无锁队列（Vyukov 的数组队列）
+// 每个槽位带一个序号 seq：seq == pos 表示可写入第 pos 个元素，seq == pos + 1 表示第 pos 个元素可读出，
+// 读出后置为 pos + capacity 留给下一圈的写入者。生产者之间、消费者之间各自只在一个下标上 CAS，
+// 两者互不争用，槽位的序号也只被一个生产者和一个消费者先后写入
+// 提供 try / 阻塞 / 限时三种入队出队方式，以及一次取出多个元素的 try_pop_n / pop_n
+// 模板参数 Wait 为 true 时才提供阻塞和限时的版本，每次入队出队后通知等待的一方；
+// 为 false 时 try 系列不做任何通知
+
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+
+#include "allocator.h"
+#include "algobase.h"
+#include "construct.h"
+#include "concurrency.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类: mpmc_queue
+// 模板参数 T 代表类型，Wait 表示是否支持阻塞等待，Alloc 代表空间配置器，缺省使用 mystl::allocator
+// 元素一旦占到槽位就必须完成写入，所以要求 T 的移动构造和移动赋值不抛出异常
+template <class T, bool Wait = false, class Alloc = mystl::allocator<T>>
+class mpmc_queue
+{
+  static_assert(std::is_nothrow_move_constructible<T>::value &&
+                std::is_nothrow_move_assignable<T>::value,
+                "mpmc_queue requires nothrow move construction and assignment");
+public:
+  // mpmc_queue 的嵌套型别定义
+  typedef Alloc                                    allocator_type;
+
+  typedef T                                        value_type;
+  typedef T*                                       pointer;
+  typedef T&                                       reference;
+  typedef const T&                                 const_reference;
+  typedef size_t                                   size_type;
+
+private:
+  struct slot
+  {
+    std::atomic<size_type> seq;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    pointer value() noexcept { return reinterpret_cast<pointer>(&storage); }
+  };
+
+  typedef typename Alloc::template rebind<slot>::other slot_allocator;
+
+  alignas(cache_line_size) std::atomic<size_type> enqueue_pos_;  // 生产者争用
+  alignas(cache_line_size) std::atomic<size_type> dequeue_pos_;  // 消费者争用
+  alignas(cache_line_size) slot* slots_;
+  size_type      cap_;   // 容量，2 的幂，至少为 2
+  slot_allocator slot_alloc_;
+
+  event_count    not_empty_;  // 消费者在此等待
+  event_count    not_full_;   // 生产者在此等待
+
+public:
+  // 容量向上取整到 2 的幂
+  explicit mpmc_queue(size_type capacity, const allocator_type& alloc = allocator_type())
+    :enqueue_pos_(0), dequeue_pos_(0), slots_(nullptr), cap_(2), slot_alloc_(alloc)
+  {
+    THROW_LENGTH_ERROR_IF(capacity > (static_cast<size_type>(-1) >> 1) / sizeof(slot) + 1,
+                          "mpmc_queue<T>'s capacity too big");
+    while (cap_ < capacity)
+      cap_ <<= 1;
+    slots_ = slot_alloc_.allocate(cap_);
+    for (size_type i = 0; i < cap_; ++i)
+      mystl::construct(&slots_[i].seq, i);
+  }
+
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+  // 析构时不能有线程仍在使用队列
+  ~mpmc_queue()
+  {
+    const size_type last = enqueue_pos_.load(std::memory_order_relaxed);
+    for (size_type p = dequeue_pos_.load(std::memory_order_relaxed); p != last; ++p)
+      mystl::destroy(slots_[p & (cap_ - 1)].value());
+    slot_alloc_.deallocate(slots_, cap_);
+  }
+
+public:
+  // 容量相关操作，并发修改时 size 和 empty 只是近似值
+  size_type capacity() const noexcept { return cap_; }
+  size_type size() const noexcept
+  {
+    const size_type head = dequeue_pos_.load(std::memory_order_acquire);
+    const size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? mystl::min(tail - head, cap_) : 0;
+  }
+  bool      empty() const noexcept { return size() == 0; }
+
+  // 入队 ----------------------------------------------------------------------
+
+  // 队列已满时返回 false
+  // 构造可能抛出异常时要先在槽位外构造好再移入，此时返回 false 说明该临时对象已被丢弃，
+  // 以右值传入的参数可能已被移走；需要保证不丢失元素时使用阻塞的 emplace 或 try_push_for
+  template <class ...Args>
+  bool try_emplace(Args&& ...args)
+  {
+    return try_emplace_aux(std::integral_constant<bool,
+      std::is_nothrow_constructible<T, Args...>::value>(), mystl::forward<Args>(args)...);
+  }
+
+  bool try_push(const value_type& value) { return try_emplace(value); }
+  bool try_push(value_type&& value)      { return try_emplace(mystl::move(value)); }
+
+  // 队列满时等待，只能在 Wait 为 true 时使用
+  template <class ...Args>
+  void emplace(Args&& ...args)
+  {
+    static_assert(Wait, "mpmc_queue<T, false> does not support blocking operations");
+    emplace_aux(std::integral_constant<bool,
+      std::is_nothrow_constructible<T, Args...>::value>(), mystl::forward<Args>(args)...);
+  }
+
+  void push(const value_type& value) { emplace(value); }
+  void push(value_type&& value)      { emplace(mystl::move(value)); }
+
+  // 最多等待 rel_time，超时返回 false，只能在 Wait 为 true 时使用
+  // 构造可能抛出异常时先构造一个临时对象，超时后该对象被丢弃
+  template <class U, class Rep, class Period>
+  bool try_push_for(U&& value, const std::chrono::duration<Rep, Period>& rel_time)
+  {
+    static_assert(Wait, "mpmc_queue<T, false> does not support blocking operations");
+    return push_for_aux(std::integral_constant<bool,
+      std::is_nothrow_constructible<T, U&&>::value>(), mystl::forward<U>(value),
+      std::chrono::steady_clock::now() + rel_time);
+  }
+
+  // 出队 ----------------------------------------------------------------------
+
+  // 队列为空时返回 false
+  bool try_pop(value_type& value)
+  {
+    size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+    slot* s;
+    while (true)
+    {
+      s = &slots_[pos & (cap_ - 1)];
+      const size_type seq = s->seq.load(std::memory_order_acquire);
+      const ptrdiff_t dif = static_cast<ptrdiff_t>(seq - (pos + 1));
+      if (dif == 0)
+      {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (dif < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    value = mystl::move(*s->value());
+    mystl::destroy(s->value());
+    s->seq.store(pos + cap_, std::memory_order_release);
+    if (Wait)
+      not_full_.notify_all();
+    return true;
+  }
+
+  // 队列为空时等待，只能在 Wait 为 true 时使用
+  void pop(value_type& value)
+  {
+    static_assert(Wait, "mpmc_queue<T, false> does not support blocking operations");
+    for (backoff bo; !try_pop(value); )
+    {
+      if (bo.pause())
+        continue;
+      const uint32_t key = not_empty_.prepare_wait();
+      if (!looks_empty())
+      {
+        not_empty_.cancel_wait();
+        continue;
+      }
+      not_empty_.commit_wait(key);
+    }
+  }
+
+  // 最多等待 rel_time，超时返回 false，只能在 Wait 为 true 时使用
+  template <class Rep, class Period>
+  bool try_pop_for(value_type& value, const std::chrono::duration<Rep, Period>& rel_time)
+  {
+    static_assert(Wait, "mpmc_queue<T, false> does not support blocking operations");
+    const auto deadline = std::chrono::steady_clock::now() + rel_time;
+    for (backoff bo; !try_pop(value); )
+    {
+      if (bo.pause())
+        continue;
+      const uint32_t key = not_empty_.prepare_wait();
+      if (!looks_empty())
+      {
+        not_empty_.cancel_wait();
+        continue;
+      }
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline)
+      {
+        not_empty_.cancel_wait();
+        return try_pop(value);
+      }
+      not_empty_.commit_wait_for(key, deadline - now);
+    }
+    return true;
+  }
+
+  // 一次取出至多 n 个连续可读的元素移动到 result，返回取出的个数，只做一次 CAS
+  // 写入 result 时抛出异常，已占下但尚未取出的元素被丢弃，槽位照常交还
+  template <class OutputIter>
+  size_type try_pop_n(OutputIter result, size_type n);
+
+  // 等到至少有一个元素，再取出至多 n 个，只能在 Wait 为 true 时使用
+  template <class OutputIter>
+  size_type pop_n(OutputIter result, size_type n)
+  {
+    static_assert(Wait, "mpmc_queue<T, false> does not support blocking operations");
+    if (n == 0)
+      return 0;
+    for (backoff bo; ; )
+    {
+      const size_type got = try_pop_n(result, n);
+      if (got != 0)
+        return got;
+      if (bo.pause())
+        continue;
+      const uint32_t key = not_empty_.prepare_wait();
+      if (!looks_empty())
+      {
+        not_empty_.cancel_wait();
+        continue;
+      }
+      not_empty_.commit_wait(key);
+    }
+  }
+
+private:
+  // 构造不会抛出异常，占到槽位后直接原地构造；没占到槽位时不会使用参数
+  template <class ...Args>
+  bool try_emplace_aux(std::true_type, Args&& ...args)
+  {
+    size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+    slot* s;
+    while (true)
+    {
+      s = &slots_[pos & (cap_ - 1)];
+      const size_type seq = s->seq.load(std::memory_order_acquire);
+      const ptrdiff_t dif = static_cast<ptrdiff_t>(seq - pos);
+      if (dif == 0)
+      {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (dif < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    mystl::construct(s->value(), mystl::forward<Args>(args)...);
+    s->seq.store(pos + 1, std::memory_order_release);
+    if (Wait)
+      not_empty_.notify_all();
+    return true;
+  }
+
+  // 构造可能抛出异常，先在槽位外构造好，再移动进去
+  template <class ...Args>
+  bool try_emplace_aux(std::false_type, Args&& ...args)
+  {
+    if (looks_full())
+      return false;
+    value_type tmp(mystl::forward<Args>(args)...);
+    return try_emplace_aux(std::true_type(), mystl::move(tmp));
+  }
+
+  // 没占到槽位时参数原样保留，可以反复转发
+  template <class ...Args>
+  void emplace_aux(std::true_type, Args&& ...args)
+  {
+    for (backoff bo; !try_emplace_aux(std::true_type(), mystl::forward<Args>(args)...); )
+    {
+      if (bo.pause())
+        continue;
+      const uint32_t key = not_full_.prepare_wait();
+      if (!looks_full())
+      {
+        not_full_.cancel_wait();
+        continue;
+      }
+      not_full_.commit_wait(key);
+    }
+  }
+
+  // 只构造一次临时对象，之后反复尝试移入
+  template <class ...Args>
+  void emplace_aux(std::false_type, Args&& ...args)
+  {
+    value_type tmp(mystl::forward<Args>(args)...);
+    emplace_aux(std::true_type(), mystl::move(tmp));
+  }
+
+  template <class U, class TimePoint>
+  bool push_for_aux(std::true_type, U&& value, const TimePoint& deadline)
+  {
+    for (backoff bo; !try_emplace_aux(std::true_type(), mystl::forward<U>(value)); )
+    {
+      if (bo.pause())
+        continue;
+      const uint32_t key = not_full_.prepare_wait();
+      if (!looks_full())
+      {
+        not_full_.cancel_wait();
+        continue;
+      }
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline)
+      {
+        not_full_.cancel_wait();
+        return try_emplace_aux(std::true_type(), mystl::forward<U>(value));
+      }
+      not_full_.commit_wait_for(key, deadline - now);
+    }
+    return true;
+  }
+
+  template <class U, class TimePoint>
+  bool push_for_aux(std::false_type, U&& value, const TimePoint& deadline)
+  {
+    value_type tmp(mystl::forward<U>(value));
+    return push_for_aux(std::true_type(), mystl::move(tmp), deadline);
+  }
+
+  bool looks_full() const noexcept
+  {
+    const size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+    const size_type seq = slots_[pos & (cap_ - 1)].seq.load(std::memory_order_acquire);
+    return static_cast<ptrdiff_t>(seq - pos) < 0;
+  }
+
+  bool looks_empty() const noexcept
+  {
+    const size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+    const size_type seq = slots_[pos & (cap_ - 1)].seq.load(std::memory_order_acquire);
+    return static_cast<ptrdiff_t>(seq - (pos + 1)) < 0;
+  }
+};
+
+/*****************************************************************************************/
+
+// 从 dequeue_pos 开始数出连续可读的槽位，用一次 CAS 全部占下
+// 占下之后这些槽位不会再被其它消费者看到，生产者也要等它们的 seq 更新后才能写入
+template <class T, bool Wait, class Alloc>
+template <class OutputIter>
+typename mpmc_queue<T, Wait, Alloc>::size_type
+mpmc_queue<T, Wait, Alloc>::try_pop_n(OutputIter result, size_type n)
+{
+  if (n == 0)
+    return 0;
+  size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+  size_type count;
+  while (true)
+  {
+    count = 0;
+    while (count < n && count < cap_)
+    {
+      const size_type p = pos + count;
+      const size_type seq = slots_[p & (cap_ - 1)].seq.load(std::memory_order_acquire);
+      if (seq != p + 1)
+        break;
+      ++count;
+    }
+    if (count == 0)
+    {
+      const size_type seq = slots_[pos & (cap_ - 1)].seq.load(std::memory_order_acquire);
+      if (static_cast<ptrdiff_t>(seq - (pos + 1)) < 0)
+        return 0;
+      pos = dequeue_pos_.load(std::memory_order_relaxed);  // 下标已过时
+      continue;
+    }
+    if (dequeue_pos_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+      break;
+  }
+  size_type i = 0;
+  try
+  {
+    for (; i < count; ++i)
+    {
+      slot& s = slots_[(pos + i) & (cap_ - 1)];
+      *result = mystl::move(*s.value());
+      ++result;
+      mystl::destroy(s.value());
+      s.seq.store(pos + i + cap_, std::memory_order_release);
+    }
+  }
+  catch (...)
+  { // 占下的槽位必须全部交还，否则生产者绕回来时会永远等待；未取出的元素被丢弃
+    for (; i < count; ++i)
+    {
+      slot& s = slots_[(pos + i) & (cap_ - 1)];
+      mystl::destroy(s.value());
+      s.seq.store(pos + i + cap_, std::memory_order_release);
+    }
+    if (Wait)
+      not_full_.notify_all();
+    throw;
+  }
+  if (Wait)
+    not_full_.notify_all();
+  return count;
+}
+
+} // namespace mystl
+#endif // !MYSTL_MPMC_QUEUE_H
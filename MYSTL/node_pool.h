@@ -0,0 +1,287 @@
+#ifndef MYSTL_NODE_POOL_H
+#define MYSTL_NODE_POOL_H
+
+// 这个头文件包含一个定长内存池 node_pool，以及建立在它之上的空间配置器 pool_allocator
+// list / rb_tree / hashtable 的节点大小固定且逐个申请，从大块内存中切分可以省掉逐个 operator new 的开销，
+// 也能让节点在内存中更紧凑
+
+#include <new>
+#include <cstddef>
+#include <atomic>
+
+#include "construct.h"
+#include "concurrency.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// 类 node_pool
+// 每次向系统申请一整块 chunk，从中依次切出 block_size 大小的块，释放的块挂在空闲链表上复用
+// node_pool 本身不加锁，也不会把单个块还给系统，只在 release 或析构时整体归还 chunk
+class node_pool
+{
+private:
+  struct free_block { free_block* next; };
+  struct chunk      { chunk* next; };
+
+public:
+  static const size_t default_chunk_bytes = 64 * 1024;
+
+  explicit node_pool(size_t block_size, size_t chunk_bytes = default_chunk_bytes) noexcept
+    :block_size_(round_block(block_size)),
+     blocks_per_chunk_(chunk_bytes / block_size_ < 16 ? 16 : chunk_bytes / block_size_),
+     free_(nullptr), cur_(nullptr), end_(nullptr), chunks_(nullptr)
+  {
+  }
+
+  node_pool(const node_pool&) = delete;
+  node_pool& operator=(const node_pool&) = delete;
+
+  ~node_pool() { release(); }
+
+public:
+  size_t block_size() const noexcept { return block_size_; }
+
+  // 优先复用空闲链表，其次从当前 chunk 中切分，都没有时再申请新的 chunk
+  void* allocate()
+  {
+    if (free_ != nullptr)
+    {
+      free_block* p = free_;
+      free_ = p->next;
+      return p;
+    }
+    if (cur_ == end_)
+      new_chunk();
+    void* p = cur_;
+    cur_ += block_size_;
+    return p;
+  }
+
+  void deallocate(void* p) noexcept
+  {
+    if (p == nullptr)
+      return;
+    free_block* b = static_cast<free_block*>(p);
+    b->next = free_;
+    free_ = b;
+  }
+
+  // 归还所有 chunk，之前分配出去的块全部失效
+  void release() noexcept
+  {
+    while (chunks_ != nullptr)
+    {
+      chunk* next = chunks_->next;
+      ::operator delete(chunks_);
+      chunks_ = next;
+    }
+    free_ = nullptr;
+    cur_ = end_ = nullptr;
+  }
+
+private:
+  // 块的大小至少能放下一个指针，并按 max_align_t 以内的对齐要求取整
+  static size_t round_block(size_t n) noexcept
+  {
+    const size_t align = sizeof(void*);
+    n = n < align ? align : n;
+    return (n + align - 1) & ~(align - 1);
+  }
+
+  // chunk 头部占用的空间，保证第一个块按 max_align_t 对齐
+  static size_t header_size() noexcept
+  {
+    const size_t align = alignof(std::max_align_t);
+    return (sizeof(chunk) + align - 1) & ~(align - 1);
+  }
+
+  void new_chunk()
+  {
+    const size_t bytes = header_size() + block_size_ * blocks_per_chunk_;
+    chunk* c = static_cast<chunk*>(::operator new(bytes));
+    c->next = chunks_;
+    chunks_ = c;
+    cur_ = reinterpret_cast<char*>(c) + header_size();
+    end_ = cur_ + block_size_ * blocks_per_chunk_;
+  }
+
+private:
+  size_t      block_size_;        // 每个块的大小
+  size_t      blocks_per_chunk_;  // 每个 chunk 切出的块数
+  free_block* free_;              // 空闲链表
+  char*       cur_;               // 当前 chunk 中尚未切分部分的起始位置
+  char*       end_;               // 当前 chunk 的末尾
+  chunk*      chunks_;            // 所有 chunk 串成的链表
+};
+
+// 类 spin_lock
+// 保护共享 node_pool 的自旋锁，临界区只有几条指令，用不着 mutex
+// 抢锁失败后只读等待，不反复写同一条 cache line；等待时退避，持有者被换出时让出时间片
+class spin_lock
+{
+public:
+  spin_lock() noexcept : locked_(false) {}
+  spin_lock(const spin_lock&) = delete;
+  spin_lock& operator=(const spin_lock&) = delete;
+
+  void lock() noexcept
+  {
+    for (backoff bo; ; )
+    {
+      if (!locked_.exchange(true, std::memory_order_acquire))
+        return;
+      while (locked_.load(std::memory_order_relaxed))
+      {
+        if (!bo.pause())
+          std::this_thread::yield();
+      }
+    }
+  }
+  void unlock() noexcept { locked_.store(false, std::memory_order_release); }
+
+private:
+  std::atomic<bool> locked_;
+};
+
+// 模板类 shared_node_pool
+// 同一个块大小的所有 pool_allocator 共用一个全局的 node_pool
+// 池对象有意不析构：静态存储期的容器可能比它晚析构，仍然需要归还节点
+template <size_t BlockSize>
+struct shared_node_pool
+{
+  static node_pool& pool()
+  {
+    static node_pool* p = new node_pool(BlockSize);
+    return *p;
+  }
+  static spin_lock& lock()
+  {
+    static spin_lock* l = new spin_lock;
+    return *l;
+  }
+
+  static void* allocate()
+  {
+    node_pool& p = pool();
+    spin_lock& l = lock();
+    l.lock();
+    void* r = nullptr;
+    try
+    {
+      r = p.allocate();
+    }
+    catch (...)
+    {
+      l.unlock();
+      throw;
+    }
+    l.unlock();
+    return r;
+  }
+
+  static void deallocate(void* ptr) noexcept
+  {
+    spin_lock& l = lock();
+    l.lock();
+    pool().deallocate(ptr);
+    l.unlock();
+  }
+};
+
+// 模板类 pool_allocator
+// 一次只申请一个对象时（list / rb_tree / hashtable 的节点）从共享的 node_pool 中取块，
+// 其余情况（vector、hashtable 的 bucket 数组等）退回到 operator new
+// 使用方式：mystl::map<K, V, mystl::less<K>, mystl::pool_allocator<mystl::pair<const K, V>>>
+template <class T>
+class pool_allocator
+{
+public:
+  typedef T            value_type;
+  typedef T*           pointer;
+  typedef const T*     const_pointer;
+  typedef T&           reference;
+  typedef const T&     const_reference;
+  typedef size_t       size_type;
+  typedef ptrdiff_t    difference_type;
+
+  template <class U>
+  struct rebind
+  {
+    typedef pool_allocator<U> other;
+  };
+
+private:
+  static const size_t block_align = alignof(T) > sizeof(void*) ? alignof(T) : sizeof(void*);
+  static const size_t block_bytes = (sizeof(T) + block_align - 1) & ~(block_align - 1);
+  // 对齐要求超过 max_align_t 的类型 node_pool 保证不了，直接走 operator new
+  static const bool   use_pool = alignof(T) <= alignof(std::max_align_t);
+
+  typedef shared_node_pool<block_bytes> pool_type;
+
+public:
+  pool_allocator() noexcept = default;
+  template <class U>
+  pool_allocator(const pool_allocator<U>&) noexcept {}
+
+  static T* allocate()
+  {
+    return use_pool ? static_cast<T*>(pool_type::allocate())
+                    : static_cast<T*>(::operator new(sizeof(T)));
+  }
+
+  static T* allocate(size_type n)
+  {
+    if (n == 0)
+      return nullptr;
+    if (n == 1)
+      return allocate();
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  static void deallocate(T* ptr)
+  {
+    if (ptr == nullptr)
+      return;
+    if (use_pool)
+      pool_type::deallocate(ptr);
+    else
+      ::operator delete(ptr);
+  }
+
+  static void deallocate(T* ptr, size_type n)
+  {
+    if (ptr == nullptr)
+      return;
+    if (n == 1)
+      deallocate(ptr);
+    else
+      ::operator delete(ptr);
+  }
+
+  template <class... Args>
+  static void construct(T* ptr, Args&& ...args)
+  {
+    mystl::construct(ptr, mystl::forward<Args>(args)...);
+  }
+
+  static void destroy(T* ptr)           { mystl::destroy(ptr); }
+  static void destroy(T* first, T* last) { mystl::destroy(first, last); }
+};
+
+// 所有 pool_allocator 共用同一组全局池，可以互相释放对方分配的内存
+template <class T, class U>
+bool operator==(const pool_allocator<T>&, const pool_allocator<U>&) noexcept
+{
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const pool_allocator<T>&, const pool_allocator<U>&) noexcept
+{
+  return false;
+}
+
+} // namespace mystl
+#endif // !MYSTL_NODE_POOL_H
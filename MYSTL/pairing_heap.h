@@ -0,0 +1,459 @@
+#ifndef MYSTL_PAIRING_HEAP_H
+#define MYSTL_PAIRING_HEAP_H
+
+// 这个头文件包含一个模板类 pairing_heap
+// pairing_heap : 配对堆，可寻址的优先队列，push 返回的句柄在元素被 pop / erase 之前一直有效
+// 每个节点用 child / next / prev 三个指针表示一棵多叉树：child 指向第一个子节点，next 指向右兄弟，
+// prev 指向左兄弟，第一个子节点的 prev 指向父节点
+// push、merge、提高优先级的 decrease_key 均摊 O(1)；pop、erase 以及降低优先级的 update 均摊 O(log n)
+// 节点逐个分配，缺省从 pool_allocator 的共享内存池中取
+
+#include <initializer_list>
+
+#include "node_pool.h"
+#include "functional.h"
+#include "vector.h"
+#include "construct.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+template <class T>
+struct pairing_heap_node
+{
+  T                     value;
+  pairing_heap_node*    child;
+  pairing_heap_node*    next;
+  pairing_heap_node*    prev;
+
+  template <class ...Args>
+  pairing_heap_node(Args&& ...args)
+    :value(mystl::forward<Args>(args)...), child(nullptr), next(nullptr), prev(nullptr)
+  {
+  }
+};
+
+// 模板类: pairing_heap
+// 参数一代表数据类型，参数二代表比较权值的方式，缺省使用 mystl::less，此时堆顶为最大的元素，
+// 参数三代表空间配置器，缺省使用 mystl::pool_allocator
+// 最短路等需要最小堆的场合使用 mystl::greater，距离变小时调用 decrease_key
+template <class T, class Compare = mystl::less<T>, class Alloc = mystl::pool_allocator<T>>
+class pairing_heap
+{
+public:
+  // pairing_heap 的嵌套型别定义
+  typedef Alloc                                    allocator_type;
+  typedef Compare                                  value_compare;
+
+  typedef T                                        value_type;
+  typedef T*                                       pointer;
+  typedef const T*                                 const_pointer;
+  typedef T&                                       reference;
+  typedef const T&                                 const_reference;
+  typedef size_t                                   size_type;
+
+private:
+  typedef pairing_heap_node<T>                                node_type;
+  typedef node_type*                                          node_ptr;
+  typedef typename Alloc::template rebind<node_type>::other   node_allocator;
+
+public:
+  // 元素的句柄，只能读取元素；修改元素要通过 decrease_key / update
+  class handle
+  {
+    friend class pairing_heap;
+    node_ptr node_;
+    explicit handle(node_ptr n) noexcept :node_(n) {}
+  public:
+    handle() noexcept :node_(nullptr) {}
+
+    const_reference operator*()  const noexcept { return node_->value; }
+    const_pointer   operator->() const noexcept { return &node_->value; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+    friend bool operator==(const handle& lhs, const handle& rhs) noexcept
+    { return lhs.node_ == rhs.node_; }
+    friend bool operator!=(const handle& lhs, const handle& rhs) noexcept
+    { return lhs.node_ != rhs.node_; }
+  };
+
+private:
+  node_ptr       root_;
+  size_type      size_;
+  value_compare  comp_;
+  node_allocator alloc_;
+
+public:
+  // 构造、复制、移动、析构函数
+  pairing_heap() noexcept(std::is_nothrow_default_constructible<Compare>::value)
+    :root_(nullptr), size_(0), comp_()
+  {
+  }
+
+  explicit pairing_heap(const Compare& comp)
+    :root_(nullptr), size_(0), comp_(comp)
+  {
+  }
+
+  template <class IIter>
+  pairing_heap(IIter first, IIter last, const Compare& comp = Compare())
+    :root_(nullptr), size_(0), comp_(comp)
+  {
+    try
+    {
+      for (; first != last; ++first)
+        push(*first);
+    }
+    catch (...)
+    {
+      clear();
+      throw;
+    }
+  }
+
+  pairing_heap(std::initializer_list<T> ilist, const Compare& comp = Compare())
+    :pairing_heap(ilist.begin(), ilist.end(), comp)
+  {
+  }
+
+  // 复制得到的是一个新的堆，原来的句柄不能用于副本
+  pairing_heap(const pairing_heap& rhs)
+    :root_(nullptr), size_(0), comp_(rhs.comp_), alloc_(rhs.alloc_)
+  {
+    try
+    {
+      copy_from(rhs);
+    }
+    catch (...)
+    {
+      clear();
+      throw;
+    }
+  }
+
+  // 移动后句柄仍指向原来的元素，属于新的堆
+  pairing_heap(pairing_heap&& rhs) noexcept
+    :root_(rhs.root_), size_(rhs.size_), comp_(rhs.comp_), alloc_(rhs.alloc_)
+  {
+    rhs.root_ = nullptr;
+    rhs.size_ = 0;
+  }
+
+  pairing_heap& operator=(const pairing_heap& rhs)
+  {
+    if (this != &rhs)
+    {
+      pairing_heap tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+  pairing_heap& operator=(pairing_heap&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+  pairing_heap& operator=(std::initializer_list<T> ilist)
+  {
+    pairing_heap tmp(ilist, comp_);
+    swap(tmp);
+    return *this;
+  }
+
+  ~pairing_heap() { clear(); }
+
+public:
+  // 访问元素相关操作
+  const_reference top() const
+  {
+    MYSTL_DEBUG(root_ != nullptr);
+    return root_->value;
+  }
+  handle          top_handle() const noexcept { return handle(root_); }
+
+  // 容量相关操作
+  bool      empty() const noexcept { return root_ == nullptr; }
+  size_type size()  const noexcept { return size_; }
+
+  value_compare value_comp() const { return comp_; }
+
+  // 修改容器相关操作
+
+  template <class ...Args>
+  handle emplace(Args&& ...args)
+  {
+    node_ptr n = create_node(mystl::forward<Args>(args)...);
+    root_ = meld(root_, n);
+    ++size_;
+    return handle(n);
+  }
+
+  handle push(const value_type& value)  { return emplace(value); }
+  handle push(value_type&& value)       { return emplace(mystl::move(value)); }
+
+  void pop()
+  {
+    MYSTL_DEBUG(root_ != nullptr);
+    node_ptr old = root_;
+    root_ = merge_pairs(old->child);
+    destroy_node(old);
+    --size_;
+  }
+
+  // 取出堆顶元素，省去 top 之后的一次复制
+  value_type pop_top()
+  {
+    MYSTL_DEBUG(root_ != nullptr);
+    value_type value = mystl::move(root_->value);
+    pop();
+    return value;
+  }
+
+  // value 的优先级不能低于 h 原来的值（最小堆中即键值变小）
+  void decrease_key(handle h, const value_type& value)
+  {
+    MYSTL_DEBUG(!comp_(value, h.node_->value));
+    h.node_->value = value;
+    promote(h.node_);
+  }
+  void decrease_key(handle h, value_type&& value)
+  {
+    MYSTL_DEBUG(!comp_(value, h.node_->value));
+    h.node_->value = mystl::move(value);
+    promote(h.node_);
+  }
+
+  // 任意修改 h 的值，优先级降低时相当于 erase 后重新 push，但保留节点和句柄
+  void update(handle h, const value_type& value)
+  {
+    const bool lower = comp_(value, h.node_->value);
+    h.node_->value = value;
+    lower ? demote(h.node_) : promote(h.node_);
+  }
+  void update(handle h, value_type&& value)
+  {
+    const bool lower = comp_(value, h.node_->value);
+    h.node_->value = mystl::move(value);
+    lower ? demote(h.node_) : promote(h.node_);
+  }
+
+  // 删除 h 所指的元素，h 随之失效
+  void erase(handle h)
+  {
+    node_ptr n = h.node_;
+    if (n == root_)
+    {
+      pop();
+      return;
+    }
+    cut(n);
+    root_ = meld(root_, merge_pairs(n->child));
+    destroy_node(n);
+    --size_;
+  }
+
+  // 把 rhs 的所有元素并入本堆，rhs 变为空，rhs 的句柄转而属于本堆
+  void merge(pairing_heap& rhs)
+  {
+    MYSTL_DEBUG(alloc_ == rhs.alloc_);
+    if (this == &rhs)
+      return;
+    root_ = meld(root_, rhs.root_);
+    size_ += rhs.size_;
+    rhs.root_ = nullptr;
+    rhs.size_ = 0;
+  }
+
+  void clear() noexcept;
+
+  void swap(pairing_heap& rhs) noexcept
+  {
+    mystl::swap(root_, rhs.root_);
+    mystl::swap(size_, rhs.size_);
+    mystl::swap(comp_, rhs.comp_);
+    mystl::swap(alloc_, rhs.alloc_);
+  }
+
+private:
+  template <class ...Args>
+  node_ptr create_node(Args&& ...args)
+  {
+    node_ptr n = alloc_.allocate(1);
+    try
+    {
+      mystl::construct(n, mystl::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      alloc_.deallocate(n, 1);
+      throw;
+    }
+    return n;
+  }
+
+  void destroy_node(node_ptr n) noexcept
+  {
+    mystl::destroy(n);
+    alloc_.deallocate(n, 1);
+  }
+
+  // 合并两棵树，优先级较低的根成为另一个根的第一个子节点；两者都不能有兄弟
+  node_ptr meld(node_ptr a, node_ptr b)
+  {
+    if (a == nullptr)
+      return b;
+    if (b == nullptr)
+      return a;
+    if (comp_(a->value, b->value))
+      mystl::swap(a, b);
+    b->prev = a;
+    b->next = a->child;
+    if (a->child != nullptr)
+      a->child->prev = b;
+    a->child = b;
+    return a;
+  }
+
+  // 把 n 连同它的子树从父节点或兄弟链中摘下
+  void cut(node_ptr n) noexcept
+  {
+    if (n->prev->child == n)
+      n->prev->child = n->next;
+    else
+      n->prev->next = n->next;
+    if (n->next != nullptr)
+      n->next->prev = n->prev;
+    n->prev = nullptr;
+    n->next = nullptr;
+  }
+
+  // n 的优先级提高后，摘下子树再与根合并
+  void promote(node_ptr n)
+  {
+    if (n == root_)
+      return;
+    cut(n);
+    root_ = meld(root_, n);
+  }
+
+  // n 的优先级降低后，n 的子节点可能比它更优先，先把它们合并回去，再把 n 当作单个节点合并
+  void demote(node_ptr n)
+  {
+    node_ptr children = n->child;
+    n->child = nullptr;
+    if (n == root_)
+    {
+      root_ = meld(merge_pairs(children), n);
+      return;
+    }
+    cut(n);
+    root_ = meld(meld(root_, merge_pairs(children)), n);
+  }
+
+  node_ptr merge_pairs(node_ptr first);
+  void     copy_from(const pairing_heap& rhs);
+};
+
+/*****************************************************************************************/
+
+// 两趟合并：从左到右两两合并，再从右到左依次并入
+// 第一趟的结果用 next 串成一个栈，第二趟从栈顶（即最右边）开始
+template <class T, class Compare, class Alloc>
+typename pairing_heap<T, Compare, Alloc>::node_ptr
+pairing_heap<T, Compare, Alloc>::merge_pairs(node_ptr first)
+{
+  if (first == nullptr)
+    return nullptr;
+  node_ptr paired = nullptr;
+  while (first != nullptr)
+  {
+    node_ptr a = first;
+    node_ptr b = a->next;
+    a->prev = nullptr;
+    if (b == nullptr)
+    {
+      a->next = paired;
+      paired = a;
+      break;
+    }
+    first = b->next;
+    a->next = nullptr;
+    b->prev = nullptr;
+    b->next = nullptr;
+    node_ptr m = meld(a, b);
+    m->next = paired;
+    paired = m;
+  }
+  node_ptr result = paired;
+  paired = paired->next;
+  result->next = nullptr;
+  while (paired != nullptr)
+  {
+    node_ptr next = paired->next;
+    paired->next = nullptr;
+    result = meld(result, paired);
+    paired = next;
+  }
+  return result;
+}
+
+// 把 child 看作左子树、next 看作右子树，不断右旋直到没有左子树再释放，不需要额外空间
+template <class T, class Compare, class Alloc>
+void pairing_heap<T, Compare, Alloc>::clear() noexcept
+{
+  node_ptr cur = root_;
+  while (cur != nullptr)
+  {
+    if (cur->child != nullptr)
+    {
+      node_ptr l = cur->child;
+      cur->child = l->next;
+      l->next = cur;
+      cur = l;
+    }
+    else
+    {
+      node_ptr next = cur->next;
+      destroy_node(cur);
+      cur = next;
+    }
+  }
+  root_ = nullptr;
+  size_ = 0;
+}
+
+// 逐个 push，树的深度可能与元素个数同阶，用显式的栈遍历
+template <class T, class Compare, class Alloc>
+void pairing_heap<T, Compare, Alloc>::copy_from(const pairing_heap& rhs)
+{
+  if (rhs.root_ == nullptr)
+    return;
+  mystl::vector<node_ptr> stack;
+  stack.push_back(rhs.root_);
+  while (!stack.empty())
+  {
+    node_ptr n = stack.back();
+    stack.pop_back();
+    push(n->value);
+    if (n->next != nullptr)
+      stack.push_back(n->next);
+    if (n->child != nullptr)
+      stack.push_back(n->child);
+  }
+}
+
+// 重载 mystl 的 swap
+template <class T, class Compare, class Alloc>
+void swap(pairing_heap<T, Compare, Alloc>& lhs, pairing_heap<T, Compare, Alloc>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYSTL_PAIRING_HEAP_H
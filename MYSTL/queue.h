@@ -3,6 +3,9 @@
 
 
 #include "deque.h"
+#include "vector.h"
+#include "functional.h"
+#include "heap_algo.h"
 
 
 namespace mystl{
@@ -169,6 +172,254 @@ void swap(queue<T, Container>& lhs, queue<T, Container>& rhs) noexcept(noexcept(
   lhs.swap(rhs);
 }
 
+/*****************************************************************************************/
+
+namespace heap_detail
+{
+
+// D 叉堆的三个操作，D 为 2 时直接使用 heap_algo.h 中的二叉堆算法
+template <size_t D>
+struct heap_ops
+{
+  template <class RandomIter, class Compare>
+  static void push(RandomIter first, RandomIter last, Compare comp)
+  { mystl::dary_push_heap<D>(first, last, comp); }
+  template <class RandomIter, class Compare>
+  static void pop(RandomIter first, RandomIter last, Compare comp)
+  { mystl::dary_pop_heap<D>(first, last, comp); }
+  template <class RandomIter, class Compare>
+  static void make(RandomIter first, RandomIter last, Compare comp)
+  { mystl::dary_make_heap<D>(first, last, comp); }
+};
+
+template <>
+struct heap_ops<2>
+{
+  template <class RandomIter, class Compare>
+  static void push(RandomIter first, RandomIter last, Compare comp)
+  { mystl::push_heap(first, last, comp); }
+  template <class RandomIter, class Compare>
+  static void pop(RandomIter first, RandomIter last, Compare comp)
+  { mystl::pop_heap(first, last, comp); }
+  template <class RandomIter, class Compare>
+  static void make(RandomIter first, RandomIter last, Compare comp)
+  { mystl::make_heap(first, last, comp); }
+};
+
+} // namespace heap_detail
+
+// 模板类 dary_priority_queue
+// 参数一代表数据类型，参数二代表每个节点的子节点个数，参数三代表底层容器类型，缺省使用 mystl::vector，
+// 参数四代表比较权值的方式，缺省使用 mystl::less，此时堆顶为最大的元素
+// 取 D = 4 时树高减半，每层的 D 个子节点相邻；D = 2 即 priority_queue
+template <class T, size_t D = 4, class Container = mystl::vector<T>,
+  class Compare = mystl::less<typename Container::value_type>>
+class dary_priority_queue
+{
+  static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+public:
+  typedef Container                           container_type;
+  typedef Compare                             value_compare;
+  // 使用底层容器的型别
+  typedef typename Container::value_type      value_type;
+  typedef typename Container::size_type       size_type;
+  typedef typename Container::reference       reference;
+  typedef typename Container::const_reference const_reference;
+
+  static_assert(std::is_same<T, value_type>::value,
+                "the value_type of Container should be same with T");
+
+  static constexpr size_t arity = D;
+
+private:
+  typedef heap_detail::heap_ops<D> ops;
+
+  container_type c_;     // 用底层容器来表现 priority_queue
+  value_compare  comp_;  // 权值比较的标准
+
+public:
+  // 构造、复制、移动函数
+  dary_priority_queue() = default;
+
+  explicit dary_priority_queue(const Compare& c)
+    :c_(), comp_(c)
+  {
+  }
+
+  explicit dary_priority_queue(size_type n)
+    :c_(n)
+  {
+    ops::make(c_.begin(), c_.end(), comp_);
+  }
+  dary_priority_queue(size_type n, const value_type& value)
+    :c_(n, value)
+  {
+    ops::make(c_.begin(), c_.end(), comp_);
+  }
+
+  template <class IIter>
+  dary_priority_queue(IIter first, IIter last)
+    :c_(first, last)
+  {
+    ops::make(c_.begin(), c_.end(), comp_);
+  }
+
+  dary_priority_queue(std::initializer_list<T> ilist)
+    :c_(ilist)
+  {
+    ops::make(c_.begin(), c_.end(), comp_);
+  }
+
+  dary_priority_queue(const Container& s)
+    :c_(s)
+  {
+    ops::make(c_.begin(), c_.end(), comp_);
+  }
+  dary_priority_queue(Container&& s)
+    :c_(mystl::move(s))
+  {
+    ops::make(c_.begin(), c_.end(), comp_);
+  }
+
+  dary_priority_queue(const dary_priority_queue& rhs)
+    :c_(rhs.c_), comp_(rhs.comp_)
+  {
+  }
+  dary_priority_queue(dary_priority_queue&& rhs)
+    noexcept(std::is_nothrow_move_constructible<Container>::value)
+    :c_(mystl::move(rhs.c_)), comp_(rhs.comp_)
+  {
+  }
+
+  dary_priority_queue& operator=(const dary_priority_queue& rhs)
+  {
+    c_ = rhs.c_;
+    comp_ = rhs.comp_;
+    return *this;
+  }
+  dary_priority_queue& operator=(dary_priority_queue&& rhs)
+    noexcept(std::is_nothrow_move_assignable<Container>::value)
+  {
+    c_ = mystl::move(rhs.c_);
+    comp_ = rhs.comp_;
+    return *this;
+  }
+  dary_priority_queue& operator=(std::initializer_list<T> ilist)
+  {
+    c_ = ilist;
+    comp_ = value_compare();
+    ops::make(c_.begin(), c_.end(), comp_);
+    return *this;
+  }
+
+  ~dary_priority_queue() = default;
+
+public:
+
+  // 访问元素相关操作
+  const_reference top() const { return c_.front(); }
+
+  // 容量相关操作
+  bool      empty() const noexcept { return c_.empty(); }
+  size_type size()  const noexcept { return c_.size(); }
+
+  // 修改容器相关的操作
+  template <class... Args>
+  void emplace(Args&& ...args)
+  {
+    c_.emplace_back(mystl::forward<Args>(args)...);
+    ops::push(c_.begin(), c_.end(), comp_);
+  }
+
+  void push(const value_type& value)
+  {
+    c_.push_back(value);
+    ops::push(c_.begin(), c_.end(), comp_);
+  }
+  void push(value_type&& value)
+  {
+    c_.push_back(mystl::move(value));
+    ops::push(c_.begin(), c_.end(), comp_);
+  }
+
+  // 一次放入 [first, last)
+  // 新元素较多时整体重建堆（O(n)），否则逐个上溯（每个 O(log n)）
+  template <class IIter>
+  void push_range(IIter first, IIter last)
+  {
+    const size_type old_size = c_.size();
+    c_.insert(c_.end(), first, last);
+    const size_type added = c_.size() - old_size;
+    if (added == 0)
+      return;
+    if (prefer_rebuild(old_size, added))
+    {
+      ops::make(c_.begin(), c_.end(), comp_);
+    }
+    else
+    {
+      for (size_type i = old_size + 1; i <= c_.size(); ++i)
+        ops::push(c_.begin(), c_.begin() + i, comp_);
+    }
+  }
+
+  void pop()
+  {
+    ops::pop(c_.begin(), c_.end(), comp_);
+    c_.pop_back();
+  }
+
+  void clear()
+  {
+    c_.clear();
+  }
+
+  void swap(dary_priority_queue& rhs) noexcept(noexcept(mystl::swap(c_, rhs.c_)) &&
+                                               noexcept(mystl::swap(comp_, rhs.comp_)))
+  {
+    mystl::swap(c_, rhs.c_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+
+public:
+  friend bool operator==(const dary_priority_queue& lhs, const dary_priority_queue& rhs)
+  {
+    return lhs.c_ == rhs.c_;
+  }
+  friend bool operator!=(const dary_priority_queue& lhs, const dary_priority_queue& rhs)
+  {
+    return lhs.c_ != rhs.c_;
+  }
+
+private:
+  // 逐个上溯最坏要 added * log(n) 次比较，重建堆约 2n 次
+  static bool prefer_rebuild(size_type old_size, size_type added) noexcept
+  {
+    const size_type total = old_size + added;
+    size_type height = 1;
+    for (size_type n = total; n >= D; n /= D)
+      ++height;
+    return added * height >= 2 * total;
+  }
+};
+
+template <class T, size_t D, class Container, class Compare>
+constexpr size_t dary_priority_queue<T, D, Container, Compare>::arity;
+
+// 重载 mystl 的 swap
+template <class T, size_t D, class Container, class Compare>
+void swap(dary_priority_queue<T, D, Container, Compare>& lhs,
+          dary_priority_queue<T, D, Container, Compare>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+  lhs.swap(rhs);
+}
+
+// 模板类 priority_queue
+// 二叉堆，直接使用 heap_algo.h 中的 push_heap / pop_heap / make_heap
+template <class T, class Container = mystl::vector<T>,
+  class Compare = mystl::less<typename Container::value_type>>
+using priority_queue = dary_priority_queue<T, 2, Container, Compare>;
+
 }
 
 
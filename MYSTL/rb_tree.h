@@ -710,7 +710,8 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 }
 
 // 模板类 rb_tree
-template <class T, class Compare>
+// 模板参数 Alloc 代表空间配置器，节点和 header 的配置器都由它 rebind 得到
+template <class T, class Compare, class Alloc = mystl::allocator<T>>
 class rb_tree
 {
 public:
@@ -726,10 +727,10 @@ public:
     typedef typename tree_traits::value_type         value_type;
     typedef Compare                                  key_compare;
 
-    typedef mystl::allocator<T>                      allocator_type;
-    typedef mystl::allocator<T>                      data_allocator;
-    typedef mystl::allocator<base_type>              base_allocator;
-    typedef mystl::allocator<node_type>              node_allocator;
+    typedef Alloc                                    allocator_type;
+    typedef Alloc                                    data_allocator;
+    typedef typename Alloc::template rebind<base_type>::other base_allocator;
+    typedef typename Alloc::template rebind<node_type>::other node_allocator;
 
     typedef typename allocator_type::pointer         pointer;
     typedef typename allocator_type::const_pointer   const_pointer;
@@ -743,10 +744,12 @@ public:
     typedef mystl::reverse_iterator<iterator>        reverse_iterator;
     typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
 
-    allocator_type get_allocator() const { return node_allocator(); }
+    allocator_type get_allocator() const { return allocator_type(node_alloc_); }
     key_compare    key_comp()      const { return key_comp_; }
 
 private:
+    node_allocator node_alloc_; // 数据节点的配置器
+    base_allocator base_alloc_; // header 的配置器
     // 用以下三个数据结构表示红黑树
     base_ptr    header_;     // 特殊节点，与根节点互为对方的父节点，左子节点指向最小节点，右子节点指向最大节点
     size_type   node_count_;  // 节点数量
@@ -761,6 +764,10 @@ private:
 public:
     // 构造、复制、析构函数
     rb_tree() { rb_tree_init(); }
+    explicit rb_tree(const key_compare& comp,
+                     const allocator_type& alloc = allocator_type())
+        : node_alloc_(alloc), base_alloc_(alloc), key_comp_(comp)
+    { rb_tree_init(); }
     // 拷贝构造函数
     rb_tree(const rb_tree& rhs);
     // 移动构造函数
@@ -770,7 +777,12 @@ public:
     // 移动赋值
     rb_tree& operator=(rb_tree&& rhs);
     // 析构函数
-    ~rb_tree(){ clear(); }
+    ~rb_tree()
+    {
+        clear();
+        if (header_ != nullptr)
+            base_alloc_.deallocate(header_, 1);
+    }
 
 public:
   // 迭代器相关操作
@@ -967,9 +979,10 @@ private:
 //**************************************************************************************************
 
 // 拷贝构造函数
-template <class T, class Compare>
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::
 rb_tree(const rb_tree& rhs)
+    : node_alloc_(rhs.node_alloc_), base_alloc_(rhs.base_alloc_)
 {
     rb_tree_init();
     if(rhs.node_count_ != 0)
@@ -984,10 +997,12 @@ rb_tree(const rb_tree& rhs)
 }
 
 // 移动构造函数
-template <class T, class Compare>
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::
 rb_tree(rb_tree&& rhs ) noexcept
-    : header_(mystl::move(rhs.header_)),
+    : node_alloc_(rhs.node_alloc_),
+    base_alloc_(rhs.base_alloc_),
+    header_(mystl::move(rhs.header_)),
     node_count_(rhs.node_count_),
     key_comp_(rhs.key_comp_)
 {
@@ -995,9 +1010,9 @@ rb_tree(rb_tree&& rhs ) noexcept
 }
 
 // 拷贝赋值
-template <class T, class Compare>
-rb_tree<T, Compare>&
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>&
+rb_tree<T, Compare, Alloc>::
 operator=(const rb_tree& rhs)
 {
     if(this != &rhs)
@@ -1018,25 +1033,21 @@ operator=(const rb_tree& rhs)
 }
 
 //移动赋值
-template <class T, class Compare>
-rb_tree<T, Compare>&
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>&
+rb_tree<T, Compare, Alloc>::
 operator=(rb_tree&& rhs)
-{
-    clear();
-    header_ = mystl::move(rhs.header_);
-    node_count_ = rhs.node_count_;
-    key_comp_ = rhs.key_comp_;
-    rhs.reset();
+{   // 节点连同配置器一起接管，原有节点交给 tmp 释放
+    rb_tree tmp(mystl::move(rhs));
+    swap(tmp);
     return *this;
-
 }
 
 // 就地插入元素，键值允许重复
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class ...Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T,Compare>::
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 emplace_multi(Args&& ...args)
 {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1046,10 +1057,10 @@ emplace_multi(Args&& ...args)
     return insert_node_at(res.first, np, res.second);
 }
 
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class ...Args>
-mystl::pair<typename rb_tree<T,Compare>::iterator,bool>
-rb_tree<T,Compare>::
+mystl::pair<typename rb_tree<T, Compare, Alloc>::iterator,bool>
+rb_tree<T, Compare, Alloc>::
 emplace_unique(Args&& ...args)
 {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1071,10 +1082,10 @@ emplace_unique(Args&& ...args)
 //! case 1: 判断提示的位置是否为首元素，并且进一步判断要插入的值是否小于首元素，如果小于，则直接插入，否则，正常寻找插入位置后，再插入
 //! case 2: 判断提示的位置是否为尾元素，并且进一步判断要插入的值是否大于尾元素，如果大于，则直接插入，否则，正常寻找插入位置后，再插入
 //! case 3: 最后判断要插入的元素是否在提示的位置附近(附近只的是提示位置和提示位置前一个元素之间)，如果在，直接插入，否则，正常寻找插入位置后，再插入
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class ...Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 emplace_multi_use_hint(iterator hint, Args&& ...args)
 {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1116,10 +1127,10 @@ emplace_multi_use_hint(iterator hint, Args&& ...args)
 
 // 就地插入元素，键值不允许重复，当 hint 位置与插入位置接近时，插入操作的时间复杂度可以降低
 // 思路和 emplace_multi_use_hint 一样
-template<class T, class Compare>
+template <class T, class Compare, class Alloc>
 template<class ...Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 emplace_unique_use_hint(iterator hint, Args&& ...args)
 {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1167,9 +1178,9 @@ emplace_unique_use_hint(iterator hint, Args&& ...args)
 }
 
 // 插入元素，节点值允许重复
-template <class T, class Compare>
-typename rb_tree<T,Compare>::iterator
-rb_tree<T,Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 insert_multi(const value_type& value)
 {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1178,9 +1189,9 @@ insert_multi(const value_type& value)
 }
 
 // 插入新值，节点键值不允许重复，返回一个 pair，若插入成功，pair 的第二参数为 true，否则为 false
-template <class T, class Compare>
-mystl::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+mystl::pair<typename rb_tree<T, Compare, Alloc>::iterator, bool>
+rb_tree<T, Compare, Alloc>::
 insert_unique(const value_type& value)
 {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -1193,9 +1204,9 @@ insert_unique(const value_type& value)
 }
 
 // 删除hint位置上的节点
-template <class T, class Compare>
-typename rb_tree<T,Compare>::iterator
-rb_tree<T,Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 erase(iterator hint)
 {
     auto node = hint.node->get_node_ptr();
@@ -1209,9 +1220,9 @@ erase(iterator hint)
 }
 
 // 删除键值等于key的元素， 返回删除的个数
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::
 erase_multi(const key_type& key)
 {
     auto p = equal_range_multi(key);
@@ -1221,9 +1232,9 @@ erase_multi(const key_type& key)
 }
 
 // 删除键值等于key的元素， 返回删除的个数
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::
 erase_unique(const key_type& key)
 {
     auto it = find(key);
@@ -1236,8 +1247,8 @@ erase_unique(const key_type& key)
 }
 
 // 删除[first, last)区间的元素
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 erase(iterator first, iterator last)
 {
     if(first == begin() && last == end())
@@ -1252,8 +1263,8 @@ erase(iterator first, iterator last)
 }
 
 // 清空rb_tree
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 clear()
 {
   if (node_count_ != 0)
@@ -1267,9 +1278,9 @@ clear()
 }
 
 // 查找键值为key 的节点，返回值指向他的迭代器
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 find(const key_type& key)
 {
     auto y = header_;
@@ -1290,9 +1301,9 @@ find(const key_type& key)
   return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::
 find(const key_type& key) const
 {
   auto y = header_;  // 最后一个不小于 key 的节点
@@ -1313,9 +1324,9 @@ find(const key_type& key) const
 }
 
 // 键值不小于 key 的第一个位置
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 lower_bound(const key_type& key)
 {
   auto y = header_;
@@ -1335,9 +1346,9 @@ lower_bound(const key_type& key)
   return iterator(y);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::
 lower_bound(const key_type& key) const
 {
   auto y = header_;
@@ -1357,9 +1368,9 @@ lower_bound(const key_type& key) const
 }
 
 // 键值不小于 key 的最后一个位置
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 upper_bound(const key_type& key)
 {
   auto y = header_;
@@ -1378,9 +1389,9 @@ upper_bound(const key_type& key)
   return iterator(y);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::
 upper_bound(const key_type& key) const
 {
   auto y = header_;
@@ -1399,12 +1410,14 @@ upper_bound(const key_type& key) const
   return const_iterator(y);
 }
 
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 swap(rb_tree& rhs) noexcept
 {
     if(this != &rhs)
     {
+        mystl::swap(node_alloc_, rhs.node_alloc_);
+        mystl::swap(base_alloc_, rhs.base_alloc_);
         mystl::swap(header_, rhs.header_);
         mystl::swap(node_count_, rhs.node_count_);
         mystl::swap(key_comp_, rhs.key_comp_);
@@ -1415,32 +1428,32 @@ swap(rb_tree& rhs) noexcept
 // helper functions
 
 // 创建一个节点
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class ...Args>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T,Compare>::
+typename rb_tree<T, Compare, Alloc>::node_ptr
+rb_tree<T, Compare, Alloc>::
 create_node(Args&& ...args)
 {
-    auto tmp = node_allocator::allocate(1);
+    auto tmp = node_alloc_.allocate(1);
     try
     {
-        data_allocator::construct(mystl::address_of(tmp->value), mystl::forward<Args>(args)...);
+        mystl::construct(mystl::address_of(tmp->value), mystl::forward<Args>(args)...);
         tmp->left = nullptr;
         tmp->right = nullptr;
         tmp->parent = nullptr;
     }
     catch(...)
     {
-        node_allocator::deallocate(tmp);
+        node_alloc_.deallocate(tmp, 1);
         throw;
     }
     return tmp;
 }
 
 // 复制一个结点
-template <class T, class Compare>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::node_ptr
+rb_tree<T, Compare, Alloc>::
 clone_node(base_ptr x)
 {
   node_ptr tmp = create_node(x->get_node_ptr()->value);
@@ -1451,23 +1464,23 @@ clone_node(base_ptr x)
 }
 
 // 销毁一个结点
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 destroy_node(node_ptr p)
 { // 析构对象
-  data_allocator::destroy(&p->value);
+  mystl::destroy(&p->value);
   // 释放空间
-  node_allocator::deallocate(p);
+  node_alloc_.deallocate(p, 1);
 }
 
 
 
 // 初始化容器
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 rb_tree_init()
 {
-    header_ = base_allocator::allocate(1);
+    header_ = base_alloc_.allocate(1);
     header_->color = rb_tree_red;
     root() = nullptr;
     leftmost() = header_;
@@ -1476,8 +1489,8 @@ rb_tree_init()
 }
 
 // reset 函数
-template <class T, class Compare>
-void rb_tree<T, Compare>::reset()
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::reset()
 {
   header_ = nullptr;
   node_count_ = 0;
@@ -1491,9 +1504,9 @@ void rb_tree<T, Compare>::reset()
 
 // get_insert_multi_pos 函数
 // 找出插入节点的位置，节点值可以重复
-template <class T, class Compare>
-mystl::pair <typename rb_tree<T, Compare>::base_ptr, bool>
-rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key)
+template <class T, class Compare, class Alloc>
+mystl::pair <typename rb_tree<T, Compare, Alloc>::base_ptr, bool>
+rb_tree<T, Compare, Alloc>::get_insert_multi_pos(const key_type& key)
 {
     auto x = root();
     auto y = header_;
@@ -1511,9 +1524,9 @@ rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key)
 
 // get_insert_unique_pos 函数
 // 插入节点的值在树中不可以重复
-template <class T, class Compare>
-mystl::pair<mystl::pair<typename rb_tree<T, Compare>::base_ptr, bool>, bool>
-rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key)
+template <class T, class Compare, class Alloc>
+mystl::pair<mystl::pair<typename rb_tree<T, Compare, Alloc>::base_ptr, bool>, bool>
+rb_tree<T, Compare, Alloc>::get_insert_unique_pos(const key_type& key)
 {   // 返回一个 pair，第一个值为一个 pair，包含插入点的父节点和一个 bool 表示是否在左边插入，
     // 第二个值为一个 bool，表示是否插入成功
     auto x = root();
@@ -1550,9 +1563,9 @@ rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key)
 
 // insert_value_at 函数
 // x 为插入点的父节点， value 为要插入的值，add_to_left 表示是否在左边插入
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 insert_value_at(base_ptr x, const value_type& value, bool add_to_left)
 {
   node_ptr node = create_node(value);
@@ -1583,9 +1596,9 @@ insert_value_at(base_ptr x, const value_type& value, bool add_to_left)
 
 // 在 x 节点处插入新的节点
 // x 为插入点的父节点， node 为要插入的节点，add_to_left 表示是否在左边插入
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
 insert_node_at(base_ptr x, node_ptr node, bool add_to_left)
 {
     node->parent = x;
@@ -1600,7 +1613,7 @@ insert_node_at(base_ptr x, node_ptr node, bool add_to_left)
     else if(add_to_left)
     {
         x->left = base_node;
-        if(leftmost() = x)
+        if(leftmost() == x)
             leftmost() = base_node;
     }
     else{
@@ -1614,9 +1627,9 @@ insert_node_at(base_ptr x, node_ptr node, bool add_to_left)
 }
 
 // 插入元素，键值允许重复，使用 hint
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator 
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator 
+rb_tree<T, Compare, Alloc>::
 insert_multi_use_hint(iterator hint, key_type key, node_ptr node)
 {
   // 在 hint 附近寻找可插入的位置
@@ -1642,9 +1655,9 @@ insert_multi_use_hint(iterator hint, key_type key, node_ptr node)
 }
 
 // 插入元素，键值不允许重复，使用 hint
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator 
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator 
+rb_tree<T, Compare, Alloc>::
 insert_unique_use_hint(iterator hint, key_type key, node_ptr node)
 {
   // 在 hint 附近寻找可插入的位置
@@ -1676,9 +1689,9 @@ insert_unique_use_hint(iterator hint, key_type key, node_ptr node)
 // copy_from 函数
 // 递归复制一颗树，节点从 x 开始，p 为 x 的父节点
 // TODO 递归看的不是很明白
-template <class T, class Compare>
-typename rb_tree<T, Compare>::base_ptr
-rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p)
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::base_ptr
+rb_tree<T, Compare, Alloc>::copy_from(base_ptr x, base_ptr p)
 {
   auto top = clone_node(x);
   top->parent = p;
@@ -1709,8 +1722,8 @@ rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p)
 
 // erase_since 函数
 // 从 x 节点开始删除该节点及其子树
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
 erase_since(base_ptr x)
 { // 直到当前节点的左右子树均为空为止
   while (x != nullptr)
@@ -1724,45 +1737,51 @@ erase_since(base_ptr x)
 }
 
 // 重载比较操作符
-template <class T, class Compare>
-bool operator==(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator==(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T, class Compare>
-bool operator<(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator<(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T, class Compare>
-bool operator!=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator!=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return !(lhs == rhs);
 }
 
-template <class T, class Compare>
-bool operator>(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator>(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return rhs < lhs;
 }
 
-template <class T, class Compare>
-bool operator<=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator<=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return !(rhs < lhs);
 }
 
-template <class T, class Compare>
-bool operator>=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <class T, class Compare, class Alloc>
+bool operator>=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs)
 {
   return !(lhs < rhs);
 }
 
+// header_ 分配在堆上，比较函数与配置器可以搬移时 rb_tree 可以按字节搬移
+template <class T, class Compare, class Alloc>
+struct is_trivially_relocatable<rb_tree<T, Compare, Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<Compare>::value &&
+                                 is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
-template <class T, class Compare>
-void swap(rb_tree<T, Compare>& lhs, rb_tree<T, Compare>& rhs) noexcept
+template <class T, class Compare, class Alloc>
+void swap(rb_tree<T, Compare, Alloc>& lhs, rb_tree<T, Compare, Alloc>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
@@ -11,7 +11,9 @@ namespace mystl
 
 // 模板类 set，键值不允许重复
 // 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mystl::less 
-template <class Key, class Compare = mystl::less<Key>>
+// 参数三代表空间配置器，缺省使用 mystl::allocator
+template <class Key, class Compare = mystl::less<Key>,
+          class Alloc = mystl::allocator<Key>>
 class set
 { 
 public:
@@ -23,7 +25,7 @@ public:
 
 private:
   // 以 mystl::rb_tree 作为底层机制
-  typedef mystl::rb_tree<value_type, key_compare>  base_type;
+  typedef mystl::rb_tree<value_type, key_compare, Alloc>  base_type;
   base_type tree_;
 
 public:
@@ -44,13 +46,23 @@ public:
 public:
   // 构造、复制、移动函数
   set() = default;
+  explicit set(const key_compare& comp, const allocator_type& alloc = allocator_type())
+      :tree_(comp, alloc)
+  {
+  }
+  explicit set(const allocator_type& alloc)
+      :tree_(key_compare(), alloc)
+  {
+  }
 
   template <class InputIterator>
-  set(InputIterator first, InputIterator last) 
-    :tree_() 
+  set(InputIterator first, InputIterator last,
+      const allocator_type& alloc = allocator_type())
+    :tree_(key_compare(), alloc) 
   { tree_.insert_unique(first, last); }
-  set(std::initializer_list<value_type> ilist)
-    :tree_()
+  set(std::initializer_list<value_type> ilist,
+      const allocator_type& alloc = allocator_type())
+    :tree_(key_compare(), alloc)
   { tree_.insert_unique(ilist.begin(), ilist.end()); }
 
   set(const set& rhs) 
@@ -193,45 +205,51 @@ public:
 };
 
 // 重载比较操作符
-template <class Key, class Compare>
-bool operator==(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator==(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
 {
   return lhs == rhs;
 }
 
-template <class Key, class Compare>
-bool operator<(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator<(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
 {
   return lhs < rhs;
 }
 
-template <class Key, class Compare>
-bool operator!=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator!=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
 {
   return !(lhs == rhs);
 }
 
-template <class Key, class Compare>
-bool operator>(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator>(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
 {
   return rhs < lhs;
 }
 
-template <class Key, class Compare>
-bool operator<=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator<=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
 {
   return !(rhs < lhs);
 }
 
-template <class Key, class Compare>
-bool operator>=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator>=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs)
 {
   return !(lhs < rhs);
 }
 
+// 与底层的 rb_tree 相同
+template <class Key, class Compare, class Alloc>
+struct is_trivially_relocatable<set<Key, Compare, Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<Compare>::value &&
+                                 is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
-template <class Key, class Compare>
-void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept
+template <class Key, class Compare, class Alloc>
+void swap(set<Key, Compare, Alloc>& lhs, set<Key, Compare, Alloc>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
@@ -240,7 +258,9 @@ void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept
 
 // 模板类 multiset，键值允许重复
 // 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mystl::less 
-template <class Key, class Compare = mystl::less<Key>>
+// 参数三代表空间配置器，缺省使用 mystl::allocator
+template <class Key, class Compare = mystl::less<Key>,
+          class Alloc = mystl::allocator<Key>>
 class multiset
 {
 public:
@@ -251,7 +271,7 @@ public:
 
 private:
   // 以 mystl::rb_tree 作为底层机制
-  typedef mystl::rb_tree<value_type, key_compare>  base_type;
+  typedef mystl::rb_tree<value_type, key_compare, Alloc>  base_type;
   base_type tree_;  // 以 rb_tree 表现 multiset
 
 public:
@@ -272,13 +292,23 @@ public:
 public:
   // 构造、复制、移动函数
   multiset() = default;
+  explicit multiset(const key_compare& comp, const allocator_type& alloc = allocator_type())
+      :tree_(comp, alloc)
+  {
+  }
+  explicit multiset(const allocator_type& alloc)
+      :tree_(key_compare(), alloc)
+  {
+  }
 
   template <class InputIterator>
-  multiset(InputIterator first, InputIterator last) 
-    :tree_() 
+  multiset(InputIterator first, InputIterator last,
+           const allocator_type& alloc = allocator_type())
+    :tree_(key_compare(), alloc) 
   { tree_.insert_multi(first, last); }
-  multiset(std::initializer_list<value_type> ilist)
-    :tree_() 
+  multiset(std::initializer_list<value_type> ilist,
+           const allocator_type& alloc = allocator_type())
+    :tree_(key_compare(), alloc) 
   { tree_.insert_multi(ilist.begin(), ilist.end()); }
 
   multiset(const multiset& rhs)
@@ -421,45 +451,51 @@ public:
 };
 
 // 重载比较操作符
-template <class Key, class Compare>
-bool operator==(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator==(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
 {
   return lhs == rhs;
 }
 
-template <class Key, class Compare>
-bool operator<(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator<(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
 {
   return lhs < rhs;
 }
 
-template <class Key, class Compare>
-bool operator!=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator!=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
 {
   return !(lhs == rhs);
 }
 
-template <class Key, class Compare>
-bool operator>(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator>(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
 {
   return rhs < lhs;
 }
 
-template <class Key, class Compare>
-bool operator<=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator<=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
 {
   return !(rhs < lhs);
 }
 
-template <class Key, class Compare>
-bool operator>=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc>
+bool operator>=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
 {
   return !(lhs < rhs);
 }
 
+// 与底层的 rb_tree 相同
+template <class Key, class Compare, class Alloc>
+struct is_trivially_relocatable<multiset<Key, Compare, Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<Compare>::value &&
+                                 is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
-template <class Key, class Compare>
-void swap(multiset<Key, Compare>& lhs, multiset<Key, Compare>& rhs) noexcept
+template <class Key, class Compare, class Alloc>
+void swap(multiset<Key, Compare, Alloc>& lhs, multiset<Key, Compare, Alloc>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
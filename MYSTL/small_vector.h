@@ -0,0 +1,630 @@
+#ifndef MYSTL_SMALL_VECTOR_H
+#define MYSTL_SMALL_VECTOR_H
+
+// 这个头文件包含一个模板类 small_vector
+// small_vector : 接口与 vector 相同，前 N 个元素存放在对象内部，超出后才向配置器申请空间
+// 元素数量通常很少的场合（如每条记录附带的短列表）可以完全省掉堆分配
+
+#include <initializer_list>
+#include "uninitialized.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+#include "exceptdef.h"
+#include "allocator.h"
+
+namespace mystl
+{
+
+// 模板类: small_vector
+// 模板参数 T 代表类型，N 代表内置空间能容纳的元素个数，Alloc 代表溢出到堆上时使用的空间配置器
+template <class T, size_t N, class Alloc = mystl::allocator<T>>
+class small_vector
+{
+  static_assert(N > 0, "small_vector needs at least one inline element");
+public:
+  // small_vector 的嵌套型别定义
+  typedef Alloc                                    allocator_type;
+  typedef Alloc                                    data_allocator;
+
+  typedef typename allocator_type::value_type      value_type;
+  typedef typename allocator_type::pointer         pointer;
+  typedef typename allocator_type::const_pointer   const_pointer;
+  typedef typename allocator_type::reference       reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::size_type       size_type;
+  typedef typename allocator_type::difference_type difference_type;
+
+  typedef value_type*                              iterator;
+  typedef const value_type*                        const_iterator;
+  typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+  allocator_type get_allocator() const { return alloc_; }
+
+private:
+  typedef typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type storage_type;
+
+  data_allocator alloc_;  // 溢出到堆上时使用的配置器
+  iterator       begin_;  // 表示目前使用空间的头部，指向 buf_ 或堆上的空间
+  iterator       end_;    // 表示目前使用空间的尾部
+  iterator       cap_;    // 表示目前储存空间的尾部
+  storage_type   buf_;    // 内置空间
+
+public:
+  // 构造、复制、移动、析构函数
+  small_vector() noexcept
+  { init_inline(); }
+
+  explicit small_vector(const allocator_type& alloc) noexcept
+    :alloc_(alloc)
+  { init_inline(); }
+
+  explicit small_vector(size_type n, const allocator_type& alloc = allocator_type())
+    :alloc_(alloc)
+  {
+    init_inline();
+    try
+    {
+      reserve(n);
+      end_ = mystl::uninitialized_value_construct_n(begin_, n);
+    }
+    catch (...)
+    { // 析构函数不会执行，要自己归还可能已分配的堆空间
+      release_heap();
+      throw;
+    }
+  }
+
+  small_vector(size_type n, const value_type& value,
+               const allocator_type& alloc = allocator_type())
+    :alloc_(alloc)
+  {
+    init_inline();
+    try
+    {
+      reserve(n);
+      end_ = mystl::uninitialized_fill_n(begin_, n, value);
+    }
+    catch (...)
+    {
+      release_heap();
+      throw;
+    }
+  }
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  small_vector(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+    :alloc_(alloc)
+  {
+    init_inline();
+    init_range(first, last);
+  }
+
+  small_vector(std::initializer_list<value_type> ilist,
+               const allocator_type& alloc = allocator_type())
+    :alloc_(alloc)
+  {
+    init_inline();
+    init_range(ilist.begin(), ilist.end());
+  }
+
+  small_vector(const small_vector& rhs)
+    :alloc_(rhs.alloc_)
+  {
+    init_inline();
+    init_range(rhs.begin_, rhs.end_);
+  }
+
+  // 移动构造函数：对方在堆上时直接接管空间，在内置空间时只能逐个移动元素
+  small_vector(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+    :alloc_(rhs.alloc_)
+  {
+    init_inline();
+    take(rhs);
+  }
+
+  small_vector& operator=(const small_vector& rhs)
+  {
+    if (this != &rhs)
+      assign(rhs.begin_, rhs.end_);
+    return *this;
+  }
+
+  // 移动赋值：先归还自己的空间，配置器随之转移
+  small_vector& operator=(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+  {
+    if (this != &rhs)
+    {
+      clear();
+      release_heap();
+      init_inline();
+      alloc_ = rhs.alloc_;
+      take(rhs);
+    }
+    return *this;
+  }
+
+  small_vector& operator=(std::initializer_list<value_type> ilist)
+  {
+    assign(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  ~small_vector()
+  {
+    mystl::destroy(begin_, end_);
+    release_heap();
+  }
+
+public:
+  // 迭代器相关操作
+  iterator               begin()         noexcept
+  { return begin_; }
+  const_iterator         begin()   const noexcept
+  { return begin_; }
+  iterator               end()           noexcept
+  { return end_; }
+  const_iterator         end()     const noexcept
+  { return end_; }
+
+  // 容量相关操作
+  bool      empty()    const noexcept
+  { return begin_ == end_; }
+  size_type size()     const noexcept
+  { return static_cast<size_type>(end_ - begin_); }
+  size_type max_size() const noexcept
+  { return static_cast<size_type>(-1) / sizeof(T); }
+  size_type capacity() const noexcept
+  { return static_cast<size_type>(cap_ - begin_); }
+  // 元素是否还保存在内置空间中
+  bool      is_inline() const noexcept
+  { return begin_ == inline_begin(); }
+  static constexpr size_type inline_capacity() noexcept
+  { return N; }
+
+  void      reserve(size_type n)
+  {
+    if (capacity() < n)
+    {
+      THROW_LENGTH_ERROR_IF(n > max_size(),
+                            "n can not larger than max_size() in small_vector<T>::reserve(n)");
+      grow_to(n);
+    }
+  }
+  void      shrink_to_fit();
+
+  // 访问元素相关操作
+  reference operator[](size_type n)
+  {
+    MYSTL_DEBUG(n < size());
+    return *(begin_ + n);
+  }
+  const_reference operator[](size_type n) const
+  {
+    MYSTL_DEBUG(n < size());
+    return *(begin_ + n);
+  }
+  reference at(size_type n)
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "small_vector<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "small_vector<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+
+  reference front()
+  {
+    MYSTL_DEBUG(!empty());
+    return *begin_;
+  }
+  const_reference front() const
+  {
+    MYSTL_DEBUG(!empty());
+    return *begin_;
+  }
+  reference back()
+  {
+    MYSTL_DEBUG(!empty());
+    return *(end_ - 1);
+  }
+  const_reference back() const
+  {
+    MYSTL_DEBUG(!empty());
+    return *(end_ - 1);
+  }
+
+  pointer       data()       noexcept { return begin_; }
+  const_pointer data() const noexcept { return begin_; }
+
+  // 修改容器相关操作
+  void assign(size_type n, const value_type& value)
+  {
+    clear();
+    insert(end_, n, value);
+  }
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  void assign(Iter first, Iter last)
+  {
+    clear();
+    insert(end_, first, last);
+  }
+
+  void assign(std::initializer_list<value_type> ilist)
+  { assign(ilist.begin(), ilist.end()); }
+
+  // emplace / emplace_back
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&& ...args);
+
+  template <class... Args>
+  reference emplace_back(Args&& ...args)
+  {
+    if (end_ == cap_)
+    { // 参数可能引用当前的元素，扩容前先构造出来
+      value_type tmp(mystl::forward<Args>(args)...);
+      grow_to(get_new_cap(1));
+      mystl::construct(mystl::address_of(*end_), mystl::move(tmp));
+    }
+    else
+    {
+      mystl::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
+    }
+    ++end_;
+    return *(end_ - 1);
+  }
+
+  // push_back / pop_back
+  void push_back(const value_type& value)
+  { emplace_back(value); }
+  void push_back(value_type&& value)
+  { emplace_back(mystl::move(value)); }
+
+  void pop_back()
+  {
+    MYSTL_DEBUG(!empty());
+    mystl::destroy(end_ - 1);
+    --end_;
+  }
+
+  // insert
+  iterator insert(const_iterator pos, const value_type& value)
+  { return emplace(pos, value); }
+  iterator insert(const_iterator pos, value_type&& value)
+  { return emplace(pos, mystl::move(value)); }
+  iterator insert(const_iterator pos, size_type n, const value_type& value);
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  iterator insert(const_iterator pos, Iter first, Iter last);
+  iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+  { return insert(pos, ilist.begin(), ilist.end()); }
+
+  // erase / clear
+  iterator erase(const_iterator pos)
+  { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last);
+  void     clear() noexcept
+  {
+    mystl::destroy(begin_, end_);
+    end_ = begin_;
+  }
+
+  // resize
+  void resize(size_type new_size);
+  void resize(size_type new_size, const value_type& value);
+
+  void swap(small_vector& rhs);
+
+private:
+  // helper functions
+  iterator       inline_begin() noexcept
+  { return reinterpret_cast<iterator>(&buf_); }
+  const_iterator inline_begin() const noexcept
+  { return reinterpret_cast<const_iterator>(&buf_); }
+
+  void init_inline() noexcept
+  {
+    begin_ = end_ = inline_begin();
+    cap_ = begin_ + N;
+  }
+
+  void release_heap() noexcept
+  {
+    if (!is_inline())
+      alloc_.deallocate(begin_, capacity());
+  }
+
+  // 供构造函数使用，失败时析构已放入的元素并归还堆空间
+  template <class Iter>
+  void init_range(Iter first, Iter last)
+  {
+    try
+    {
+      insert(end_, first, last);
+    }
+    catch (...)
+    {
+      mystl::destroy(begin_, end_);
+      release_heap();
+      throw;
+    }
+  }
+
+  size_type get_new_cap(size_type add_size) const;
+  void      grow_to(size_type new_cap);
+  void      take(small_vector& rhs);
+};
+
+/*****************************************************************************************/
+
+// get_new_cap 函数：至少两倍扩容
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::size_type
+small_vector<T, N, Alloc>::get_new_cap(size_type add_size) const
+{
+  const size_type old_cap = capacity();
+  THROW_LENGTH_ERROR_IF(size() > max_size() - add_size, "small_vector<T> is too big");
+  if (old_cap > max_size() / 2)
+    return mystl::max(old_cap, size() + add_size);
+  return mystl::max(old_cap * 2, size() + add_size);
+}
+
+// grow_to 函数：把元素搬到 new_cap 大小的堆空间上
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::grow_to(size_type new_cap)
+{
+  auto new_begin = alloc_.allocate(new_cap);
+  iterator new_end;
+  try
+  {
+    new_end = mystl::uninitialized_relocate(begin_, end_, new_begin);
+  }
+  catch (...)
+  {
+    alloc_.deallocate(new_begin, new_cap);
+    throw;
+  }
+  release_heap();
+  begin_ = new_begin;
+  end_ = new_end;
+  cap_ = new_begin + new_cap;
+}
+
+// take 函数：*this 为空且使用内置空间，取走 rhs 的元素，rhs 随后为空
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::take(small_vector& rhs)
+{
+  if (rhs.is_inline())
+  {
+    end_ = mystl::uninitialized_move(rhs.begin_, rhs.end_, begin_);
+    rhs.clear();
+  }
+  else
+  {
+    begin_ = rhs.begin_;
+    end_ = rhs.end_;
+    cap_ = rhs.cap_;
+    rhs.init_inline();
+  }
+}
+
+// shrink_to_fit 函数：元素放得下时搬回内置空间，否则换成恰好大小的堆空间
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::shrink_to_fit()
+{
+  if (is_inline() || end_ == cap_)
+    return;
+  const size_type n = size();
+  if (n > N)
+  {
+    grow_to(n);
+    return;
+  }
+  auto old_begin = begin_;
+  auto old_cap = capacity();
+  auto new_end = mystl::uninitialized_relocate(begin_, end_, inline_begin());
+  alloc_.deallocate(old_begin, old_cap);
+  begin_ = inline_begin();
+  end_ = new_end;
+  cap_ = begin_ + N;
+}
+
+// emplace 函数：在 pos 处构造元素
+template <class T, size_t N, class Alloc>
+template <class ...Args>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::emplace(const_iterator pos, Args&& ...args)
+{
+  MYSTL_DEBUG(pos >= begin() && pos <= end());
+  const size_type xpos = pos - begin_;
+  if (pos == end_)
+  {
+    emplace_back(mystl::forward<Args>(args)...);
+    return begin_ + xpos;
+  }
+  value_type tmp(mystl::forward<Args>(args)...);  // 参数可能引用要后移的元素，先构造出来
+  if (end_ == cap_)
+    grow_to(get_new_cap(1));
+  iterator p = begin_ + xpos;
+  mystl::construct(mystl::address_of(*end_), mystl::move(*(end_ - 1)));
+  ++end_;
+  mystl::move_backward(p, end_ - 2, end_ - 1);
+  *p = mystl::move(tmp);
+  return p;
+}
+
+// insert 函数：在 pos 处插入 n 个 value
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::insert(const_iterator pos, size_type n, const value_type& value)
+{
+  MYSTL_DEBUG(pos >= begin() && pos <= end());
+  const size_type xpos = pos - begin_;
+  if (n == 0)
+    return begin_ + xpos;
+  const value_type value_copy = value;  // 避免被覆盖
+  if (static_cast<size_type>(cap_ - end_) < n)
+    grow_to(get_new_cap(n));
+  iterator p = begin_ + xpos;
+  const size_type after_elems = end_ - p;
+  auto old_end = end_;
+  if (after_elems > n)
+  {
+    end_ = mystl::uninitialized_move(old_end - n, old_end, old_end);
+    mystl::move_backward(p, old_end - n, old_end);
+    mystl::fill_n(p, n, value_copy);
+  }
+  else
+  {
+    end_ = mystl::uninitialized_fill_n(old_end, n - after_elems, value_copy);
+    end_ = mystl::uninitialized_move(p, old_end, end_);
+    mystl::fill(p, old_end, value_copy);
+  }
+  return p;
+}
+
+// insert 函数：在 pos 处插入 [first, last)
+template <class T, size_t N, class Alloc>
+template <class Iter, typename std::enable_if<
+  mystl::is_input_iterator<Iter>::value, int>::type>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::insert(const_iterator pos, Iter first, Iter last)
+{
+  MYSTL_DEBUG(pos >= begin() && pos <= end());
+  const size_type xpos = pos - begin_;
+  const size_type n = static_cast<size_type>(mystl::distance(first, last));
+  if (n == 0)
+    return begin_ + xpos;
+  if (static_cast<size_type>(cap_ - end_) < n)
+    grow_to(get_new_cap(n));
+  iterator p = begin_ + xpos;
+  const size_type after_elems = end_ - p;
+  auto old_end = end_;
+  if (after_elems > n)
+  {
+    end_ = mystl::uninitialized_move(old_end - n, old_end, old_end);
+    mystl::move_backward(p, old_end - n, old_end);
+    mystl::copy(first, last, p);
+  }
+  else
+  {
+    auto mid = first;
+    mystl::advance(mid, after_elems);
+    end_ = mystl::uninitialized_copy(mid, last, old_end);
+    end_ = mystl::uninitialized_move(p, old_end, end_);
+    mystl::copy(first, mid, p);
+  }
+  return p;
+}
+
+// erase 函数：删除 [first, last) 上的元素
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::erase(const_iterator first, const_iterator last)
+{
+  MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+  iterator p = begin_ + (first - begin_);
+  if (first == last)
+    return p;
+  auto new_end = mystl::move(p + (last - first), end_, p);
+  mystl::destroy(new_end, end_);
+  end_ = new_end;
+  return p;
+}
+
+// resize 函数
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::resize(size_type new_size)
+{
+  if (new_size < size())
+  {
+    erase(begin_ + new_size, end_);
+    return;
+  }
+  reserve(new_size);
+  end_ = mystl::uninitialized_value_construct_n(end_, new_size - size());
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::resize(size_type new_size, const value_type& value)
+{
+  if (new_size < size())
+    erase(begin_ + new_size, end_);
+  else
+    insert(end_, new_size - size(), value);
+}
+
+// swap 函数：双方都在堆上时只交换指针，否则借助移动完成
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::swap(small_vector& rhs)
+{
+  if (this == &rhs)
+    return;
+  if (!is_inline() && !rhs.is_inline())
+  {
+    mystl::swap(alloc_, rhs.alloc_);
+    mystl::swap(begin_, rhs.begin_);
+    mystl::swap(end_, rhs.end_);
+    mystl::swap(cap_, rhs.cap_);
+    return;
+  }
+  small_vector tmp(mystl::move(rhs));
+  rhs = mystl::move(*this);
+  *this = mystl::move(tmp);
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+
+template <class T, size_t N, class Alloc>
+bool operator==(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+{
+  return lhs.size() == rhs.size() &&
+    mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N, class Alloc>
+bool operator<(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+{
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N, class Alloc>
+bool operator!=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class T, size_t N, class Alloc>
+bool operator>(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class T, size_t N, class Alloc>
+bool operator<=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class T, size_t N, class Alloc>
+bool operator>=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T, size_t N, class Alloc>
+void swap(small_vector<T, N, Alloc>& lhs, small_vector<T, N, Alloc>& rhs)
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYSTL_SMALL_VECTOR_H
@@ -0,0 +1,406 @@
+#ifndef MYSTL_SOA_VECTOR_H
+#define MYSTL_SOA_VECTOR_H
+
+// 这个头文件包含一个模板类 soa_vector
+// soa_vector : 按列存放的 vector（struct of arrays），每个字段保存在各自连续的 vector 中
+// 只扫描一两个字段时，cache line 中不会混入其他字段，column<I>() 返回的 span 可以直接交给向量化的循环
+// 使用方式：
+//   mystl::soa_vector<int, double, char> v;
+//   v.push_back(1, 2.0, 'a');
+//   double sum = 0; for (double x : v.column<1>()) sum += x;
+
+#include <tuple>
+#include <type_traits>
+
+#include "vector.h"
+#include "span.h"
+#include "growth_policy.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+namespace soa_detail
+{
+
+// C++11 没有 std::index_sequence，这里自己定义一个
+template <size_t... I>
+struct index_sequence {};
+
+template <size_t N, size_t... I>
+struct make_index_sequence_impl : make_index_sequence_impl<N - 1, N - 1, I...> {};
+
+template <size_t... I>
+struct make_index_sequence_impl<0, I...>
+{
+  typedef index_sequence<I...> type;
+};
+
+template <size_t N>
+using make_index_sequence = typename make_index_sequence_impl<N>::type;
+
+// 按行访问的迭代器，解引用得到由各字段引用组成的 tuple
+// Soa 为（可能带 const 的）soa_vector，Ref 为对应的行引用类型
+template <class Soa, class Ref>
+class row_iterator : public mystl::iterator<mystl::random_access_iterator_tag,
+                                            typename std::remove_const<Soa>::type::value_type,
+                                            ptrdiff_t, void, Ref>
+{
+  template <class S, class R> friend class row_iterator;
+
+  Soa*   soa_;
+  size_t pos_;
+
+public:
+  typedef ptrdiff_t difference_type;
+
+  row_iterator() noexcept : soa_(nullptr), pos_(0) {}
+  row_iterator(Soa* soa, size_t pos) noexcept : soa_(soa), pos_(pos) {}
+
+  // iterator 可以转换为 const_iterator
+  template <class S, class R, typename std::enable_if<
+    std::is_convertible<S*, Soa*>::value, int>::type = 0>
+  row_iterator(const row_iterator<S, R>& rhs) noexcept : soa_(rhs.soa_), pos_(rhs.pos_) {}
+
+  Ref operator*() const { return (*soa_)[pos_]; }
+  Ref operator[](difference_type n) const { return (*soa_)[pos_ + n]; }
+  size_t index() const noexcept { return pos_; }
+
+  row_iterator& operator++() { ++pos_; return *this; }
+  row_iterator& operator--() { --pos_; return *this; }
+  row_iterator  operator++(int) { row_iterator tmp = *this; ++pos_; return tmp; }
+  row_iterator  operator--(int) { row_iterator tmp = *this; --pos_; return tmp; }
+  row_iterator& operator+=(difference_type n) { pos_ += n; return *this; }
+  row_iterator& operator-=(difference_type n) { pos_ -= n; return *this; }
+  row_iterator  operator+(difference_type n) const { return row_iterator(soa_, pos_ + n); }
+  row_iterator  operator-(difference_type n) const { return row_iterator(soa_, pos_ - n); }
+  difference_type operator-(const row_iterator& rhs) const
+  { return static_cast<difference_type>(pos_) - static_cast<difference_type>(rhs.pos_); }
+
+  bool operator==(const row_iterator& rhs) const { return pos_ == rhs.pos_; }
+  bool operator!=(const row_iterator& rhs) const { return pos_ != rhs.pos_; }
+  bool operator<(const row_iterator& rhs)  const { return pos_ < rhs.pos_; }
+  bool operator>(const row_iterator& rhs)  const { return pos_ > rhs.pos_; }
+  bool operator<=(const row_iterator& rhs) const { return pos_ <= rhs.pos_; }
+  bool operator>=(const row_iterator& rhs) const { return pos_ >= rhs.pos_; }
+};
+
+} // namespace soa_detail
+
+// 模板类: soa_vector
+// 模板参数 Fields 代表每一列的类型，所有列的大小始终相同，容量一起增长
+// 行引用是代理对象，迭代器只适合遍历，不能交给需要交换元素的算法（如 sort）
+template <class... Fields>
+class soa_vector
+{
+  static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+public:
+  // soa_vector 的嵌套型别定义
+  typedef std::tuple<Fields...>                    value_type;
+  typedef std::tuple<Fields&...>                   reference;
+  typedef std::tuple<const Fields&...>             const_reference;
+  typedef size_t                                   size_type;
+  typedef ptrdiff_t                                difference_type;
+
+  typedef soa_detail::row_iterator<soa_vector, reference>             iterator;
+  typedef soa_detail::row_iterator<const soa_vector, const_reference> const_iterator;
+
+  template <size_t I>
+  using field_type = typename std::tuple_element<I, value_type>::type;
+
+  static constexpr size_t field_count = sizeof...(Fields);
+
+private:
+  typedef soa_detail::make_index_sequence<sizeof...(Fields)> indices;
+
+  std::tuple<mystl::vector<Fields>...> cols_;  // 每个字段一列
+
+public:
+  // 构造、复制、移动、析构函数
+  soa_vector() = default;
+
+  explicit soa_vector(size_type n)
+  {
+    resize(n);
+  }
+
+  soa_vector(const soa_vector&) = default;
+  soa_vector(soa_vector&& rhs) noexcept
+    :cols_(mystl::move(rhs.cols_))
+  {
+  }
+
+  soa_vector& operator=(const soa_vector&) = default;
+  soa_vector& operator=(soa_vector&& rhs) noexcept
+  {
+    cols_ = mystl::move(rhs.cols_);
+    return *this;
+  }
+
+  ~soa_vector() = default;
+
+public:
+  // 迭代器相关操作
+  iterator       begin()        noexcept { return iterator(this, 0); }
+  const_iterator begin()  const noexcept { return const_iterator(this, 0); }
+  iterator       end()          noexcept { return iterator(this, size()); }
+  const_iterator end()    const noexcept { return const_iterator(this, size()); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend()   const noexcept { return end(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept { return size() == 0; }
+  size_type size()     const noexcept { return std::get<0>(cols_).size(); }
+  size_type max_size() const noexcept { return max_size_impl(indices()); }
+  size_type capacity() const noexcept { return capacity_impl(indices()); }
+  void      reserve(size_type n)      { reserve_impl(indices(), n); }
+  void      shrink_to_fit()           { shrink_impl(indices()); }
+
+  // 访问元素相关操作
+  reference       operator[](size_type n)
+  {
+    MYSTL_DEBUG(n < size());
+    return row_impl(indices(), n);
+  }
+  const_reference operator[](size_type n) const
+  {
+    MYSTL_DEBUG(n < size());
+    return row_impl(indices(), n);
+  }
+  reference       at(size_type n)
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "soa_vector<Fields...>::at() subscript out of range");
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "soa_vector<Fields...>::at() subscript out of range");
+    return (*this)[n];
+  }
+  reference       front()       { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference       back()        { return (*this)[size() - 1]; }
+  const_reference back()  const { return (*this)[size() - 1]; }
+
+  // 第 n 行的第 I 个字段
+  template <size_t I>
+  field_type<I>&       get(size_type n)
+  {
+    MYSTL_DEBUG(n < size());
+    return std::get<I>(cols_)[n];
+  }
+  template <size_t I>
+  const field_type<I>& get(size_type n) const
+  {
+    MYSTL_DEBUG(n < size());
+    return std::get<I>(cols_)[n];
+  }
+
+  // 第 I 列的连续视图，只能修改元素，不能改变大小
+  template <size_t I>
+  mystl::span<field_type<I>>       column() noexcept
+  { return mystl::span<field_type<I>>(std::get<I>(cols_).data(), size()); }
+  template <size_t I>
+  mystl::span<const field_type<I>> column() const noexcept
+  { return mystl::span<const field_type<I>>(std::get<I>(cols_).data(), size()); }
+
+  // 修改容器相关操作
+
+  // 按字段依次给出一行，每列各构造一个元素
+  template <class... Args>
+  void emplace_back(Args&& ...args)
+  {
+    static_assert(sizeof...(Args) == sizeof...(Fields),
+                  "soa_vector<Fields...>::emplace_back needs one argument per field");
+    if (size() == capacity())
+    { // 参数可能引用本容器中的元素，扩容前先构造出整行
+      value_type tmp(mystl::forward<Args>(args)...);
+      reserve(get_new_cap(1));
+      push_row(indices(), mystl::move(tmp));
+      return;
+    }
+    emplace_back_impl(indices(), mystl::forward<Args>(args)...);
+  }
+
+  void push_back(const Fields& ...fields)
+  { emplace_back(fields...); }
+
+  void push_back(const value_type& row)
+  { push_row(indices(), row); }
+  void push_back(value_type&& row)
+  { push_row(indices(), mystl::move(row)); }
+
+  void pop_back()
+  {
+    MYSTL_DEBUG(!empty());
+    pop_first(indices(), field_count);
+  }
+
+  // 删除第 pos 行，后面的行依次前移
+  void erase(size_type pos)
+  {
+    MYSTL_DEBUG(pos < size());
+    erase_impl(indices(), pos);
+  }
+
+  void resize(size_type n);
+  void clear() noexcept { clear_impl(indices()); }
+
+  void swap(soa_vector& rhs) noexcept
+  { swap_impl(indices(), rhs); }
+
+  friend bool operator==(const soa_vector& lhs, const soa_vector& rhs)
+  { return lhs.cols_ == rhs.cols_; }
+
+private:
+  // helper functions
+
+  size_type get_new_cap(size_type add_size) const
+  {
+    THROW_LENGTH_ERROR_IF(size() > max_size() - add_size, "soa_vector<Fields...>'s size too big");
+    return mystl::growth_1_5x::new_capacity(capacity(), size() + add_size, 0, max_size());
+  }
+
+  template <size_t... I>
+  size_type max_size_impl(soa_detail::index_sequence<I...>) const noexcept
+  {
+    size_type r = static_cast<size_type>(-1);
+    int dummy[] = { 0, (r = mystl::min(r, std::get<I>(cols_).max_size()), 0)... };
+    (void)dummy;
+    return r;
+  }
+
+  // reserve 中途失败时各列容量可能不同，取最小值
+  template <size_t... I>
+  size_type capacity_impl(soa_detail::index_sequence<I...>) const noexcept
+  {
+    size_type r = static_cast<size_type>(-1);
+    int dummy[] = { 0, (r = mystl::min(r, std::get<I>(cols_).capacity()), 0)... };
+    (void)dummy;
+    return r;
+  }
+
+  template <size_t... I>
+  void reserve_impl(soa_detail::index_sequence<I...>, size_type n)
+  {
+    int dummy[] = { 0, (std::get<I>(cols_).reserve(n), 0)... };
+    (void)dummy;
+  }
+
+  template <size_t... I>
+  void shrink_impl(soa_detail::index_sequence<I...>)
+  {
+    int dummy[] = { 0, (std::get<I>(cols_).shrink_to_fit(), 0)... };
+    (void)dummy;
+  }
+
+  template <size_t... I>
+  reference row_impl(soa_detail::index_sequence<I...>, size_type n)
+  { return reference(std::get<I>(cols_)[n]...); }
+
+  template <size_t... I>
+  const_reference row_impl(soa_detail::index_sequence<I...>, size_type n) const
+  { return const_reference(std::get<I>(cols_)[n]...); }
+
+  // 容量已经足够，逐列构造；某一列抛出异常时撤销已经构造的列
+  template <size_t... I, class... Args>
+  void emplace_back_impl(soa_detail::index_sequence<I...>, Args&& ...args)
+  {
+    size_type done = 0;
+    try
+    {
+      int dummy[] = { 0, (std::get<I>(cols_).emplace_back_unchecked(mystl::forward<Args>(args)), ++done, 0)... };
+      (void)dummy;
+    }
+    catch (...)
+    {
+      pop_first(indices(), done);
+      throw;
+    }
+  }
+
+  template <size_t... I>
+  void push_row(soa_detail::index_sequence<I...>, const value_type& row)
+  { emplace_back(std::get<I>(row)...); }
+
+  template <size_t... I>
+  void push_row(soa_detail::index_sequence<I...>, value_type&& row)
+  { emplace_back(std::get<I>(mystl::move(row))...); }
+
+  // 前 n 列各弹出最后一个元素
+  template <size_t... I>
+  void pop_first(soa_detail::index_sequence<I...>, size_type n)
+  {
+    int dummy[] = { 0, (I < n ? (std::get<I>(cols_).pop_back(), 0) : 0)... };
+    (void)dummy;
+  }
+
+  template <size_t... I>
+  void erase_impl(soa_detail::index_sequence<I...>, size_type pos)
+  {
+    int dummy[] = { 0, (std::get<I>(cols_).erase(std::get<I>(cols_).begin() + pos), 0)... };
+    (void)dummy;
+  }
+
+  template <size_t... I>
+  void resize_impl(soa_detail::index_sequence<I...>, size_type n)
+  {
+    int dummy[] = { 0, (std::get<I>(cols_).resize(n), 0)... };
+    (void)dummy;
+  }
+
+  template <size_t... I>
+  void clear_impl(soa_detail::index_sequence<I...>) noexcept
+  {
+    int dummy[] = { 0, (std::get<I>(cols_).clear(), 0)... };
+    (void)dummy;
+  }
+
+  template <size_t... I>
+  void swap_impl(soa_detail::index_sequence<I...>, soa_vector& rhs) noexcept
+  {
+    int dummy[] = { 0, (std::get<I>(cols_).swap(std::get<I>(rhs.cols_)), 0)... };
+    (void)dummy;
+  }
+};
+
+/*****************************************************************************************/
+
+template <class... Fields>
+constexpr size_t soa_vector<Fields...>::field_count;
+
+// 重置行数，先一起预留空间；某一列构造新元素时抛出异常，各列都恢复原来的大小
+template <class... Fields>
+void soa_vector<Fields...>::resize(size_type n)
+{
+  const size_type old_size = size();
+  if (n > old_size)
+    reserve(n);
+  try
+  {
+    resize_impl(indices(), n);
+  }
+  catch (...)
+  {
+    if (n > old_size)
+      resize_impl(indices(), old_size);
+    throw;
+  }
+}
+
+template <class... Fields>
+bool operator!=(const soa_vector<Fields...>& lhs, const soa_vector<Fields...>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+// 重载 mystl 的 swap
+template <class... Fields>
+void swap(soa_vector<Fields...>& lhs, soa_vector<Fields...>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYSTL_SOA_VECTOR_H
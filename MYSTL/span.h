@@ -0,0 +1,117 @@
+#ifndef MYSTL_SPAN_H
+#define MYSTL_SPAN_H
+
+// 这个头文件包含一个模板类 span
+// span : 指向一段连续元素的视图，只保存指针和长度，不拥有元素
+// 用来把容器内部的连续区间交给按数组处理的代码（如向量化的循环）
+
+#include <cstddef>
+#include <type_traits>
+
+#include "iterator.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类: span
+// 模板参数 T 代表元素类型，只读视图使用 span<const T>
+template <class T>
+class span
+{
+public:
+  // span 的嵌套型别定义
+  typedef T                                        element_type;
+  typedef typename std::remove_cv<T>::type         value_type;
+  typedef T*                                       pointer;
+  typedef T&                                       reference;
+  typedef size_t                                   size_type;
+  typedef ptrdiff_t                                difference_type;
+
+  typedef T*                                       iterator;
+  typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+
+private:
+  pointer   data_;  // 起始位置
+  size_type size_;  // 元素个数
+
+public:
+  span() noexcept
+    :data_(nullptr), size_(0)
+  {
+  }
+
+  span(pointer first, size_type n) noexcept
+    :data_(first), size_(n)
+  {
+  }
+
+  span(pointer first, pointer last) noexcept
+    :data_(first), size_(static_cast<size_type>(last - first))
+  {
+  }
+
+  template <size_t N>
+  span(element_type (&arr)[N]) noexcept
+    :data_(arr), size_(N)
+  {
+  }
+
+  // span<T> 可以转换为 span<const T>
+  template <class U, typename std::enable_if<
+    std::is_convertible<U(*)[], T(*)[]>::value, int>::type = 0>
+  span(const span<U>& rhs) noexcept
+    :data_(rhs.data()), size_(rhs.size())
+  {
+  }
+
+public:
+  // 迭代器相关操作
+  iterator         begin()  const noexcept { return data_; }
+  iterator         end()    const noexcept { return data_ + size_; }
+  reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend()   const noexcept { return reverse_iterator(begin()); }
+
+  // 容量相关操作
+  bool      empty()      const noexcept { return size_ == 0; }
+  size_type size()       const noexcept { return size_; }
+  size_type size_bytes() const noexcept { return size_ * sizeof(T); }
+
+  // 访问元素相关操作
+  reference operator[](size_type n) const
+  {
+    MYSTL_DEBUG(n < size_);
+    return data_[n];
+  }
+  reference front() const
+  {
+    MYSTL_DEBUG(size_ != 0);
+    return data_[0];
+  }
+  reference back() const
+  {
+    MYSTL_DEBUG(size_ != 0);
+    return data_[size_ - 1];
+  }
+  pointer   data() const noexcept { return data_; }
+
+  // 子视图
+  span first(size_type n) const
+  {
+    MYSTL_DEBUG(n <= size_);
+    return span(data_, n);
+  }
+  span last(size_type n) const
+  {
+    MYSTL_DEBUG(n <= size_);
+    return span(data_ + (size_ - n), n);
+  }
+  span subspan(size_type offset, size_type n) const
+  {
+    MYSTL_DEBUG(offset <= size_ && n <= size_ - offset);
+    return span(data_ + offset, n);
+  }
+};
+
+} // namespace mystl
+#endif // !MYSTL_SPAN_H
@@ -0,0 +1,322 @@
+#ifndef MYSTL_SPSC_QUEUE_H
+#define MYSTL_SPSC_QUEUE_H
+
+// 这个头文件包含一个模板类 spsc_queue
+// spsc_queue : 单生产者单消费者的有界无锁队列，一个线程只调用 push 系列，另一个线程只调用 pop 系列
+// head / tail 分别只由一方写，放在不同的 cache line；每一方再缓存一份对方的下标，
+// 只有缓存的值显示队列满（空）时才去读对方的 cache line
+// 模板参数 Wait 为 true 时提供阻塞的 push / pop，等待时先退避再睡眠，两端在队列状态变化时通知对方；
+// 为 false 时没有任何额外开销
+
+#include <atomic>
+#include <type_traits>
+
+#include "allocator.h"
+#include "uninitialized.h"
+#include "iterator.h"
+#include "concurrency.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类: spsc_queue
+// 模板参数 T 代表类型，Wait 表示是否支持阻塞等待，Alloc 代表空间配置器，缺省使用 mystl::allocator
+template <class T, bool Wait = false, class Alloc = mystl::allocator<T>>
+class spsc_queue
+{
+public:
+  // spsc_queue 的嵌套型别定义
+  typedef Alloc                                    allocator_type;
+  typedef Alloc                                    data_allocator;
+
+  typedef T                                        value_type;
+  typedef T*                                       pointer;
+  typedef T&                                       reference;
+  typedef const T&                                 const_reference;
+  typedef size_t                                   size_type;
+
+private:
+  // 生产者写的部分
+  alignas(cache_line_size) std::atomic<size_type> tail_;  // 下一个写入位置，只增不减
+  size_type head_cache_;                                  // 生产者缓存的 head
+
+  // 消费者写的部分
+  alignas(cache_line_size) std::atomic<size_type> head_;  // 下一个读出位置，只增不减
+  size_type tail_cache_;                                  // 消费者缓存的 tail
+
+  // 只读的部分
+  alignas(cache_line_size) pointer buf_;
+  size_type      cap_;   // 容量，2 的幂
+  data_allocator alloc_;
+
+  event_count    not_empty_;  // 消费者在此等待
+  event_count    not_full_;   // 生产者在此等待
+
+public:
+  // 容量向上取整到 2 的幂
+  explicit spsc_queue(size_type capacity, const allocator_type& alloc = allocator_type())
+    :tail_(0), head_cache_(0), head_(0), tail_cache_(0), buf_(nullptr), cap_(1), alloc_(alloc)
+  {
+    THROW_LENGTH_ERROR_IF(capacity > (static_cast<size_type>(-1) >> 1) / sizeof(T) + 1,
+                          "spsc_queue<T>'s capacity too big");
+    while (cap_ < capacity)
+      cap_ <<= 1;
+    buf_ = alloc_.allocate(cap_);
+  }
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  // 析构时不能有线程仍在使用队列
+  ~spsc_queue()
+  {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    for (size_type h = head_.load(std::memory_order_relaxed); h != tail; ++h)
+      mystl::destroy(buf_ + (h & (cap_ - 1)));
+    alloc_.deallocate(buf_, cap_);
+  }
+
+public:
+  // 容量相关操作，size 和 empty 在另一方同时操作时只是近似值
+  size_type capacity() const noexcept { return cap_; }
+  size_type size() const noexcept
+  {
+    const size_type head = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - head;
+  }
+  bool      empty() const noexcept { return size() == 0; }
+
+  // 生产者调用 ----------------------------------------------------------------
+
+  // 队列已满时返回 false，不构造元素
+  template <class ...Args>
+  bool try_emplace(Args&& ...args)
+  {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == cap_)
+    {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == cap_)
+        return false;
+    }
+    mystl::construct(buf_ + (tail & (cap_ - 1)), mystl::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    if (Wait)
+      not_empty_.notify_all();
+    return true;
+  }
+
+  bool try_push(const value_type& value) { return try_emplace(value); }
+  bool try_push(value_type&& value)      { return try_emplace(mystl::move(value)); }
+
+  // 从 first 开始放入至多 n 个元素，返回放入的个数，只发布一次 tail
+  // 第二段要从 first 重新前进，Iter 至少是前向迭代器
+  template <class Iter>
+  size_type try_push_n(Iter first, size_type n);
+
+  // 阻塞版本，队列满时先自旋再睡眠，只能在 Wait 为 true 时使用
+  template <class ...Args>
+  void emplace(Args&& ...args)
+  {
+    static_assert(Wait, "spsc_queue<T, false> does not support blocking operations");
+    for (backoff bo; !try_emplace(mystl::forward<Args>(args)...); )
+    { // try_emplace 失败时不会使用参数，可以再次转发
+      if (bo.pause())
+        continue;
+      const uint32_t key = not_full_.prepare_wait();
+      if (!full_for_producer())
+      {
+        not_full_.cancel_wait();
+        continue;
+      }
+      not_full_.commit_wait(key);
+    }
+  }
+
+  void push(const value_type& value) { emplace(value); }
+  void push(value_type&& value)      { emplace(mystl::move(value)); }
+
+  // 消费者调用 ----------------------------------------------------------------
+
+  // 队列为空时返回 false
+  bool try_pop(value_type& value)
+  {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_)
+    {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_)
+        return false;
+    }
+    pointer p = buf_ + (head & (cap_ - 1));
+    value = mystl::move(*p);
+    mystl::destroy(p);
+    head_.store(head + 1, std::memory_order_release);
+    if (Wait)
+      not_full_.notify_all();
+    return true;
+  }
+
+  // 队头元素的地址，队列为空时返回 nullptr；元素在 pop 之前一直有效
+  pointer front()
+  {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_)
+    {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_)
+        return nullptr;
+    }
+    return buf_ + (head & (cap_ - 1));
+  }
+
+  // 丢弃队头元素，调用前 front() 必须不为 nullptr
+  void pop()
+  {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    MYSTL_DEBUG(head != tail_cache_);
+    mystl::destroy(buf_ + (head & (cap_ - 1)));
+    head_.store(head + 1, std::memory_order_release);
+    if (Wait)
+      not_full_.notify_all();
+  }
+
+  // 取出至多 n 个元素移动到 result 开始的位置，返回取出的个数，只发布一次 head
+  template <class OutputIter>
+  size_type try_pop_n(OutputIter result, size_type n);
+
+  // 阻塞版本，队列空时先自旋再睡眠，只能在 Wait 为 true 时使用
+  void wait_pop(value_type& value)
+  {
+    static_assert(Wait, "spsc_queue<T, false> does not support blocking operations");
+    for (backoff bo; !try_pop(value); )
+    {
+      if (bo.pause())
+        continue;
+      const uint32_t key = not_empty_.prepare_wait();
+      if (!empty_for_consumer())
+      {
+        not_empty_.cancel_wait();
+        continue;
+      }
+      not_empty_.commit_wait(key);
+    }
+  }
+
+  // 等到至少有一个元素，再取出至多 n 个
+  template <class OutputIter>
+  size_type wait_pop_n(OutputIter result, size_type n)
+  {
+    static_assert(Wait, "spsc_queue<T, false> does not support blocking operations");
+    if (n == 0)
+      return 0;
+    for (backoff bo; ; )
+    {
+      const size_type got = try_pop_n(result, n);
+      if (got != 0)
+        return got;
+      if (bo.pause())
+        continue;
+      const uint32_t key = not_empty_.prepare_wait();
+      if (!empty_for_consumer())
+      {
+        not_empty_.cancel_wait();
+        continue;
+      }
+      not_empty_.commit_wait(key);
+    }
+  }
+
+private:
+  bool full_for_producer() noexcept
+  {
+    head_cache_ = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_relaxed) - head_cache_ == cap_;
+  }
+
+  bool empty_for_consumer() noexcept
+  {
+    tail_cache_ = tail_.load(std::memory_order_acquire);
+    return head_.load(std::memory_order_relaxed) == tail_cache_;
+  }
+};
+
+/*****************************************************************************************/
+
+// 空位在环上最多分成两段，逐段构造
+template <class T, bool Wait, class Alloc>
+template <class Iter>
+typename spsc_queue<T, Wait, Alloc>::size_type
+spsc_queue<T, Wait, Alloc>::try_push_n(Iter first, size_type n)
+{
+  static_assert(mystl::is_forward_iterator<Iter>::value,
+                "spsc_queue<T>::try_push_n requires a forward iterator");
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  if (cap_ - (tail - head_cache_) < n)
+    head_cache_ = head_.load(std::memory_order_acquire);
+  n = mystl::min(n, cap_ - (tail - head_cache_));
+  if (n == 0)
+    return 0;
+  const size_type pos = tail & (cap_ - 1);
+  const size_type len1 = mystl::min(n, cap_ - pos);
+  mystl::uninitialized_copy_n(first, len1, buf_ + pos);
+  if (len1 != n)
+  {
+    try
+    {
+      mystl::advance(first, len1);
+      mystl::uninitialized_copy_n(first, n - len1, buf_);
+    }
+    catch (...)
+    {
+      mystl::destroy(buf_ + pos, buf_ + pos + len1);
+      throw;
+    }
+  }
+  tail_.store(tail + n, std::memory_order_release);
+  if (Wait)
+    not_empty_.notify_all();
+  return n;
+}
+
+// 逐个移动后析构，写入 result 时抛出异常则只发布已取出的部分，其余元素留在队列中
+template <class T, bool Wait, class Alloc>
+template <class OutputIter>
+typename spsc_queue<T, Wait, Alloc>::size_type
+spsc_queue<T, Wait, Alloc>::try_pop_n(OutputIter result, size_type n)
+{
+  const size_type head = head_.load(std::memory_order_relaxed);
+  if (tail_cache_ - head < n)
+    tail_cache_ = tail_.load(std::memory_order_acquire);
+  n = mystl::min(n, tail_cache_ - head);
+  if (n == 0)
+    return 0;
+  size_type moved = 0;
+  try
+  {
+    while (moved < n)
+    {
+      pointer p = buf_ + ((head + moved) & (cap_ - 1));
+      *result = mystl::move(*p);
+      mystl::destroy(p);
+      ++moved;
+      ++result;
+    }
+  }
+  catch (...)
+  {
+    head_.store(head + moved, std::memory_order_release);
+    if (Wait)
+      not_full_.notify_all();
+    throw;
+  }
+  head_.store(head + n, std::memory_order_release);
+  if (Wait)
+    not_full_.notify_all();
+  return n;
+}
+
+} // namespace mystl
+#endif // !MYSTL_SPSC_QUEUE_H
@@ -0,0 +1,510 @@
+#ifndef MYSTL_STATIC_VECTOR_H
+#define MYSTL_STATIC_VECTOR_H
+
+// 这个头文件包含一个模板类 static_vector
+// static_vector : 容量固定为 N 的 vector，元素存放在对象内部的数组中，从不分配内存
+// 超出容量的操作抛出 std::length_error；热点路径上可以先用 full() 判断，或使用 try_push_back / try_emplace_back
+
+#include <initializer_list>
+#include "uninitialized.h"
+#include "iterator.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类: static_vector
+// 模板参数 T 代表类型，N 代表容量
+template <class T, size_t N>
+class static_vector
+{
+  static_assert(N > 0, "static_vector needs a positive capacity");
+public:
+  // static_vector 的嵌套型别定义
+  typedef T                                        value_type;
+  typedef T*                                       pointer;
+  typedef const T*                                 const_pointer;
+  typedef T&                                       reference;
+  typedef const T&                                 const_reference;
+  typedef size_t                                   size_type;
+  typedef ptrdiff_t                                difference_type;
+
+  typedef value_type*                              iterator;
+  typedef const value_type*                        const_iterator;
+  typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+private:
+  typedef typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type storage_type;
+
+  storage_type buf_;   // 存放元素的空间
+  size_type    size_;  // 元素个数
+
+public:
+  // 构造、复制、移动、析构函数
+  static_vector() noexcept
+    :size_(0)
+  {
+  }
+
+  explicit static_vector(size_type n)
+    :size_(0)
+  {
+    check_capacity(n);
+    mystl::uninitialized_value_construct_n(data(), n);
+    size_ = n;
+  }
+
+  static_vector(size_type n, const value_type& value)
+    :size_(0)
+  {
+    check_capacity(n);
+    mystl::uninitialized_fill_n(data(), n, value);
+    size_ = n;
+  }
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  static_vector(Iter first, Iter last)
+    :size_(0)
+  {
+    insert(end(), first, last);
+  }
+
+  static_vector(std::initializer_list<value_type> ilist)
+    :size_(0)
+  {
+    insert(end(), ilist.begin(), ilist.end());
+  }
+
+  static_vector(const static_vector& rhs)
+    :size_(0)
+  {
+    mystl::uninitialized_copy(rhs.begin(), rhs.end(), data());
+    size_ = rhs.size_;
+  }
+
+  static_vector(static_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+    :size_(0)
+  {
+    mystl::uninitialized_move(rhs.begin(), rhs.end(), data());
+    size_ = rhs.size_;
+    rhs.clear();
+  }
+
+  static_vector& operator=(const static_vector& rhs)
+  {
+    if (this != &rhs)
+      assign(rhs.begin(), rhs.end());
+    return *this;
+  }
+
+  static_vector& operator=(static_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+  {
+    if (this != &rhs)
+    {
+      clear();
+      mystl::uninitialized_move(rhs.begin(), rhs.end(), data());
+      size_ = rhs.size_;
+      rhs.clear();
+    }
+    return *this;
+  }
+
+  static_vector& operator=(std::initializer_list<value_type> ilist)
+  {
+    assign(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  ~static_vector()
+  { clear(); }
+
+public:
+  // 迭代器相关操作
+  iterator               begin()         noexcept
+  { return data(); }
+  const_iterator         begin()   const noexcept
+  { return data(); }
+  iterator               end()           noexcept
+  { return data() + size_; }
+  const_iterator         end()     const noexcept
+  { return data() + size_; }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept
+  { return size_ == 0; }
+  bool      full()     const noexcept
+  { return size_ == N; }
+  size_type size()     const noexcept
+  { return size_; }
+  static constexpr size_type max_size() noexcept
+  { return N; }
+  static constexpr size_type capacity() noexcept
+  { return N; }
+  void      reserve(size_type n)
+  { check_capacity(n); }
+
+  // 访问元素相关操作
+  reference operator[](size_type n)
+  {
+    MYSTL_DEBUG(n < size());
+    return *(data() + n);
+  }
+  const_reference operator[](size_type n) const
+  {
+    MYSTL_DEBUG(n < size());
+    return *(data() + n);
+  }
+  reference at(size_type n)
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "static_vector<T, N>::at() subscript out of range");
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "static_vector<T, N>::at() subscript out of range");
+    return (*this)[n];
+  }
+
+  reference front()
+  {
+    MYSTL_DEBUG(!empty());
+    return *data();
+  }
+  const_reference front() const
+  {
+    MYSTL_DEBUG(!empty());
+    return *data();
+  }
+  reference back()
+  {
+    MYSTL_DEBUG(!empty());
+    return *(end() - 1);
+  }
+  const_reference back() const
+  {
+    MYSTL_DEBUG(!empty());
+    return *(end() - 1);
+  }
+
+  pointer       data()       noexcept { return reinterpret_cast<pointer>(&buf_); }
+  const_pointer data() const noexcept { return reinterpret_cast<const_pointer>(&buf_); }
+
+  // 修改容器相关操作
+  void assign(size_type n, const value_type& value)
+  {
+    check_capacity(n);
+    clear();
+    insert(end(), n, value);
+  }
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  void assign(Iter first, Iter last)
+  {
+    clear();
+    insert(end(), first, last);
+  }
+
+  void assign(std::initializer_list<value_type> ilist)
+  { assign(ilist.begin(), ilist.end()); }
+
+  // emplace / emplace_back
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&& ...args);
+
+  template <class... Args>
+  reference emplace_back(Args&& ...args)
+  {
+    check_capacity(size_ + 1);
+    mystl::construct(end(), mystl::forward<Args>(args)...);
+    ++size_;
+    return back();
+  }
+
+  // 容器已满时不构造元素，返回 nullptr，否则返回新元素的地址
+  template <class... Args>
+  pointer try_emplace_back(Args&& ...args)
+  {
+    if (full())
+      return nullptr;
+    mystl::construct(end(), mystl::forward<Args>(args)...);
+    ++size_;
+    return end() - 1;
+  }
+
+  // push_back / pop_back
+  void push_back(const value_type& value)
+  { emplace_back(value); }
+  void push_back(value_type&& value)
+  { emplace_back(mystl::move(value)); }
+
+  bool try_push_back(const value_type& value)
+  { return try_emplace_back(value) != nullptr; }
+  bool try_push_back(value_type&& value)
+  { return try_emplace_back(mystl::move(value)) != nullptr; }
+
+  void pop_back()
+  {
+    MYSTL_DEBUG(!empty());
+    mystl::destroy(end() - 1);
+    --size_;
+  }
+
+  // insert
+  iterator insert(const_iterator pos, const value_type& value)
+  { return emplace(pos, value); }
+  iterator insert(const_iterator pos, value_type&& value)
+  { return emplace(pos, mystl::move(value)); }
+  iterator insert(const_iterator pos, size_type n, const value_type& value);
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  iterator insert(const_iterator pos, Iter first, Iter last);
+  iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+  { return insert(pos, ilist.begin(), ilist.end()); }
+
+  // erase / clear
+  iterator erase(const_iterator pos)
+  { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last);
+  void     clear() noexcept
+  {
+    mystl::destroy(begin(), end());
+    size_ = 0;
+  }
+
+  // resize
+  void resize(size_type new_size);
+  void resize(size_type new_size, const value_type& value);
+
+  void swap(static_vector& rhs);
+
+private:
+  static void check_capacity(size_type n)
+  {
+    THROW_LENGTH_ERROR_IF(n > N, "static_vector<T, N>'s capacity exceeded");
+  }
+};
+
+/*****************************************************************************************/
+
+// emplace 函数：在 pos 处构造元素
+template <class T, size_t N>
+template <class ...Args>
+typename static_vector<T, N>::iterator
+static_vector<T, N>::emplace(const_iterator pos, Args&& ...args)
+{
+  MYSTL_DEBUG(pos >= begin() && pos <= end());
+  const size_type xpos = pos - begin();
+  if (xpos == size_)
+  {
+    emplace_back(mystl::forward<Args>(args)...);
+    return begin() + xpos;
+  }
+  check_capacity(size_ + 1);
+  value_type tmp(mystl::forward<Args>(args)...);  // 参数可能引用要后移的元素，先构造出来
+  iterator p = begin() + xpos;
+  iterator old_end = end();
+  mystl::construct(old_end, mystl::move(*(old_end - 1)));
+  ++size_;
+  mystl::move_backward(p, old_end - 1, old_end);
+  *p = mystl::move(tmp);
+  return p;
+}
+
+// insert 函数：在 pos 处插入 n 个 value
+template <class T, size_t N>
+typename static_vector<T, N>::iterator
+static_vector<T, N>::insert(const_iterator pos, size_type n, const value_type& value)
+{
+  MYSTL_DEBUG(pos >= begin() && pos <= end());
+  iterator p = begin() + (pos - begin());
+  if (n == 0)
+    return p;
+  check_capacity(size_ + n);
+  const value_type value_copy = value;  // 避免被覆盖
+  const size_type after_elems = end() - p;
+  iterator old_end = end();
+  if (after_elems > n)
+  {
+    mystl::uninitialized_move(old_end - n, old_end, old_end);
+    size_ += n;
+    mystl::move_backward(p, old_end - n, old_end);
+    mystl::fill_n(p, n, value_copy);
+  }
+  else
+  {
+    mystl::uninitialized_fill_n(old_end, n - after_elems, value_copy);
+    size_ += n - after_elems;
+    mystl::uninitialized_move(p, old_end, p + n);
+    size_ += after_elems;
+    mystl::fill(p, old_end, value_copy);
+  }
+  return p;
+}
+
+// insert 函数：在 pos 处插入 [first, last)
+template <class T, size_t N>
+template <class Iter, typename std::enable_if<
+  mystl::is_input_iterator<Iter>::value, int>::type>
+typename static_vector<T, N>::iterator
+static_vector<T, N>::insert(const_iterator pos, Iter first, Iter last)
+{
+  MYSTL_DEBUG(pos >= begin() && pos <= end());
+  iterator p = begin() + (pos - begin());
+  const size_type n = static_cast<size_type>(mystl::distance(first, last));
+  if (n == 0)
+    return p;
+  check_capacity(size_ + n);
+  const size_type after_elems = end() - p;
+  iterator old_end = end();
+  if (after_elems > n)
+  {
+    mystl::uninitialized_move(old_end - n, old_end, old_end);
+    size_ += n;
+    mystl::move_backward(p, old_end - n, old_end);
+    mystl::copy(first, last, p);
+  }
+  else
+  {
+    auto mid = first;
+    mystl::advance(mid, after_elems);
+    mystl::uninitialized_copy(mid, last, old_end);
+    size_ += n - after_elems;
+    mystl::uninitialized_move(p, old_end, p + n);
+    size_ += after_elems;
+    mystl::copy(first, mid, p);
+  }
+  return p;
+}
+
+// erase 函数：删除 [first, last) 上的元素
+template <class T, size_t N>
+typename static_vector<T, N>::iterator
+static_vector<T, N>::erase(const_iterator first, const_iterator last)
+{
+  MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+  iterator p = begin() + (first - begin());
+  if (first == last)
+    return p;
+  auto new_end = mystl::move(p + (last - first), end(), p);
+  mystl::destroy(new_end, end());
+  size_ = new_end - begin();
+  return p;
+}
+
+// resize 函数
+template <class T, size_t N>
+void static_vector<T, N>::resize(size_type new_size)
+{
+  check_capacity(new_size);
+  if (new_size < size_)
+  {
+    erase(begin() + new_size, end());
+    return;
+  }
+  mystl::uninitialized_value_construct_n(end(), new_size - size_);
+  size_ = new_size;
+}
+
+template <class T, size_t N>
+void static_vector<T, N>::resize(size_type new_size, const value_type& value)
+{
+  check_capacity(new_size);
+  if (new_size < size_)
+    erase(begin() + new_size, end());
+  else
+    insert(end(), new_size - size_, value);
+}
+
+// swap 函数：交换公共部分的元素，多出的部分移动过去
+template <class T, size_t N>
+void static_vector<T, N>::swap(static_vector& rhs)
+{
+  if (this == &rhs)
+    return;
+  static_vector* longer = size_ < rhs.size_ ? &rhs : this;
+  static_vector* shorter = longer == this ? &rhs : this;
+  const size_type common = shorter->size_;
+  for (size_type i = 0; i < common; ++i)
+    mystl::swap((*this)[i], rhs[i]);
+  mystl::uninitialized_move(longer->begin() + common, longer->end(), shorter->end());
+  mystl::destroy(longer->begin() + common, longer->end());
+  shorter->size_ = longer->size_;
+  longer->size_ = common;
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+
+template <class T, size_t N>
+bool operator==(const static_vector<T, N>& lhs, const static_vector<T, N>& rhs)
+{
+  return lhs.size() == rhs.size() &&
+    mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N>
+bool operator<(const static_vector<T, N>& lhs, const static_vector<T, N>& rhs)
+{
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N>
+bool operator!=(const static_vector<T, N>& lhs, const static_vector<T, N>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class T, size_t N>
+bool operator>(const static_vector<T, N>& lhs, const static_vector<T, N>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class T, size_t N>
+bool operator<=(const static_vector<T, N>& lhs, const static_vector<T, N>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class T, size_t N>
+bool operator>=(const static_vector<T, N>& lhs, const static_vector<T, N>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 元素保存在对象内部，只用下标记录大小，元素可以按字节搬移时整个对象也可以
+template <class T, size_t N>
+struct is_trivially_relocatable<static_vector<T, N>>
+  : std::integral_constant<bool, is_trivially_relocatable<T>::value> {};
+
+// 重载 mystl 的 swap
+template <class T, size_t N>
+void swap(static_vector<T, N>& lhs, static_vector<T, N>& rhs)
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYSTL_STATIC_VECTOR_H
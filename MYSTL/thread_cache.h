@@ -0,0 +1,312 @@
+#ifndef MYSTL_THREAD_CACHE_H
+#define MYSTL_THREAD_CACHE_H
+
+// 这个头文件包含 mystl::allocator 前端的线程缓存
+// 小块内存按 16 字节分级，每个线程持有各级的空闲链表，分配和释放在本线程内完成，不需要加锁；
+// 本地链表为空或过长时，与全局的 central_cache 成批交换，只在交换时加锁
+// 所有小块都来自 central_cache，因此一个线程释放另一个线程分配的块时直接放入自己的缓存即可
+
+#include <new>
+#include <cstddef>
+#include <mutex>
+
+namespace mystl
+{
+
+namespace tc_detail
+{
+
+const size_t tc_align     = 16;                   // 分级粒度，也是块的对齐
+const size_t tc_max_bytes = 1024;                 // 超过这个大小的请求直接走 operator new
+const size_t tc_classes   = tc_max_bytes / tc_align;
+const size_t tc_span_batches = 8;                 // 每次向系统申请的内存可以切出的批数
+
+// 空闲块，next 串起同一批中的块，next_batch 只在每批的第一个块上有意义
+struct free_block
+{
+  free_block* next;
+  free_block* next_batch;
+};
+
+inline size_t class_index(size_t bytes) noexcept
+{
+  return (bytes + tc_align - 1) / tc_align - 1;
+}
+
+inline size_t class_size(size_t index) noexcept
+{
+  return (index + 1) * tc_align;
+}
+
+// 每批的块数，小块多一些，大块少一些，一批大约 8KB
+inline size_t batch_count(size_t index) noexcept
+{
+  const size_t n = 8192 / class_size(index);
+  return n < 4 ? 4 : (n > 64 ? 64 : n);
+}
+
+// 类 central_cache
+// 每一级保存两个链表：整批的 batches 和不足一批的 loose，每一级一把锁
+class central_cache
+{
+private:
+  struct size_class
+  {
+    std::mutex  lock;
+    free_block* batches;
+    free_block* loose;
+    size_t      loose_count;
+  };
+
+public:
+  // 对象有意不析构：其它静态对象或线程在退出时仍可能归还内存
+  static central_cache& instance()
+  {
+    static central_cache* c = new central_cache;
+    return *c;
+  }
+
+  // 取出一批块，通过 count 返回块数
+  free_block* fetch(size_t index, size_t& count)
+  {
+    size_class& sc = classes_[index];
+    {
+      std::lock_guard<std::mutex> guard(sc.lock);
+      if (sc.batches != nullptr)
+      {
+        free_block* batch = sc.batches;
+        sc.batches = batch->next_batch;
+        count = batch_count(index);
+        return batch;
+      }
+      if (sc.loose != nullptr)
+      {
+        free_block* list = sc.loose;
+        count = sc.loose_count;
+        sc.loose = nullptr;
+        sc.loose_count = 0;
+        return list;
+      }
+    }
+    return carve(index, count);
+  }
+
+  // 归还整批的块，batch 的长度必须是 batch_count(index)
+  void release_batch(size_t index, free_block* batch)
+  {
+    size_class& sc = classes_[index];
+    std::lock_guard<std::mutex> guard(sc.lock);
+    batch->next_batch = sc.batches;
+    sc.batches = batch;
+  }
+
+  // 归还任意长度的链表，凑满一批时转入 batches
+  void release_list(size_t index, free_block* list)
+  {
+    const size_t n = batch_count(index);
+    size_class& sc = classes_[index];
+    std::lock_guard<std::mutex> guard(sc.lock);
+    while (list != nullptr)
+    {
+      free_block* next = list->next;
+      list->next = sc.loose;
+      sc.loose = list;
+      if (++sc.loose_count == n)
+      {
+        sc.loose->next_batch = sc.batches;
+        sc.batches = sc.loose;
+        sc.loose = nullptr;
+        sc.loose_count = 0;
+      }
+      list = next;
+    }
+  }
+
+private:
+  central_cache() noexcept
+  {
+    for (size_t i = 0; i < tc_classes; ++i)
+    {
+      classes_[i].batches = nullptr;
+      classes_[i].loose = nullptr;
+      classes_[i].loose_count = 0;
+    }
+  }
+
+  // 向系统申请一段内存，切成 tc_span_batches 批，留下一批返回，其余放入 batches
+  free_block* carve(size_t index, size_t& count)
+  {
+    const size_t size = class_size(index);
+    const size_t n = batch_count(index);
+    char* span = static_cast<char*>(::operator new(size * n * tc_span_batches));
+    free_block* first = nullptr;
+    free_block* rest = nullptr;
+    for (size_t b = 0; b < tc_span_batches; ++b)
+    {
+      char* base = span + b * n * size;
+      for (size_t i = 0; i < n; ++i)
+      {
+        free_block* blk = reinterpret_cast<free_block*>(base + i * size);
+        blk->next = i + 1 == n ? nullptr : reinterpret_cast<free_block*>(base + (i + 1) * size);
+      }
+      free_block* head = reinterpret_cast<free_block*>(base);
+      if (b == 0)
+      {
+        first = head;
+      }
+      else
+      {
+        head->next_batch = rest;
+        rest = head;
+      }
+    }
+    if (rest != nullptr)
+    {
+      size_class& sc = classes_[index];
+      std::lock_guard<std::mutex> guard(sc.lock);
+      free_block* tail = rest;
+      while (tail->next_batch != nullptr)
+        tail = tail->next_batch;
+      tail->next_batch = sc.batches;
+      sc.batches = rest;
+    }
+    count = n;
+    return first;
+  }
+
+private:
+  size_class classes_[tc_classes];
+};
+
+// 类 thread_cache
+// 每个线程一份，各级一个空闲链表；线程退出时把缓存的块全部还给 central_cache
+class thread_cache
+{
+private:
+  struct free_list
+  {
+    free_block* head;
+    size_t      count;
+  };
+
+public:
+  thread_cache() noexcept
+  {
+    for (size_t i = 0; i < tc_classes; ++i)
+    {
+      lists_[i].head = nullptr;
+      lists_[i].count = 0;
+    }
+  }
+
+  thread_cache(const thread_cache&) = delete;
+  thread_cache& operator=(const thread_cache&) = delete;
+
+  ~thread_cache()
+  {
+    central_cache& central = central_cache::instance();
+    for (size_t i = 0; i < tc_classes; ++i)
+    {
+      if (lists_[i].head != nullptr)
+        central.release_list(i, lists_[i].head);
+      lists_[i].head = nullptr;
+      lists_[i].count = 0;
+    }
+  }
+
+  void* allocate(size_t index)
+  {
+    free_list& l = lists_[index];
+    if (l.head == nullptr)
+      l.head = central_cache::instance().fetch(index, l.count);
+    free_block* p = l.head;
+    l.head = p->next;
+    --l.count;
+    return p;
+  }
+
+  // 本地链表超过两批时，把前一批还给 central_cache
+  void deallocate(void* ptr, size_t index)
+  {
+    free_list& l = lists_[index];
+    free_block* b = static_cast<free_block*>(ptr);
+    b->next = l.head;
+    l.head = b;
+    const size_t n = batch_count(index);
+    if (++l.count >= 2 * n)
+    {
+      free_block* tail = l.head;
+      for (size_t i = 1; i < n; ++i)
+        tail = tail->next;
+      free_block* batch = l.head;
+      l.head = tail->next;
+      l.count -= n;
+      tail->next = nullptr;
+      central_cache::instance().release_batch(index, batch);
+    }
+  }
+
+private:
+  free_list lists_[tc_classes];
+};
+
+// 线程缓存析构之后，同一线程内其它 thread_local 对象的析构仍可能分配或释放内存，
+// 此时直接与 central_cache 交换单个块
+inline bool& thread_cache_dead() noexcept
+{
+  static thread_local bool dead = false;
+  return dead;
+}
+
+struct thread_cache_holder
+{
+  thread_cache cache;
+  ~thread_cache_holder() { thread_cache_dead() = true; }
+};
+
+inline thread_cache& local_cache()
+{
+  static thread_local thread_cache_holder holder;
+  return holder.cache;
+}
+
+} // namespace tc_detail
+
+// 按字节数分配，小块走线程缓存，大块走 operator new
+inline void* tc_allocate(size_t bytes)
+{
+  if (bytes > tc_detail::tc_max_bytes)
+    return ::operator new(bytes);
+  const size_t index = tc_detail::class_index(bytes == 0 ? 1 : bytes);
+  if (!tc_detail::thread_cache_dead())
+    return tc_detail::local_cache().allocate(index);
+  size_t count = 0;
+  tc_detail::free_block* list = tc_detail::central_cache::instance().fetch(index, count);
+  if (list->next != nullptr)
+    tc_detail::central_cache::instance().release_list(index, list->next);
+  return list;
+}
+
+// 释放时必须给出与分配时相同的字节数
+inline void tc_deallocate(void* ptr, size_t bytes)
+{
+  if (ptr == nullptr)
+    return;
+  if (bytes > tc_detail::tc_max_bytes)
+  {
+    ::operator delete(ptr);
+    return;
+  }
+  const size_t index = tc_detail::class_index(bytes == 0 ? 1 : bytes);
+  if (!tc_detail::thread_cache_dead())
+  {
+    tc_detail::local_cache().deallocate(ptr, index);
+    return;
+  }
+  tc_detail::free_block* b = static_cast<tc_detail::free_block*>(ptr);
+  b->next = nullptr;
+  tc_detail::central_cache::instance().release_list(index, b);
+}
+
+} // namespace mystl
+#endif // !MYSTL_THREAD_CACHE_H
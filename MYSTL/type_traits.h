@@ -39,6 +39,18 @@ struct is_pair : mystl::m_false_type {};
 template <class T1, class T2>
 struct is_pair<mystl::pair<T1, T2>> : mystl::m_true_type {};
 
+// is_trivially_relocatable
+// 对象可以按字节复制到新地址，复制之后原对象直接视为不存在（不再调用析构函数）
+// 可平凡复制的类型天然满足；不含指向自身的指针的类型（如 mystl 的各个容器）可以特化为 true
+template <class T>
+struct is_trivially_relocatable
+  : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+template <class T1, class T2>
+struct is_trivially_relocatable<mystl::pair<T1, T2>>
+  : std::integral_constant<bool, is_trivially_relocatable<T1>::value &&
+                                 is_trivially_relocatable<T2>::value> {};
+
 } // namespace mystl
 
 #endif // !MYTINYSTL_TYPE_TRAITS_H_
@@ -9,6 +9,8 @@
 #include "type_traits.h"
 #include "util.h"
 
+#include <cstring>
+
 namespace mystl
 {
 
@@ -39,6 +41,7 @@ unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::
   {
     for (; result != cur; ++result)
       mystl::destroy(&*result);
+    throw;
   }
   return cur;
 }
@@ -79,6 +82,7 @@ unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::false_
   {
     for (; result != cur; ++result)
       mystl::destroy(&*result);
+    throw;
   }
   return cur;
 }
@@ -119,6 +123,7 @@ unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::
   {
     for (;first != cur; ++first)
       mystl::destroy(&*first);
+    throw;
   }
 }
 
@@ -158,6 +163,7 @@ unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::false_ty
   {
     for (; first != cur; ++first)
       mystl::destroy(&*first);
+    throw;
   }
   return cur;
 }
@@ -197,6 +203,7 @@ unchecked_uninit_move(InputIter first, InputIter last, ForwardIter result, std::
   catch (...)
   {
     mystl::destroy(result, cur);
+    throw;
   }
   return cur;
 }
@@ -251,6 +258,134 @@ ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result)
                                         value_type>{});
 }
 
+/*****************************************************************************************/
+// uninitialized_default_construct
+// 在 [first, first + n) 上默认初始化对象，返回结束的位置
+// 可平凡默认构造的类型什么也不做，内容保持原样，适合随后被整块写满的缓冲区
+/*****************************************************************************************/
+template <class ForwardIter, class Size>
+ForwardIter
+unchecked_uninit_default_construct_n(ForwardIter first, Size n, std::true_type)
+{
+  mystl::advance(first, n);
+  return first;
+}
+
+template <class ForwardIter, class Size>
+ForwardIter
+unchecked_uninit_default_construct_n(ForwardIter first, Size n, std::false_type)
+{
+  typedef typename iterator_traits<ForwardIter>::value_type value_type;
+  auto cur = first;
+  try
+  {
+    for (; n > 0; --n, ++cur)
+    {
+      ::new ((void*)&*cur) value_type;
+    }
+  }
+  catch (...)
+  {
+    mystl::destroy(first, cur);
+    throw;
+  }
+  return cur;
+}
+
+template <class ForwardIter, class Size>
+ForwardIter uninitialized_default_construct_n(ForwardIter first, Size n)
+{
+  return mystl::unchecked_uninit_default_construct_n(first, n,
+                                                     std::is_trivially_default_constructible<
+                                                     typename iterator_traits<ForwardIter>::
+                                                     value_type>{});
+}
+
+template <class ForwardIter>
+void uninitialized_default_construct(ForwardIter first, ForwardIter last)
+{
+  mystl::uninitialized_default_construct_n(first, mystl::distance(first, last));
+}
+
+/*****************************************************************************************/
+// uninitialized_value_construct
+// 在 [first, first + n) 上值初始化对象，返回结束的位置
+// 平凡类型直接填充 value_type()，即清零
+/*****************************************************************************************/
+template <class ForwardIter, class Size>
+ForwardIter
+unchecked_uninit_value_construct_n(ForwardIter first, Size n, std::true_type)
+{
+  typedef typename iterator_traits<ForwardIter>::value_type value_type;
+  return mystl::fill_n(first, n, value_type());
+}
+
+template <class ForwardIter, class Size>
+ForwardIter
+unchecked_uninit_value_construct_n(ForwardIter first, Size n, std::false_type)
+{
+  auto cur = first;
+  try
+  {
+    for (; n > 0; --n, ++cur)
+    {
+      mystl::construct(&*cur);
+    }
+  }
+  catch (...)
+  {
+    mystl::destroy(first, cur);
+    throw;
+  }
+  return cur;
+}
+
+template <class ForwardIter, class Size>
+ForwardIter uninitialized_value_construct_n(ForwardIter first, Size n)
+{
+  return mystl::unchecked_uninit_value_construct_n(first, n,
+                                                   std::is_trivial<
+                                                   typename iterator_traits<ForwardIter>::
+                                                   value_type>{});
+}
+
+template <class ForwardIter>
+void uninitialized_value_construct(ForwardIter first, ForwardIter last)
+{
+  mystl::uninitialized_value_construct_n(first, mystl::distance(first, last));
+}
+
+/*****************************************************************************************/
+// uninitialized_relocate
+// 把 [first, last) 上的对象搬到以 result 为起始处的未初始化空间，返回搬移结束的位置
+// 搬移之后原空间视为未初始化，调用者不能再析构其中的对象；两段空间可以重叠
+// 可平凡搬移的类型直接 memmove，其余类型逐个移动构造再析构原对象（不能重叠）
+/*****************************************************************************************/
+template <class T>
+T* unchecked_uninit_relocate(T* first, T* last, T* result, std::true_type)
+{
+  const size_t n = static_cast<size_t>(last - first);
+  if (n != 0)
+    std::memmove(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(T));
+  return result + n;
+}
+
+template <class T>
+T* unchecked_uninit_relocate(T* first, T* last, T* result, std::false_type)
+{
+  T* cur = mystl::uninitialized_move(first, last, result);
+  mystl::destroy(first, last);
+  return cur;
+}
+
+template <class T>
+T* uninitialized_relocate(T* first, T* last, T* result)
+{
+  return mystl::unchecked_uninit_relocate(first, last, result,
+                                          std::integral_constant<bool,
+                                          is_trivially_relocatable<T>::value>{});
+}
+
 } // namespace mystl
 #endif // !MYTINYSTL_UNINITIALIZED_H_
 
@@ -11,12 +11,14 @@ namespace mystl
 // 模板类 unordered_map, 键值不允许重复
 // 参数一代表键值类型， 参数二代表实值类型， 参数三代表哈希函数， 缺省使用mystl::hash
 // 参数四代表键值比较方式， 缺省使用mystl::equal_to
-template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key> >
+// 参数五代表空间配置器， 缺省使用mystl::allocator
+template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>,
+          class Alloc = mystl::allocator<mystl::pair<const Key, T>>>
 class unordered_map
 {
 private:
     // 使用 hashtable 作为底层机制
-    typedef hashtable<mystl::pair<const Key, T>, Hash, KeyEqual> base_type;
+    typedef hashtable<mystl::pair<const Key, T>, Hash, KeyEqual, Alloc> base_type;
     // hashtable 的一个对象
     base_type ht_;
 
@@ -48,10 +50,15 @@ public:
         :ht_(100, Hash(), KeyEqual())
     {
     }
+    explicit unordered_map(const allocator_type& alloc)
+        :ht_(100, Hash(), KeyEqual(), alloc)
+    {
+    }
     explicit unordered_map(size_type bucket_count,
                            const Hash& hash = Hash(),
-                           const KeyEqual& equal = KeyEqual())
-        :ht_(bucket_count, hash, equal)
+                           const KeyEqual& equal = KeyEqual(),
+                           const allocator_type& alloc = allocator_type())
+        :ht_(bucket_count, hash, equal, alloc)
     {
     }
 
@@ -59,8 +66,9 @@ public:
     unordered_map(InputIterator first, InputIterator last,
                   const size_type bucket_count = 100,
                   const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
-        : ht_(mystl::max(bucket_count, static_cast<size_type>(mystl::distance(first, last))), hash, equal)
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(mystl::max(bucket_count, static_cast<size_type>(mystl::distance(first, last))), hash, equal, alloc)
     {
         for(; first != last; ++first)
             ht_.insert_unique_noresize(*first);
@@ -69,8 +77,9 @@ public:
     unordered_map(std::initializer_list<value_type> ilist,
                   const size_type bucket_count = 100,
                   const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
-    :ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+    :ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
     {
         for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
             ht_.insert_unique_noresize(*first);
@@ -268,24 +277,31 @@ public:
 };
 
     // 重载比较操作符
-    template <class Key, class T, class Hash, class KeyEqual>
-    bool operator==(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-                    const unordered_map<Key, T, Hash, KeyEqual>& rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                    const unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs)
     {
     return lhs == rhs;
     }
 
-    template <class Key, class T, class Hash, class KeyEqual>
-    bool operator!=(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-                    const unordered_map<Key, T, Hash, KeyEqual>& rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                    const unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs)
     {
     return lhs != rhs;
     }
 
+    // 与底层的 hashtable 相同
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    struct is_trivially_relocatable<unordered_map<Key, T, Hash, KeyEqual, Alloc>>
+      : std::integral_constant<bool, is_trivially_relocatable<Hash>::value &&
+                                     is_trivially_relocatable<KeyEqual>::value &&
+                                     is_trivially_relocatable<Alloc>::value> {};
+
     // 重载 mystl 的 swap
-    template <class Key, class T, class Hash, class KeyEqual>
-    void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
-            unordered_map<Key, T, Hash, KeyEqual>& rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+            unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs)
     {
     lhs.swap(rhs);
     }
@@ -295,12 +311,14 @@ public:
 // 模板类 unordered_multimap，键值允许重复
 // 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，缺省使用 mystl::hash
 // 参数四代表键值比较方式，缺省使用 mystl::equal_to
-template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+// 参数五代表空间配置器，缺省使用 mystl::allocator
+template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>,
+          class Alloc = mystl::allocator<mystl::pair<const Key, T>>>
 class unordered_multimap
 {
 private:
     // 使用 hashtable 作为底层机制
-    typedef hashtable<pair<const Key, T>, Hash, KeyEqual> base_type;
+    typedef hashtable<mystl::pair<const Key, T>, Hash, KeyEqual, Alloc> base_type;
     base_type ht_;
 
     public:
@@ -333,11 +351,16 @@ private:
         :ht_(100, Hash(), KeyEqual())
     {
     }
+    explicit unordered_multimap(const allocator_type& alloc)
+        :ht_(100, Hash(), KeyEqual(), alloc)
+    {
+    }
 
     explicit unordered_multimap(size_type bucket_count,
                                 const Hash& hash = Hash(),
-                                const KeyEqual& equal = KeyEqual())
-        :ht_(bucket_count, hash, equal) 
+                                const KeyEqual& equal = KeyEqual(),
+                                const allocator_type& alloc = allocator_type())
+        :ht_(bucket_count, hash, equal, alloc)
     {
     }
 
@@ -345,8 +368,9 @@ private:
     unordered_multimap(InputIterator first, InputIterator last,
                         const size_type bucket_count = 100,
                         const Hash& hash = Hash(),
-                        const KeyEqual& equal = KeyEqual())
-        :ht_(mystl::max(bucket_count, static_cast<size_type>(mystl::distance(first, last))), hash, equal)
+                        const KeyEqual& equal = KeyEqual(),
+                        const allocator_type& alloc = allocator_type())
+        :ht_(mystl::max(bucket_count, static_cast<size_type>(mystl::distance(first, last))), hash, equal, alloc)
     {
         for (; first != last; ++first)
         ht_.insert_multi_noresize(*first);
@@ -355,8 +379,9 @@ private:
     unordered_multimap(std::initializer_list<value_type> ilist,
                         const size_type bucket_count = 100,
                         const Hash& hash = Hash(),
-                        const KeyEqual& equal = KeyEqual())
-        :ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                        const KeyEqual& equal = KeyEqual(),
+                        const allocator_type& alloc = allocator_type())
+        :ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
     {
         for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
         ht_.insert_multi_noresize(*first);
@@ -525,24 +550,31 @@ private:
 };
 
     // 重载比较操作符
-    template <class Key, class T, class Hash, class KeyEqual>
-    bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-                    const unordered_multimap<Key, T, Hash, KeyEqual>& rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                    const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& rhs)
     {
     return lhs == rhs;
     }
 
-    template <class Key, class T, class Hash, class KeyEqual>
-    bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-                    const unordered_multimap<Key, T, Hash, KeyEqual>& rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                    const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& rhs)
     {
     return lhs != rhs;
     }
 
+    // 与底层的 hashtable 相同
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    struct is_trivially_relocatable<unordered_multimap<Key, T, Hash, KeyEqual, Alloc>>
+      : std::integral_constant<bool, is_trivially_relocatable<Hash>::value &&
+                                     is_trivially_relocatable<KeyEqual>::value &&
+                                     is_trivially_relocatable<Alloc>::value> {};
+
     // 重载 mystl 的 swap
-    template <class Key, class T, class Hash, class KeyEqual>
-    void swap(unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-            unordered_multimap<Key, T, Hash, KeyEqual>& rhs)
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    void swap(unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& lhs,
+            unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& rhs)
     {
     lhs.swap(rhs);
     } 
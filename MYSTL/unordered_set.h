@@ -13,12 +13,14 @@ namespace mystl
 // 模板类 unordered_set，键值不允许重复
 // 参数一代表键值类型，参数二代表哈希函数，缺省使用 mystl::hash，
 // 参数三代表键值比较方式，缺省使用 mystl::equal_to
-template <class Key, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+// 参数四代表空间配置器，缺省使用 mystl::allocator
+template <class Key, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>,
+          class Alloc = mystl::allocator<Key>>
 class unordered_set
 {
 private:
   // 使用 hashtable 作为底层机制
-  typedef hashtable<Key, Hash, KeyEqual> base_type;
+  typedef hashtable<Key, Hash, KeyEqual, Alloc> base_type;
   base_type ht_;
 
 public:
@@ -50,11 +52,16 @@ public:
     :ht_(100, Hash(), KeyEqual())
   {
   }
+  explicit unordered_set(const allocator_type& alloc)
+    :ht_(100, Hash(), KeyEqual(), alloc)
+  {
+  }
 
   explicit unordered_set(size_type bucket_count,
                          const Hash& hash = Hash(),
-                         const KeyEqual& equal = KeyEqual())
-    :ht_(bucket_count, hash, equal)
+                         const KeyEqual& equal = KeyEqual(),
+                         const allocator_type& alloc = allocator_type())
+    :ht_(bucket_count, hash, equal, alloc)
   {
   }
 
@@ -62,8 +69,9 @@ public:
   unordered_set(InputIterator first, InputIterator last,
                 const size_type bucket_count = 100,
                 const Hash& hash = Hash(),
-                const KeyEqual& equal = KeyEqual())
-    : ht_(mystl::max(bucket_count, static_cast<size_type>(mystl::distance(first, last))), hash, equal)
+                const KeyEqual& equal = KeyEqual(),
+                const allocator_type& alloc = allocator_type())
+    : ht_(mystl::max(bucket_count, static_cast<size_type>(mystl::distance(first, last))), hash, equal, alloc)
   {
     for (; first != last; ++first)
       ht_.insert_unique_noresize(*first);
@@ -72,8 +80,9 @@ public:
   unordered_set(std::initializer_list<value_type> ilist,
                 const size_type bucket_count = 100,
                 const Hash& hash = Hash(),
-                const KeyEqual& equal = KeyEqual())
-    :ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                const KeyEqual& equal = KeyEqual(),
+                const allocator_type& alloc = allocator_type())
+    :ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
   {
     for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
       ht_.insert_unique_noresize(*first);
@@ -244,23 +253,30 @@ public:
 
 // 重载比较操作符
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator==(const unordered_set<Key, Hash, KeyEqual>& lhs,
-                const unordered_set<Key, Hash, KeyEqual>& rhs)
+bool operator==(const unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_set<Key, Hash, KeyEqual, Alloc>& rhs)
 {
   return lhs == rhs;
 }
 
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator!=(const unordered_set<Key, Hash, KeyEqual>& lhs,
-                const unordered_set<Key, Hash, KeyEqual>& rhs)
+bool operator!=(const unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_set<Key, Hash, KeyEqual, Alloc>& rhs)
 {
   return lhs != rhs;
 }
 
+// 与底层的 hashtable 相同
+template <class Key, class Hash, class KeyEqual, class Alloc>
+struct is_trivially_relocatable<unordered_set<Key, Hash, KeyEqual, Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<Hash>::value &&
+                                 is_trivially_relocatable<KeyEqual>::value &&
+                                 is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
 template <class Key, class Hash, class KeyEqual, class Alloc>
-void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
-          unordered_set<Key, Hash, KeyEqual>& rhs)
+void swap(unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+          unordered_set<Key, Hash, KeyEqual, Alloc>& rhs)
 {
   lhs.swap(rhs);
 }
@@ -270,12 +286,14 @@ void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
 // 模板类 unordered_multiset，键值允许重复
 // 参数一代表键值类型，参数二代表哈希函数，缺省使用 mystl::hash，
 // 参数三代表键值比较方式，缺省使用 mystl::equal_to
-template <class Key, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+// 参数四代表空间配置器，缺省使用 mystl::allocator
+template <class Key, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>,
+          class Alloc = mystl::allocator<Key>>
 class unordered_multiset
 {
 private:
   // 使用 hashtable 作为底层机制
-  typedef hashtable<Key, Hash, KeyEqual> base_type;
+  typedef hashtable<Key, Hash, KeyEqual, Alloc> base_type;
   base_type ht_;
 
 public:
@@ -307,11 +325,16 @@ public:
     :ht_(100, Hash(), KeyEqual())
   {
   }
+  explicit unordered_multiset(const allocator_type& alloc)
+    :ht_(100, Hash(), KeyEqual(), alloc)
+  {
+  }
 
   explicit unordered_multiset(size_type bucket_count,
                               const Hash& hash = Hash(),
-                              const KeyEqual& equal = KeyEqual())
-    :ht_(bucket_count, hash, equal)
+                              const KeyEqual& equal = KeyEqual(),
+                              const allocator_type& alloc = allocator_type())
+    :ht_(bucket_count, hash, equal, alloc)
   {
   }
 
@@ -319,8 +342,9 @@ public:
   unordered_multiset(InputIterator first, InputIterator last,
                      const size_type bucket_count = 100,
                      const Hash& hash = Hash(),
-                     const KeyEqual& equal = KeyEqual())
-    : ht_(mystl::max(bucket_count, static_cast<size_type>(mystl::distance(first, last))), hash, equal)
+                     const KeyEqual& equal = KeyEqual(),
+                     const allocator_type& alloc = allocator_type())
+    : ht_(mystl::max(bucket_count, static_cast<size_type>(mystl::distance(first, last))), hash, equal, alloc)
   {
     for (; first != last; ++first)
       ht_.insert_multi_noresize(*first);
@@ -329,8 +353,9 @@ public:
   unordered_multiset(std::initializer_list<value_type> ilist,
                      const size_type bucket_count = 100,
                      const Hash& hash = Hash(),
-                     const KeyEqual& equal = KeyEqual())
-    :ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                     const KeyEqual& equal = KeyEqual(),
+                     const allocator_type& alloc = allocator_type())
+    :ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
   {
     for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
       ht_.insert_multi_noresize(*first);
@@ -501,23 +526,30 @@ public:
 
 // 重载比较操作符
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator==(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
-                const unordered_multiset<Key, Hash, KeyEqual>& rhs)
+bool operator==(const unordered_multiset<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_multiset<Key, Hash, KeyEqual, Alloc>& rhs)
 {
   return lhs == rhs;
 }
 
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator!=(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
-                const unordered_multiset<Key, Hash, KeyEqual>& rhs)
+bool operator!=(const unordered_multiset<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_multiset<Key, Hash, KeyEqual, Alloc>& rhs)
 {
   return lhs != rhs;
 }
 
+// 与底层的 hashtable 相同
+template <class Key, class Hash, class KeyEqual, class Alloc>
+struct is_trivially_relocatable<unordered_multiset<Key, Hash, KeyEqual, Alloc>>
+  : std::integral_constant<bool, is_trivially_relocatable<Hash>::value &&
+                                 is_trivially_relocatable<KeyEqual>::value &&
+                                 is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
 template <class Key, class Hash, class KeyEqual, class Alloc>
-void swap(unordered_multiset<Key, Hash, KeyEqual>& lhs,
-          unordered_multiset<Key, Hash, KeyEqual>& rhs)
+void swap(unordered_multiset<Key, Hash, KeyEqual, Alloc>& lhs,
+          unordered_multiset<Key, Hash, KeyEqual, Alloc>& rhs)
 {
   lhs.swap(rhs);
 }
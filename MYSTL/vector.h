@@ -12,6 +12,7 @@
 #include "util.h"
 #include "exceptdef.h"
 #include "allocator.h"
+#include "growth_policy.h"
 namespace mystl
 {
 
@@ -25,17 +26,34 @@ namespace mystl
 #undef min
 #endif // min
 
+// 判断空间配置器是否提供 reallocate(p, old_n, new_n)，即能否在不搬移元素的情况下扩大空间
+template <class Alloc>
+struct alloc_has_reallocate
+{
+private:
+  template <class A>
+  static auto test(int) -> decltype(std::declval<A&>().reallocate(
+    std::declval<typename A::pointer>(), std::declval<typename A::size_type>(),
+    std::declval<typename A::size_type>()), std::true_type());
+  template <class A>
+  static std::false_type test(...);
+public:
+  static const bool value = decltype(test<Alloc>(0))::value;
+};
+
 // 模板类: vector 
-// 模板参数 T 代表类型
-template <class T>
+// 模板参数 T 代表类型，Alloc 代表空间配置器，缺省使用 mystl::allocator，
+// Growth 代表增长策略（见 growth_policy.h），缺省 1.5 倍扩容
+template <class T, class Alloc = mystl::allocator<T>, class Growth = mystl::growth_1_5x>
 class vector
 {
   static_assert(!std::is_same<bool, T>::value, "vector<bool> is abandoned in mystl");
 public:
   // vector 的嵌套型别定义
 
-  typedef mystl::allocator<T>                      allocator_type;
-  typedef mystl::allocator<T>                      data_allocator;
+  typedef Alloc                                    allocator_type;
+  typedef Alloc                                    data_allocator;
+  typedef Growth                                   growth_policy;
 
   typedef typename allocator_type::value_type      value_type;
   typedef typename allocator_type::pointer         pointer;
@@ -50,9 +68,10 @@ public:
   typedef mystl::reverse_iterator<iterator>        reverse_iterator;
   typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
 
-  allocator_type get_allocator() { return data_allocator(); }
+  allocator_type get_allocator() const { return alloc_; }
 
 private:
+  data_allocator alloc_;  // 空间配置器实例，有状态的配置器（内存池等）保存在这里
   iterator begin_;  // 表示目前使用空间的头部
   iterator end_;    // 表示目前使用空间的尾部
   iterator cap_;    // 表示目前储存空间的尾部
@@ -61,30 +80,46 @@ public:
   // 构造、复制、移动、析构函数
   vector() noexcept
   { try_init(); }
+
+  explicit vector(const allocator_type& alloc) noexcept
+    :alloc_(alloc)
+  { try_init(); }
+
   //! 构造函数, 指定vector的大小
-  explicit vector(size_type n)
-  { fill_init(n, value_type()); }
+  explicit vector(size_type n, const allocator_type& alloc = allocator_type())
+    :alloc_(alloc)
+  { value_init(n); }
 
   //! 构造函数，指定vector的大小和初值
-  vector(size_type n, const value_type& value)
+  vector(size_type n, const value_type& value,
+         const allocator_type& alloc = allocator_type())
+    :alloc_(alloc)
   { fill_init(n, value); }
 
   //! 构造函数， 根据first和last指针，开辟相应的空间
   template <class Iter, typename std::enable_if<
     mystl::is_input_iterator<Iter>::value, int>::type = 0> 
-  vector(Iter first, Iter last)
+  vector(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+    :alloc_(alloc)
   {
     MYSTL_DEBUG(!(last < first));
     range_init(first, last);
   }
   // 拷贝构造函数
   vector(const vector& rhs)
+    :alloc_(rhs.alloc_)
+  {
+    range_init(rhs.begin_, rhs.end_);
+  }
+  vector(const vector& rhs, const allocator_type& alloc)
+    :alloc_(alloc)
   {
     range_init(rhs.begin_, rhs.end_);
   }
-  // 移动构造函数
+  // 移动构造函数，内存连同配置器一起转移
   vector(vector&& rhs) noexcept
-    :begin_(rhs.begin_),
+    :alloc_(rhs.alloc_),
+    begin_(rhs.begin_),
     end_(rhs.end_),
     cap_(rhs.cap_)
   {
@@ -93,7 +128,9 @@ public:
     rhs.cap_ = nullptr;
   }
 
-  vector(std::initializer_list<value_type> ilist)
+  vector(std::initializer_list<value_type> ilist,
+         const allocator_type& alloc = allocator_type())
+    :alloc_(alloc)
   {
     range_init(ilist.begin(), ilist.end());
   }
@@ -104,7 +141,7 @@ public:
   //! vector 的列表初始化
   vector& operator=(std::initializer_list<value_type> ilist)
   {
-    vector tmp(ilist.begin(), ilist.end());
+    vector tmp(ilist.begin(), ilist.end(), alloc_);
     swap(tmp);
     return *this;
   }
@@ -139,7 +176,8 @@ public:
   size_type capacity() const noexcept
   { return static_cast<size_type>(cap_ - begin_); }
   void      reserve(size_type n);
-  // void      shrink_to_fit();
+  // 释放多余的容量，容量变为 size()
+  void      shrink_to_fit();
 
   // 访问元素相关操作
   //! 这里的reference 就相当于模板参数的引用
@@ -208,6 +246,18 @@ public:
   void      resize(size_type new_size) {return resize(new_size, value_type());}
   void      resize(size_type new_size, const value_type& value);
 
+  // 新增的元素只做默认初始化：平凡类型不清零，内容不确定，
+  // 适合随后被 read()/recv() 等直接写满的缓冲区
+  void      resize_default_init(size_type new_size);
+  // 同 resize_default_init，但只接受平凡类型，新增的元素完全不初始化
+  void      resize_uninitialized(size_type new_size)
+  {
+    static_assert(std::is_trivially_default_constructible<T>::value &&
+                  std::is_trivially_destructible<T>::value,
+                  "resize_uninitialized requires a trivial value_type");
+    resize_default_init(new_size);
+  }
+
   // push_back/pop_back 
   void push_back(const value_type& value);
   void push_back(value_type&& value){
@@ -222,19 +272,61 @@ public:
   template <class... Args>
   iterator emplace(const_iterator pos,  Args&& ... args);
 
+  // 调用者已经保证 size() < capacity()（如事先 reserve），省掉容量检查
+  template <class... Args>
+  void emplace_back_unchecked(Args&& ... args)
+  {
+    MYSTL_DEBUG(end_ < cap_);
+    mystl::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
+    ++end_;
+  }
+
+  // ------------------------------------ append --------------------------------------------
+  // 在尾部追加 [first, last)：前向迭代器只扩容一次，再整段构造（平凡类型直接 memmove）
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  void append_range(Iter first, Iter last)
+  { append_range_cat(first, last, iterator_category(first)); }
+
+  // 在尾部追加 n 个由 gen() 生成的元素，只扩容一次
+  template <class Gen>
+  void append_n(size_type n, Gen gen);
+
   //--------------------------------------- reallocate --------------------------------------------
   template  <class ...Args>
   void      reallocate_emplace(iterator pos, Args&& ...args);
   void      reallocate_insert(iterator pos, const value_type& value);
 
   size_type get_new_cap(size_type add_size);
+  size_type get_init_cap(size_type n) const noexcept
+  { return Growth::new_capacity(0, n, sizeof(T), max_size()); }
+
+  // 元素可以按字节搬移时，扩容、插入、删除都直接 memmove，不再逐个移动构造再析构
+  typedef std::integral_constant<bool, is_trivially_relocatable<T>::value> relocatable;
+
+  // 元素可以按字节搬移且配置器支持 reallocate 时，扩容先尝试原地扩大空间（如 mremap）
+  typedef std::integral_constant<bool, relocatable::value &&
+    alloc_has_reallocate<Alloc>::value>            use_reallocate;
+
+  bool      try_grow_in_place(size_type new_cap);
+  bool      try_grow_in_place(size_type, std::false_type) { return false; }
+  bool      try_grow_in_place(size_type new_cap, std::true_type);
+  void      relocate(size_type new_cap);
+  void      relocate_around(iterator pos, size_type n, iterator new_begin, size_type new_cap);
 
   //--------------------------------------- helper functions -------------------------------------
+  template <class IIter>
+  void      append_range_cat(IIter first, IIter last, input_iterator_tag);
+  template <class FIter>
+  void      append_range_cat(FIter first, FIter last, forward_iterator_tag);
+
   void      try_init();
   
   void      init_space(size_type size, size_type cap);
 
   void      fill_init(size_type n, const value_type& value);
+
+  void      value_init(size_type n);
   
   template <class Iter>
   void      range_init(Iter first, Iter last);
@@ -282,35 +374,36 @@ public:
 
 //--------------------------------------------------------------------------------------
 // 拷贝赋值
-template <class T>
-vector<T>&  vector<T>::operator=(const vector& rhs){  // 左值引用
+template <class T, class Alloc, class Growth>
+vector<T, Alloc, Growth>&  vector<T, Alloc, Growth>::operator=(const vector& rhs){  // 左值引用
   if(this != &rhs){
     const auto len = rhs.size();
     if(len > capacity()){
-      vector tmp(rhs.begin(), rhs.end());
+      vector tmp(rhs.begin(), rhs.end(), alloc_);
       swap(tmp);
     }
 
     else if(size() >= len){
       auto i = mystl::copy(rhs.begin(), rhs.end(), begin());
-      data_allocator::destroy(i, end_);
+      mystl::destroy(i, end_);
       end_ = begin_ + len;
     }
 
     else{  //  size() <= len <= capaticy()
       mystl::copy(rhs.begin(), rhs.begin() + size(), begin_);
-      mystl::uninitialized_copy_n(rhs.begin() + size(), rhs.end(), end_);
-      cap_ = end_ = begin_ + len;
+      mystl::uninitialized_copy(rhs.begin() + size(), rhs.end(), end_);
+      end_ = begin_ + len;
     }
   }
   return *this;
 }
 
 //移动赋值
-template <class T>
-vector<T>& vector<T>::operator=(vector&& rhs) noexcept
+template <class T, class Alloc, class Growth>
+vector<T, Alloc, Growth>& vector<T, Alloc, Growth>::operator=(vector&& rhs) noexcept
 {
   destroy_and_recover(begin_, end_, cap_ - begin_);
+  alloc_ = rhs.alloc_;
   begin_ = rhs.begin_;
   end_ = rhs.end_;
   cap_ = rhs.cap_;
@@ -323,32 +416,105 @@ vector<T>& vector<T>::operator=(vector&& rhs) noexcept
 
 // 预留空间大小，当原容量小于要求大小时，才会重新分配
 //! 申请n个元素的内存空间
-template <class T>
-void vector<T>::reserve(size_type n)
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reserve(size_type n)
 { 
   if (capacity() < n)
   {
     THROW_LENGTH_ERROR_IF(n > max_size(),
                           "n can not larger than max_size() in vector<T>::reserve(n)");
-    const auto old_size = size();
-    auto tmp = data_allocator::allocate(n);
+    if (!try_grow_in_place(n))
+      relocate(n);
+  }
+}
+
+// shrink_to_fit 函数：把元素搬到恰好容纳 size() 个元素的空间
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::shrink_to_fit()
+{
+  if (end_ == cap_)
+    return;
+  if (begin_ == end_)
+  {
+    alloc_.deallocate(begin_, cap_ - begin_);
+    begin_ = end_ = cap_ = nullptr;
+    return;
+  }
+  relocate(size());
+}
+
+// relocate 函数：申请 new_cap 个元素的新空间，把所有元素移过去
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::relocate(size_type new_cap)
+{
+  auto tmp = alloc_.allocate(new_cap);
+  if (relocatable::value)
+  {
+    relocate_around(end_, 0, tmp, new_cap);
+    return;
+  }
+  const auto old_size = size();
+  try
+  {
     mystl::uninitialized_move(begin_, end_, tmp);
-    data_allocator::deallocate(begin_, cap_ - begin_);
-    begin_ = tmp;
-    end_ = tmp + old_size;
-    cap_ = begin_ + n;
   }
+  catch (...)
+  {
+    alloc_.deallocate(tmp, new_cap);
+    throw;
+  }
+  destroy_and_recover(begin_, end_, cap_ - begin_);
+  begin_ = tmp;
+  end_ = tmp + old_size;
+  cap_ = begin_ + new_cap;
+}
+
+// relocate_around 函数：把元素按字节搬到 new_begin 开始的新空间，在 pos 对应的位置空出 n 个位置，
+// 释放旧空间。只用于可平凡搬移的类型，空出的位置由调用者事先构造好
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::
+relocate_around(iterator pos, size_type n, iterator new_begin, size_type new_cap)
+{
+  auto gap = mystl::uninitialized_relocate(begin_, pos, new_begin);
+  auto new_end = mystl::uninitialized_relocate(pos, end_, gap + n);
+  alloc_.deallocate(begin_, cap_ - begin_);
+  begin_ = new_begin;
+  end_ = new_end;
+  cap_ = new_begin + new_cap;
+}
+
+// try_grow_in_place 函数：让配置器直接把空间扩大到 new_cap，成功返回 true，元素不需要移动
+template <class T, class Alloc, class Growth>
+bool vector<T, Alloc, Growth>::try_grow_in_place(size_type new_cap)
+{
+  return try_grow_in_place(new_cap, use_reallocate());
+}
+
+template <class T, class Alloc, class Growth>
+bool vector<T, Alloc, Growth>::try_grow_in_place(size_type new_cap, std::true_type)
+{
+  if (begin_ == nullptr)
+    return false;
+  const auto old_size = size();
+  auto p = alloc_.reallocate(begin_, cap_ - begin_, new_cap);
+  if (p == nullptr)
+    return false;
+  begin_ = p;
+  end_ = p + old_size;
+  cap_ = p + new_cap;
+  return true;
 }
 
 // try_init 函数，若分配失败则忽略，不抛出异常
-template <class T>
-void vector<T>::try_init() 
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::try_init() 
 {
   try
   {
-    begin_ = data_allocator::allocate(16);
+    const size_type n = get_init_cap(0);
+    begin_ = alloc_.allocate(n);
     end_ = begin_;
-    cap_ = begin_ + 16;
+    cap_ = begin_ + n;
   }
   catch (...)
   {
@@ -362,12 +528,12 @@ void vector<T>::try_init()
 
 
 // init_space 函数
-template <class T>
-void vector<T>::init_space(size_type size, size_type cap)
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::init_space(size_type size, size_type cap)
 {
   try
   {
-    begin_ = data_allocator::allocate(cap);
+    begin_ = alloc_.allocate(cap);
     end_ = begin_ + size;
     cap_ = begin_ + cap;
   }
@@ -381,73 +547,104 @@ void vector<T>::init_space(size_type size, size_type cap)
 }
 
 // fill_init 函数
-template <class T>
-void vector<T>::
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::
 fill_init(size_type n, const value_type& value)
 {
-  const size_type init_size = mystl::max(static_cast<size_type>(16), n);
-  init_space(n, init_size);
+  init_space(n, get_init_cap(n));
   mystl::uninitialized_fill_n(begin_, n, value);
   //mystl::unchecked_fill_n(begin_,n,value);
 }
 
-template <class T>
+// value_init 函数：n 个值初始化的元素
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::
+value_init(size_type n)
+{
+  init_space(n, get_init_cap(n));
+  try
+  {
+    mystl::uninitialized_value_construct_n(begin_, n);
+  }
+  catch (...)
+  {
+    alloc_.deallocate(begin_, cap_ - begin_);
+    begin_ = end_ = cap_ = nullptr;
+    throw;
+  }
+}
+
+template <class T, class Alloc, class Growth>
 template <class Iter>
-void vector<T>::
+void vector<T, Alloc, Growth>::
 range_init(Iter first, Iter last)
 {
-  const size_type init_size = mystl::max(static_cast<size_type>(last - first),
-                                         static_cast<size_type>(16));   //! 最小分配16个字节
-  init_space(static_cast<size_type>(last - first), init_size);  //! 第一个参数是size, 第二个参数是capacity
+  const size_type n = static_cast<size_type>(last - first);
+  init_space(n, get_init_cap(n));  //! 第一个参数是size, 第二个参数是capacity
   mystl::uninitialized_copy(first, last, begin_);
 }
 
 
 // // destroy_and_recover 函数
 // //! 析构对象， 释放内存
-template <class T>
-void vector<T>::
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::
 destroy_and_recover(iterator first, iterator last, size_type n)
 {
-  data_allocator::destroy(first, last);
-  data_allocator::deallocate(first, n);
+  mystl::destroy(first, last);
+  alloc_.deallocate(first, n);
 }
 
 // erase 删除某个位置上的元素
-template <class T>
-typename vector<T>::iterator
-vector<T>::erase(const_iterator pos){
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::erase(const_iterator pos){
   assert(pos <= end() && pos >= begin());
   iterator xpos = begin_ + (pos - begin());
+  if (relocatable::value)
+  {
+    mystl::destroy(xpos);
+    mystl::uninitialized_relocate(xpos + 1, end_, xpos);
+    --end_;
+    return xpos;
+  }
   mystl::move(xpos+1, end_, xpos);
-  data_allocator::destroy(end_ - 1);
+  mystl::destroy(end_ - 1);
   --end_;
   return xpos;
 }
 
 // erase 删除[first,last) 上的元素
-template <class T>
-typename vector<T>::iterator
-vector<T>::erase(const_iterator first, const_iterator last){
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::erase(const_iterator first, const_iterator last){
   assert(first >= begin() && last <= end() && first <= last);
   const auto n = first - begin();
   iterator r = begin_ + (first - begin());
-  data_allocator::destroy(mystl::move(r + (last - first), end_, r), end_);
+  if (relocatable::value)
+  { // 析构被删除的元素，后面的元素整体前移
+    mystl::destroy(r, r + (last - first));
+    mystl::uninitialized_relocate(r + (last - first), end_, r);
+    end_ = end_ - (last - first);
+    return begin_ + n;
+  }
+  mystl::destroy(mystl::move(r + (last - first), end_, r), end_);
   end_ = end_ - (last - first);
   return begin_ + n;
 }
 
-template <class T>
-void vector<T>::swap(vector<T>& rhs){
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::swap(vector<T, Alloc, Growth>& rhs){
   if(this != &rhs){
+    mystl::swap(alloc_, rhs.alloc_);
     mystl::swap(begin_, rhs.begin_);
     mystl::swap(end_, rhs.end_);
     mystl::swap(cap_, rhs.cap_);
   }
 }
 
-template <class T>
-void vector<T>::resize(size_type new_size, const value_type& value){
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize(size_type new_size, const value_type& value){
   if(new_size < size()){
     erase(begin() + new_size, end());
   }
@@ -459,11 +656,24 @@ void vector<T>::resize(size_type new_size, const value_type& value){
 }
 
 
-template <class T>
-void vector<T>::
+// resize_default_init 函数：增长时新元素默认初始化，空间不足时先按增长策略扩容
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize_default_init(size_type new_size){
+  if(new_size < size()){
+    erase(begin() + new_size, end());
+    return;
+  }
+  if(new_size > capacity()){
+    reserve(get_new_cap(new_size - size()));
+  }
+  end_ = mystl::uninitialized_default_construct_n(end_, new_size - size());
+}
+
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::
 fill_assign(size_type n, const value_type& value){
   if(n > capacity()){
-    vector tmp(n, value);
+    vector tmp(n, value, alloc_);
     swap(tmp);
   }
   else if(n > size()){
@@ -476,9 +686,9 @@ fill_assign(size_type n, const value_type& value){
 }
 
 
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class IIter>
-void vector<T>::
+void vector<T, Alloc, Growth>::
 copy_assign(IIter first, IIter last, input_iterator_tag){
   
   auto cur = begin_;
@@ -493,19 +703,19 @@ copy_assign(IIter first, IIter last, input_iterator_tag){
   }
 }
 
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class FIter>
-void vector<T>::
+void vector<T, Alloc, Growth>::
 copy_assign(FIter first, FIter last, forward_iterator_tag){
   
   const size_type len = mystl::distance(first, last);
   if(len > capacity()){
-    vector tmp(first, last);
+    vector tmp(first, last, alloc_);
     swap(tmp);
   }
   else if(len >= size()){
     auto new_end = mystl::copy(first, last, begin_);
-    data_allocator::destroy(new_end, end_);
+    mystl::destroy(new_end, end_);
     end_ = new_end;
   }
   else{  //size() < len <capacity()
@@ -518,10 +728,10 @@ copy_assign(FIter first, FIter last, forward_iterator_tag){
 }
 
 // push_back 在尾部插入元素
-template <class T>
-void vector<T>::push_back(const value_type& value){
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::push_back(const value_type& value){
   if(end_ != cap_){ // 备用空间还够用
-    data_allocator::construct(mystl::address_of(*end_), value);
+    mystl::construct(mystl::address_of(*end_), value);
     ++end_;
   }
   else{
@@ -530,10 +740,10 @@ void vector<T>::push_back(const value_type& value){
 }
 
 // pop_back 弹出尾部元素
-template <class T>
-void vector<T>::pop_back(){
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::pop_back(){
   assert(!empty());
-  data_allocator::destroy(end_ - 1);
+  mystl::destroy(end_ - 1);
   --end_;
 }
 
@@ -541,24 +751,41 @@ void vector<T>::pop_back(){
 
 // emplace　函数
 // 在pos位置原地构造元素，　避免额外的赋值或者开销
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class ...Args>
-typename vector<T>::iterator
-vector<T>::emplace(const_iterator pos, Args&& ...args){
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::emplace(const_iterator pos, Args&& ...args){
 
   assert(pos >= begin() && pos <= end());
   iterator xpos = const_cast<iterator>(pos);
   const size_type n = xpos - begin_;
   if(end_ != cap_ && pos == end_){  // 在end_ 位置添加元素
-    data_allocator::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
+    mystl::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
     ++end_;
   }
   else if(end_ != cap_){   // 在中间插入
-    auto new_end = end_;
-    data_allocator::construct(mystl::address_of(*end_), *(end_-1)); // 复制最后一个元素
-    ++new_end;
-    mystl::copy_backward(xpos, end_ - 1, end_);
-    *xpos = value_type(mystl::forward<Args>(args)...);
+    value_type tmp(mystl::forward<Args>(args)...);  // 参数可能引用要后移的元素，先构造出来
+    if (relocatable::value)
+    { // [xpos, end_) 整体后移一位，空出的位置视为未初始化
+      mystl::uninitialized_relocate(xpos, end_, xpos + 1);
+      try
+      {
+        mystl::construct(mystl::address_of(*xpos), mystl::move(tmp));
+      }
+      catch (...)
+      {
+        mystl::uninitialized_relocate(xpos + 1, end_ + 1, xpos);
+        throw;
+      }
+      ++end_;
+    }
+    else
+    {
+      mystl::construct(mystl::address_of(*end_), mystl::move(*(end_ - 1))); // 移动最后一个元素
+      ++end_;
+      mystl::move_backward(xpos, end_ - 2, end_ - 1);
+      *xpos = mystl::move(tmp);
+    }
   }
   else{ // end_ == cap_
     reallocate_emplace(xpos, mystl::forward<Args>(args)...);
@@ -568,11 +795,54 @@ vector<T>::emplace(const_iterator pos, Args&& ...args){
 }
 
 
-template <class T>
+// append_n 函数
+template <class T, class Alloc, class Growth>
+template <class Gen>
+void vector<T, Alloc, Growth>::append_n(size_type n, Gen gen){
+  if(static_cast<size_type>(cap_ - end_) < n){
+    reserve(get_new_cap(n));
+  }
+  for(; n > 0; --n){
+    mystl::construct(mystl::address_of(*end_), gen());
+    ++end_;
+  }
+}
+
+// append_range_cat 函数：输入迭代器无法预知长度，逐个追加
+template <class T, class Alloc, class Growth>
+template <class IIter>
+void vector<T, Alloc, Growth>::
+append_range_cat(IIter first, IIter last, input_iterator_tag){
+  for(; first != last; ++first){
+    emplace_back(*first);
+  }
+}
+
+template <class T, class Alloc, class Growth>
+template <class FIter>
+void vector<T, Alloc, Growth>::
+append_range_cat(FIter first, FIter last, forward_iterator_tag){
+  const size_type n = mystl::distance(first, last);
+  if(static_cast<size_type>(cap_ - end_) >= n){
+    end_ = mystl::uninitialized_copy(first, last, end_);
+  }
+  else{ // 区间可能来自本容器，copy_insert 会先复制到新空间再释放旧空间
+    copy_insert(end_, first, last);
+  }
+}
+
+// insert 在 pos 处插入一个元素
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::insert(const_iterator pos, const value_type& value){
+  return emplace(pos, value);
+}
+
+template <class T, class Alloc, class Growth>
 template <class ...Args>
-void vector<T>::emplace_back(Args&& ...args){
+void vector<T, Alloc, Growth>::emplace_back(Args&& ...args){
   if(end_ < cap_){   // 还有备用空间
-    data_allocator::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
+    mystl::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
     ++end_;
   }
   else{
@@ -581,46 +851,41 @@ void vector<T>::emplace_back(Args&& ...args){
 }
 
 
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class ...Args>
-void  vector<T>::reallocate_emplace(iterator pos, Args&& ...args){
+void  vector<T, Alloc, Growth>::reallocate_emplace(iterator pos, Args&& ...args){
   
   const auto new_size = get_new_cap(1); // 获取扩容后vec的大小
-  auto new_begin = data_allocator::allocate(new_size);  // 从新分配空间
-  auto new_end = new_begin;
-  try{
-    new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-    data_allocator::construct(mystl::address_of(*new_end), mystl::forward<Args>(args)...);
-    ++new_end;
-    new_end = mystl::uninitialized_move(pos, end_, new_end);
+  if (use_reallocate::value && pos == end_)
+  { // 在尾部追加时尝试原地扩容；参数可能引用旧空间里的元素，先构造出新元素
+    value_type tmp(mystl::forward<Args>(args)...);
+    if (!try_grow_in_place(new_size))
+      relocate(new_size);
+    mystl::construct(mystl::address_of(*end_), mystl::move(tmp));
+    ++end_;
+    return;
+  }
+  auto new_begin = alloc_.allocate(new_size);  // 从新分配空间
+  auto new_pos = new_begin + (pos - begin_);
+  try{ // 先构造新元素，参数可能引用旧空间中的元素
+    mystl::construct(mystl::address_of(*new_pos), mystl::forward<Args>(args)...);
   }
   catch(...){
-    data_allocator::deallocate(new_begin, new_size);
+    alloc_.deallocate(new_begin, new_size);
     throw;
   }
-  destroy_and_recover(begin_, end_, cap_ - begin_ );
-  begin_ = new_begin;
-  end_ = new_end;
-  cap_ = new_begin + new_size;
-}
-
-
-
-template <class T>
-void vector<T>::reallocate_insert(iterator pos, const value_type& value){
-  
-  const auto new_size = get_new_cap(1); // 获取扩容后vec的大小
-  auto new_begin = data_allocator::allocate(new_size);  // 从新分配空间
+  if (relocatable::value){
+    relocate_around(pos, 1, new_begin, new_size);
+    return;
+  }
   auto new_end = new_begin;
-  const value_type& value_copy = value;
   try{
-    new_begin = mystl::uninitialized_move(begin_, pos, new_begin);
-    data_allocator::construct(mystl::address_of(*new_end), value_copy);
-    ++new_end;
-    new_end = mystl::uninitialized_move(pos, end_, new_end);
+    mystl::uninitialized_move(begin_, pos, new_begin);
+    new_end = mystl::uninitialized_move(pos, end_, new_pos + 1);
   }
   catch(...){
-    data_allocator::deallocate(new_begin, new_size);
+    mystl::destroy(new_pos);
+    alloc_.deallocate(new_begin, new_size);
     throw;
   }
   destroy_and_recover(begin_, end_, cap_ - begin_ );
@@ -629,36 +894,47 @@ void vector<T>::reallocate_insert(iterator pos, const value_type& value){
   cap_ = new_begin + new_size;
 }
 
-// get_new_cap 函数： 获取扩容后vector 的大小
-template <class T>
-typename vector<T>::size_type
-vector<T>::get_new_cap(size_type add_size){
-  
-  const auto old_size = capacity();
-  THROW_OUT_OF_RANGE_IF(old_size + add_size > max_size(), "vector<T> is too big");
 
-  if(old_size > max_size() - old_size / 2){ // 如果old_size()大于max_size()的 2/3， 则不能1.5倍扩容，会超出max_size()
-    return old_size + add_size > max_size() - 16
-      ? old_size + add_size : old_size + add_size + 16;
-  }
-  const size_type new_size = old_size == 0
-     ?  mystl::max(add_size, static_cast<size_type>(16))  // 最少分配16个元素
-     :  mystl::max(old_size + old_size / 2, old_size + add_size);  // 最少1.5倍扩容
 
-  return new_size;
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reallocate_insert(iterator pos, const value_type& value){
+  reallocate_emplace(pos, value);
+}
+
+// get_new_cap 函数： 获取扩容后vector 的大小，由增长策略决定
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::size_type
+vector<T, Alloc, Growth>::get_new_cap(size_type add_size){
+  
+  THROW_OUT_OF_RANGE_IF(size() > max_size() - add_size, "vector<T> is too big");
+  return Growth::new_capacity(capacity(), size() + add_size, sizeof(T), max_size());
 }
 
 // fill_insert 函数
-template <class T>
-typename vector<T>::iterator 
-vector<T>::   //在某个位置插入几个相同的元素
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator 
+vector<T, Alloc, Growth>::   //在某个位置插入几个相同的元素
 fill_insert(iterator pos, size_type n, const value_type& value)
 {
   if (n == 0)
     return pos;
   const size_type xpos = pos - begin_;
   const value_type value_copy = value;  // 避免被覆盖
-  if (static_cast<size_type>(cap_ - end_) >= n)
+  if (relocatable::value && static_cast<size_type>(cap_ - end_) >= n)
+  { // [pos, end_) 整体后移 n 个位置，再在空出的位置上构造
+    mystl::uninitialized_relocate(pos, end_, pos + n);
+    try
+    {
+      mystl::uninitialized_fill_n(pos, n, value_copy);
+    }
+    catch (...)
+    {
+      mystl::uninitialized_relocate(pos + n, end_ + n, pos);
+      throw;
+    }
+    end_ += n;
+  }
+  else if (static_cast<size_type>(cap_ - end_) >= n)
   { // 如果备用空间大于等于增加的空间
     const size_type after_elems = end_ - pos;
     auto old_end = end_;
@@ -667,24 +943,38 @@ fill_insert(iterator pos, size_type n, const value_type& value)
       mystl::uninitialized_copy(end_ - n, end_, end_); //未初始化的空间： 将[end-n,end) 移动到以end为开始的地方
       end_ += n;
       mystl::move_backward(pos, old_end - n, old_end); // 已经初始化的空间
-      mystl::uninitialized_fill_n(pos, n, value_copy); // 在相应位置填充元素
+      mystl::fill_n(pos, n, value_copy);               // [pos, pos + n) 上是被移走的对象，直接赋值
     }
     else  // pos~end <= n
     {
       end_ = mystl::uninitialized_fill_n(end_, n - after_elems, value_copy);  // 先填充未初始化的空间
       end_ = mystl::uninitialized_move(pos, old_end, end_);   // 移动元素
-      mystl::uninitialized_fill_n(pos, after_elems, value_copy);
+      mystl::fill(pos, old_end, value_copy);
     }
   }
   else
   { // 如果备用空间不足
     const auto new_size = get_new_cap(n);  // 重新获取容器大小
-    auto new_begin = data_allocator::allocate(new_size);  // 分配空间
+    auto new_begin = alloc_.allocate(new_size);  // 分配空间
+    if (relocatable::value)
+    {
+      try
+      {
+        mystl::uninitialized_fill_n(new_begin + xpos, n, value_copy);
+      }
+      catch (...)
+      {
+        alloc_.deallocate(new_begin, new_size);
+        throw;
+      }
+      relocate_around(pos, n, new_begin, new_size);
+      return begin_ + xpos;
+    }
     auto new_end = new_begin;
     try
     {
       new_end = mystl::uninitialized_move(begin_, pos, new_begin);  // 先移动[begin,pos)
-      new_end = mystl::uninitialized_fill_n(new_end, n, value);  // 填充n个元素
+      new_end = mystl::uninitialized_fill_n(new_end, n, value_copy);  // 填充n个元素，value 可能已被移走
       new_end = mystl::uninitialized_move(pos, end_, new_end);   // 再移动[pos,end)
     }
     catch (...)
@@ -692,7 +982,7 @@ fill_insert(iterator pos, size_type n, const value_type& value)
       destroy_and_recover(new_begin, new_end, new_size);
       throw;
     }
-    data_allocator::deallocate(begin_, cap_ - begin_);  // 析构对象， 释放原来的空间
+    destroy_and_recover(begin_, end_, cap_ - begin_);  // 析构对象， 释放原来的空间
     begin_ = new_begin;
     end_ = new_end;
     cap_ = begin_ + new_size;
@@ -701,16 +991,30 @@ fill_insert(iterator pos, size_type n, const value_type& value)
 }
 
 // copy_insert 函数，同上
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class IIter>
-void vector<T>::
+void vector<T, Alloc, Growth>::
 copy_insert(iterator pos, IIter first, IIter last)
 {
   if (first == last)
     return;
   //const auto n = mystl::distance(first, last);
   const auto n = mystl::distance(first, last);
-  if ((cap_ - end_) >= n)
+  if (relocatable::value && (cap_ - end_) >= n)
+  { // [pos, end_) 整体后移 n 个位置，再在空出的位置上构造
+    mystl::uninitialized_relocate(pos, end_, pos + n);
+    try
+    {
+      mystl::uninitialized_copy(first, last, pos);
+    }
+    catch (...)
+    {
+      mystl::uninitialized_relocate(pos + n, end_ + n, pos);
+      throw;
+    }
+    end_ += n;
+  }
+  else if ((cap_ - end_) >= n)
   { // 如果备用空间大小足够
     const auto after_elems = end_ - pos;
     auto old_end = end_;
@@ -732,20 +1036,35 @@ copy_insert(iterator pos, IIter first, IIter last)
   else
   { // 备用空间不足
     const auto new_size = get_new_cap(n);
-    auto new_begin = data_allocator::allocate(new_size);
-    auto new_end = new_begin;
+    auto new_begin = alloc_.allocate(new_size);
+    auto new_pos = new_begin + (pos - begin_);
     try
+    { // 先复制插入的区间，它可能来自本容器
+      mystl::uninitialized_copy(first, last, new_pos);
+    }
+    catch (...)
     {
-      new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-      new_end = mystl::uninitialized_copy(first, last, new_end);
+      alloc_.deallocate(new_begin, new_size);
+      throw;
+    }
+    if (relocatable::value)
+    {
+      relocate_around(pos, n, new_begin, new_size);
+      return;
+    }
+    auto new_end = new_pos + n;
+    try
+    {
+      mystl::uninitialized_move(begin_, pos, new_begin);
       new_end = mystl::uninitialized_move(pos, end_, new_end);
     }
     catch (...)
     {
-      destroy_and_recover(new_begin, new_end, new_size);
+      mystl::destroy(new_pos, new_pos + n);
+      alloc_.deallocate(new_begin, new_size);
       throw;
     }
-    data_allocator::deallocate(begin_, cap_ - begin_);
+    destroy_and_recover(begin_, end_, cap_ - begin_);
     begin_ = new_begin;
     end_ = new_end;
     cap_ = begin_ + new_size;
@@ -766,46 +1085,51 @@ copy_insert(iterator pos, IIter first, IIter last)
 
 //------------------------------------------------------------------------------------------------
 
-template <class T>
-bool operator==(const vector<T>& lhs, const vector<T>& rhs)
+template <class T, class Alloc, class Growth>
+bool operator==(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 {
   return lhs.size() == rhs.size() &&
     mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T>
-bool operator<(const vector<T>& lhs, const vector<T>& rhs)
+template <class T, class Alloc, class Growth>
+bool operator<(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 {               //翻译是词典式的
-  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), lhs.end());
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T>
-bool operator!=(const vector<T>& lhs, const vector<T>& rhs)
+template <class T, class Alloc, class Growth>
+bool operator!=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 {
   return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const vector<T>& lhs, const vector<T>& rhs)
+template <class T, class Alloc, class Growth>
+bool operator>(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 {
   return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const vector<T>& lhs, const vector<T>& rhs)
+template <class T, class Alloc, class Growth>
+bool operator<=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 {
   return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const vector<T>& lhs, const vector<T>& rhs)
+template <class T, class Alloc, class Growth>
+bool operator>=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 {
   return !(lhs < rhs);
 }
 
+// vector 只持有指向堆上空间的指针，配置器可以搬移时整个对象可以按字节搬移
+template <class T, class Alloc, class Growth>
+struct is_trivially_relocatable<vector<T, Alloc, Growth>>
+  : std::integral_constant<bool, is_trivially_relocatable<Alloc>::value> {};
+
 // 重载 mystl 的 swap
-template <class T>
-void swap(vector<T>& lhs, vector<T>& rhs)
+template <class T, class Alloc, class Growth>
+void swap(vector<T, Alloc, Growth>& lhs, vector<T, Alloc, Growth>& rhs)
 {
   lhs.swap(rhs);
 }
@@ -0,0 +1,209 @@
+#ifndef MYSTL_WORK_STEALING_DEQUE_H
+#define MYSTL_WORK_STEALING_DEQUE_H
+
+// 这个头文件包含一个模板类 work_stealing_deque
+// work_stealing_deque : Chase-Lev 工作窃取双端队列，按 Lê 等人给出的 C11 内存序实现
+// 拥有者线程在底部 push / pop（后进先出），其它线程从顶部 steal（先进先出）
+// 元素放在可扩容的环形数组里，下标 top / bottom 只增不减；只有拥有者写 bottom 和数组，
+// 窃取者之间以及窃取者与取最后一个元素的拥有者之间靠 top 上的 CAS 决出胜负
+// 扩容后旧数组可能仍被窃取者读，所以留到析构时再释放，总量不超过当前数组的大小
+// 窃取者可能与拥有者同时读写同一个槽位，槽位是 std::atomic<T>，因此 T 必须可平凡复制，
+// 通常存放任务指针或句柄
+
+#include <atomic>
+#include <type_traits>
+
+#include "allocator.h"
+#include "construct.h"
+#include "concurrency.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类: work_stealing_deque
+// 模板参数 T 代表类型，Alloc 代表空间配置器，缺省使用 mystl::allocator
+template <class T, class Alloc = mystl::allocator<T>>
+class work_stealing_deque
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "work_stealing_deque requires a trivially copyable value type");
+public:
+  // work_stealing_deque 的嵌套型别定义
+  typedef Alloc                                    allocator_type;
+
+  typedef T                                        value_type;
+  typedef T*                                       pointer;
+  typedef T&                                       reference;
+  typedef const T&                                 const_reference;
+  typedef size_t                                   size_type;
+  typedef ptrdiff_t                                difference_type;
+
+private:
+  typedef std::atomic<T> cell;
+
+  // 环形数组，retired 串起被替换下来的旧数组
+  struct ring
+  {
+    size_type cap;   // 2 的幂
+    cell*     buf;
+    ring*     retired;
+
+    T    get(difference_type i) const noexcept
+    { return buf[i & (cap - 1)].load(std::memory_order_relaxed); }
+    void put(difference_type i, const T& value) noexcept
+    { buf[i & (cap - 1)].store(value, std::memory_order_relaxed); }
+  };
+
+  typedef typename Alloc::template rebind<cell>::other cell_allocator;
+  typedef typename Alloc::template rebind<ring>::other ring_allocator;
+
+  alignas(cache_line_size) std::atomic<difference_type> top_;     // 窃取者争用
+  alignas(cache_line_size) std::atomic<difference_type> bottom_;  // 只有拥有者写
+  std::atomic<ring*> array_;
+  cell_allocator     cell_alloc_;
+  ring_allocator     ring_alloc_;
+
+public:
+  // 初始容量向上取整到 2 的幂，空间不够时由 push 扩容
+  explicit work_stealing_deque(size_type capacity = 64,
+                               const allocator_type& alloc = allocator_type())
+    :top_(0), bottom_(0), array_(nullptr), cell_alloc_(alloc), ring_alloc_(alloc)
+  {
+    size_type cap = 2;
+    while (cap < capacity)
+      cap <<= 1;
+    array_.store(create_ring(cap, nullptr), std::memory_order_relaxed);
+  }
+
+  work_stealing_deque(const work_stealing_deque&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+  // 析构时不能有线程仍在使用队列
+  ~work_stealing_deque()
+  {
+    ring* r = array_.load(std::memory_order_relaxed);
+    while (r != nullptr)
+    {
+      ring* next = r->retired;
+      destroy_ring(r);
+      r = next;
+    }
+  }
+
+public:
+  // 容量相关操作，并发修改时 size 和 empty 只是近似值
+  size_type capacity() const noexcept
+  { return array_.load(std::memory_order_relaxed)->cap; }
+  size_type size() const noexcept
+  {
+    const difference_type b = bottom_.load(std::memory_order_relaxed);
+    const difference_type t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+  bool      empty() const noexcept { return size() == 0; }
+
+  // 拥有者调用 ----------------------------------------------------------------
+
+  // 放入底部，数组已满时扩容为两倍，只在分配失败时抛出异常
+  void push(const value_type& value)
+  {
+    const difference_type b = bottom_.load(std::memory_order_relaxed);
+    const difference_type t = top_.load(std::memory_order_acquire);
+    ring* a = array_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<difference_type>(a->cap) - 1)
+      a = grow(a, t, b);
+    a->put(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  // 从底部取出，队列为空或最后一个元素被窃取时返回 false，此时 value 不变
+  bool pop(value_type& value) noexcept
+  {
+    const difference_type b = bottom_.load(std::memory_order_relaxed) - 1;
+    ring* a = array_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    difference_type t = top_.load(std::memory_order_relaxed);
+    if (t > b)
+    { // 已空
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+    const value_type x = a->get(b);
+    if (t == b)
+    { // 最后一个元素，与窃取者竞争
+      const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      if (!won)
+        return false;
+    }
+    value = x;
+    return true;
+  }
+
+  // 窃取者调用 ----------------------------------------------------------------
+
+  // 从顶部取出，队列为空或与其它线程竞争失败时返回 false，此时 value 不变
+  bool steal(value_type& value) noexcept
+  {
+    difference_type t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const difference_type b = bottom_.load(std::memory_order_acquire);
+    if (t >= b)
+      return false;
+    ring* a = array_.load(std::memory_order_acquire);
+    const value_type x = a->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+      return false;
+    value = x;
+    return true;
+  }
+
+private:
+  ring* create_ring(size_type cap, ring* retired)
+  {
+    THROW_LENGTH_ERROR_IF(cap > (static_cast<size_type>(-1) >> 1) / sizeof(cell),
+                          "work_stealing_deque<T>'s capacity too big");
+    cell* buf = cell_alloc_.allocate(cap);
+    ring* r = nullptr;
+    try
+    {
+      r = ring_alloc_.allocate(1);
+    }
+    catch (...)
+    {
+      cell_alloc_.deallocate(buf, cap);
+      throw;
+    }
+    for (size_type i = 0; i < cap; ++i)
+      mystl::construct(buf + i);
+    r->cap = cap;
+    r->buf = buf;
+    r->retired = retired;
+    return r;
+  }
+
+  void destroy_ring(ring* r) noexcept
+  {
+    cell_alloc_.deallocate(r->buf, r->cap);
+    ring_alloc_.deallocate(r, 1);
+  }
+
+  // 复制 [t, b) 到两倍大的新数组后发布，旧数组挂到新数组的 retired 上
+  ring* grow(ring* a, difference_type t, difference_type b)
+  {
+    ring* na = create_ring(a->cap * 2, a);
+    for (difference_type i = t; i != b; ++i)
+      na->put(i, a->get(i));
+    array_.store(na, std::memory_order_release);
+    return na;
+  }
+};
+
+} // namespace mystl
+#endif // !MYSTL_WORK_STEALING_DEQUE_H
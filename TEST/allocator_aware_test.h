@@ -0,0 +1,222 @@
+#ifndef MYTINYSTL_ALLOCATOR_AWARE_TEST_H_
+#define MYTINYSTL_ALLOCATOR_AWARE_TEST_H_
+
+// allocator aware test : 用带状态的配置器测试各容器保存、传递配置器，以及申请的内存都如数归还
+
+#include <iostream>
+#include <map>
+
+#include "../MYSTL/vector.h"
+#include "../MYSTL/deque.h"
+#include "../MYSTL/list.h"
+#include "../MYSTL/map.h"
+#include "../MYSTL/set.h"
+#include "../MYSTL/unordered_map.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 记录每一块仍未归还的内存及其大小，归还时大小对不上或地址不存在记为 bad
+struct alloc_stats{
+    std::map<void*, size_t> live;
+    long bad = 0;
+};
+
+// 带状态的配置器：id 区分不同实例，stats 统计申请和归还
+template <class T>
+class tracking_allocator{
+public:
+    typedef T            value_type;
+    typedef T*           pointer;
+    typedef const T*     const_pointer;
+    typedef T&           reference;
+    typedef const T&     const_reference;
+    typedef size_t       size_type;
+    typedef ptrdiff_t    difference_type;
+
+    template <class U>
+    struct rebind{
+        typedef tracking_allocator<U> other;
+    };
+
+    template <class U>
+    friend class tracking_allocator;
+
+    explicit tracking_allocator(alloc_stats* stats = nullptr, int id = 0) noexcept
+        :stats_(stats), id_(id){
+    }
+
+    template <class U>
+    tracking_allocator(const tracking_allocator<U>& other) noexcept
+        :stats_(other.stats_), id_(other.id_){
+    }
+
+    T* allocate(size_type n){
+        if(n == 0)
+            return nullptr;
+        T* p = static_cast<T*>(::operator new(n * sizeof(T)));
+        if(stats_ != nullptr)
+            stats_->live[p] = n * sizeof(T);
+        return p;
+    }
+
+    void deallocate(T* p, size_type n){
+        if(p == nullptr)
+            return;
+        if(stats_ != nullptr){
+            auto it = stats_->live.find(p);
+            if(it == stats_->live.end() || it->second != n * sizeof(T))
+                ++stats_->bad;
+            else
+                stats_->live.erase(it);
+        }
+        ::operator delete(p);
+    }
+
+    template <class... Args>
+    void construct(T* p, Args&& ...args){ mystl::construct(p, mystl::forward<Args>(args)...); }
+    void destroy(T* p){ mystl::destroy(p); }
+    void destroy(T* first, T* last){ mystl::destroy(first, last); }
+
+    int id() const noexcept{ return id_; }
+
+    bool operator==(const tracking_allocator& rhs) const noexcept
+    { return stats_ == rhs.stats_ && id_ == rhs.id_; }
+    bool operator!=(const tracking_allocator& rhs) const noexcept
+    { return !(*this == rhs); }
+
+private:
+    alloc_stats* stats_;
+    int          id_;
+};
+
+// 容器析构后所有内存都已归还，且没有大小不符的归还
+inline bool alloc_balanced(const alloc_stats& s){
+    return s.live.empty() && s.bad == 0;
+}
+
+// vector：中间插入触发扩容、把长的复制给短的、移动赋值后配置器跟随
+inline bool vector_with_tracking(alloc_stats& s){
+    typedef mystl::vector<int, tracking_allocator<int>> vec;
+    bool ok = true;
+    {
+        vec v1(tracking_allocator<int>(&s, 1));
+        for(int i = 0; i < 10; i++)
+            v1.push_back(i);
+        v1.shrink_to_fit();
+        v1.insert(v1.begin() + 5, static_cast<size_t>(3), 100);
+        ok = ok && v1.size() == 13 && v1[4] == 4 && v1[5] == 100 && v1[7] == 100 && v1[8] == 5 && v1[12] == 9;
+        vec v2(2, 7, tracking_allocator<int>(&s, 2));
+        v2 = v1;
+        ok = ok && v2.size() == 13 && v2[12] == 9 && v2.get_allocator().id() == 2;
+        vec v3(tracking_allocator<int>(&s, 3));
+        v3 = mystl::move(v1);
+        ok = ok && v3.size() == 13 && v3.get_allocator().id() == 1;
+        v2.swap(v3);
+        ok = ok && v2.get_allocator().id() == 1 && v3.get_allocator().id() == 2;
+    }
+    return ok;
+}
+
+// deque：迭代器相减、后置 ++、头部插入跨缓冲区、clear 与移动赋值归还缓冲区
+inline bool deque_with_tracking(alloc_stats& s){
+    typedef mystl::deque<int, tracking_allocator<int>, 4> deq;
+    bool ok = true;
+    {
+        deq d1(tracking_allocator<int>(&s, 1));
+        for(int i = 0; i < 20; i++)
+            d1.push_front(19 - i);
+        for(int i = 20; i < 40; i++)
+            d1.emplace_back(i);
+        for(int i = 0; i < 40; i++)
+            ok = ok && d1[i] == i;
+        for(int i = 0; i <= 40; i++)
+            for(int j = 0; j <= 40; j++)
+                ok = ok && ((d1.begin() + i) - (d1.begin() + j)) == i - j;
+        auto it = d1.begin() + 3;
+        ok = ok && *it++ == 3 && *it == 4;
+        d1.clear();
+        for(int i = 0; i < 10; i++)
+            d1.push_back(i);
+        deq d2(5, 1, tracking_allocator<int>(&s, 2));
+        d2 = mystl::move(d1);
+        ok = ok && d2.size() == 10 && d2[9] == 9 && d2.get_allocator().id() == 1;
+    }
+    return ok;
+}
+
+// list：移动赋值要先归还自己原有的节点
+inline bool list_with_tracking(alloc_stats& s){
+    typedef mystl::list<int, tracking_allocator<int>> lst;
+    bool ok = true;
+    {
+        lst l1({ 1,2,3,4,5 }, tracking_allocator<int>(&s, 1));
+        lst l2({ 6,7,8 }, tracking_allocator<int>(&s, 2));
+        l2 = mystl::move(l1);
+        ok = ok && l2.size() == 5 && l2.back() == 5 && l2.get_allocator().id() == 1;
+    }
+    return ok;
+}
+
+// map / set：移动赋值和析构都要归还头节点
+inline bool tree_with_tracking(alloc_stats& s){
+    typedef tracking_allocator<mystl::pair<const int, int>> pair_alloc;
+    typedef mystl::map<int, int, mystl::less<int>, pair_alloc> map_type;
+    typedef mystl::set<int, mystl::less<int>, tracking_allocator<int>> set_type;
+    bool ok = true;
+    {
+        map_type m1{ pair_alloc(&s, 1) };
+        for(int i = 0; i < 50; i++)
+            m1[i] = i * i;
+        map_type m2{ pair_alloc(&s, 2) };
+        m2[1] = 1;
+        m2 = mystl::move(m1);
+        ok = ok && m2.size() == 50 && m2[7] == 49 && m2.get_allocator().id() == 1;
+        set_type s1{ tracking_allocator<int>(&s, 3) };
+        for(int i = 0; i < 50; i++)
+            s1.insert(i % 20);
+        ok = ok && s1.size() == 20 && *s1.begin() == 0;
+    }
+    return ok;
+}
+
+// unordered_map：多次 rehash 后节点仍然完整，且旧的桶数组和节点都被归还
+inline bool hash_with_tracking(alloc_stats& s){
+    typedef tracking_allocator<mystl::pair<const int, int>> pair_alloc;
+    typedef mystl::unordered_map<int, int, mystl::hash<int>, mystl::equal_to<int>, pair_alloc> umap;
+    bool ok = true;
+    {
+        umap h{ pair_alloc(&s, 1) };
+        for(int i = 0; i < 1000; i++)
+            h[i] = i + 1;
+        ok = ok && h.size() == 1000;
+        for(int i = 0; i < 1000; i++)
+            ok = ok && h.find(i) != h.end() && h.find(i)->second == i + 1;
+        ok = ok && h.get_allocator().id() == 1;
+    }
+    return ok;
+}
+
+void allocator_aware_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------ Run container test : allocator_aware -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    alloc_stats s1, s2, s3, s4, s5;
+    std::cout << std::boolalpha;
+    FUN_VALUE(vector_with_tracking(s1));
+    FUN_VALUE(alloc_balanced(s1));
+    FUN_VALUE(deque_with_tracking(s2));
+    FUN_VALUE(alloc_balanced(s2));
+    FUN_VALUE(list_with_tracking(s3));
+    FUN_VALUE(alloc_balanced(s3));
+    FUN_VALUE(tree_with_tracking(s4));
+    FUN_VALUE(alloc_balanced(s4));
+    FUN_VALUE(hash_with_tracking(s5));
+    FUN_VALUE(alloc_balanced(s5));
+    std::cout << std::noboolalpha;
+    PASSED;
+}
+
+}
+#endif
@@ -0,0 +1,93 @@
+#ifndef MYTINYSTL_ALLOCATOR_TEST_H_
+#define MYTINYSTL_ALLOCATOR_TEST_H_
+
+// allocator test : 测试 allocator / huge_page_allocator 的接口与多线程下分配释放的性能
+
+#include <memory>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <chrono>
+
+#include "../MYSTL/allocator.h"
+#include "../MYSTL/huge_page_allocator.h"
+#include "../MYSTL/vector.h"
+#include "../MYSTL/list.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 每个线程反复申请 64 个大小不一的块再全部释放，共 times 次申请
+template <class Alloc>
+string time_alloc(int threads, int times){
+    const auto t1 = std::chrono::system_clock::now();
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; t++){
+        workers.emplace_back([times](){
+            Alloc alloc;
+            char* ptrs[64];
+            for(int r = 0; r < times / 64; r++){
+                for(int i = 0; i < 64; i++)
+                    ptrs[i] = alloc.allocate(16 + (i * 40) % 512);
+                for(int i = 0; i < 64; i++)
+                    alloc.deallocate(ptrs[i], 16 + (i * 40) % 512);
+            }
+        });
+    }
+    for(auto& w : workers)
+        w.join();
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    return str1;
+}
+
+void allocator_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[--------------- Run container test : allocator ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    mystl::allocator<int> a1;
+    int* p = a1.allocate(10);
+    for(int i = 0; i < 10; i++)
+        p[i] = i;
+    FUN_VALUE(p[9]);
+    a1.deallocate(p, 10);
+
+    // 一个线程分配的节点交给另一个线程释放
+    mystl::list<int>* l1 = new mystl::list<int>{ 1,2,3,4,5 };
+    std::thread([l1](){ delete l1; }).join();
+    mystl::list<int> l2{ 1,2,3,4,5 };
+    COUT(l2);
+
+    // 小数组按 64 字节对齐，大数组 mmap 并按 2MB 对齐
+    mystl::vector<float, mystl::huge_page_allocator<float>> v2(10, 1.0f);
+    FUN_VALUE(reinterpret_cast<uintptr_t>(v2.data()) % 64);
+    mystl::vector<double, mystl::huge_page_allocator<double>> v3(1 << 20, 1.0);
+    FUN_VALUE(reinterpret_cast<uintptr_t>(v3.data()) % (2 * 1024 * 1024));
+    FUN_AFTER(v2, v2.push_back(2.0f));
+    FUN_VALUE(v3.back());
+    // 大数组在尾部增长时用 mremap 原地扩大映射，不复制元素
+    FUN_VALUE((v3.push_back(v3[0]), v3.size()));
+    FUN_VALUE(v3.back());
+    FUN_VALUE((v3.reserve(v3.capacity() * 2), v3[12345]));
+    PASSED;
+
+    int times = 10000000;
+    string mystl_times1 = time_alloc<mystl::allocator<char>>(1, times);
+    string mystl_times2 = time_alloc<mystl::allocator<char>>(2, times);
+    string mystl_times3 = time_alloc<mystl::allocator<char>>(4, times);
+    string stl_times1 = time_alloc<std::allocator<char>>(1, times);
+    string stl_times2 = time_alloc<std::allocator<char>>(2, times);
+    string stl_times3 = time_alloc<std::allocator<char>>(4, times);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  alloc/free x 10^7  |   1 thread  |  2 threads  |  4 threads  |\n";
+    std::cout << "|        mystl        | "<<mystl_times1 + " | " << mystl_times2 + " | " + mystl_times3 + " |\n";
+    std::cout << "|        std          | "<<stl_times1 + " | " << stl_times2 + " | " + stl_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -0,0 +1,95 @@
+#ifndef MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
+#define MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
+
+// circular_buffer test : 测试 circular_buffer 的接口与作为滑动窗口时的性能
+
+#include <deque>
+#include <iostream>
+#include <chrono>
+
+#include "../MYSTL/circular_buffer.h"
+#include "../MYSTL/deque.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 窗口已满时挤掉最旧的样本
+inline void window_push(mystl::circular_buffer<int>& c, int x, size_t){
+    c.push_back(x);
+}
+template <class Deque>
+void window_push(Deque& c, int x, size_t window){
+    c.push_back(x);
+    if(c.size() > window)
+        c.pop_front();
+}
+
+// 大小为 window 的滑动窗口，放入 times 个样本，每次读取窗口中的一个样本
+template <class Con>
+string time_window(int times, size_t window){
+    Con c(window);
+    c.clear();
+    const auto t1 = std::chrono::system_clock::now();
+    long long sum = 0;
+    for(int i = 0; i < times; i++){
+        window_push(c, i, window);
+        sum += c[static_cast<size_t>(i) * 7 % c.size()];
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+void circular_buffer_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------ Run container test : circular_buffer -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = { 1,2,3,4,5,6 };
+    mystl::circular_buffer<int> c1(5);
+    mystl::circular_buffer<int> c2(4, { 1,2,3 }, mystl::circular_buffer_mode::reject);
+    FUN_VALUE(c1.capacity());
+    FUN_AFTER(c1, c1.append_range(a, a + 6));
+    FUN_AFTER(c1, c1.push_back(7));
+    FUN_AFTER(c1, c1.push_front(0));
+    FUN_AFTER(c1, c1.pop_front_n(3));
+    FUN_AFTER(c1, c1.append_range(a, a + 4));
+    FUN_VALUE(c1.array_one().size());
+    FUN_VALUE(c1.array_two().size());
+    FUN_VALUE(c1[2]);
+    FUN_AFTER(c1, c1.pop_back());
+    std::cout << std::boolalpha;
+    FUN_VALUE(c2.push_back(4));
+    FUN_VALUE(c2.push_back(5));
+    FUN_VALUE(c2.full());
+    std::cout << std::noboolalpha;
+    FUN_AFTER(c2, c2.pop_front());
+    FUN_VALUE(c2.append_range(a, a + 6));
+    COUT(c2);
+    FUN_AFTER(c2, c2.clear());
+    PASSED;
+
+    int times = 10000000;
+    string cb_times1 = time_window<mystl::circular_buffer<int>>(times, 64);
+    string cb_times2 = time_window<mystl::circular_buffer<int>>(times, 4096);
+    string cb_times3 = time_window<mystl::circular_buffer<int>>(times, 1 << 20);
+    string mystl_times1 = time_window<mystl::deque<int>>(times, 64);
+    string mystl_times2 = time_window<mystl::deque<int>>(times, 4096);
+    string mystl_times3 = time_window<mystl::deque<int>>(times, 1 << 20);
+    string stl_times1 = time_window<std::deque<int>>(times, 64);
+    string stl_times2 = time_window<std::deque<int>>(times, 4096);
+    string stl_times3 = time_window<std::deque<int>>(times, 1 << 20);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 10^7 x slide window |  window 64  | window 4096 | window 2^20 |\n";
+    std::cout << "|   circular_buffer   | "<<cb_times1 + " | " << cb_times2 + " | " + cb_times3 + " |\n";
+    std::cout << "|    mystl::deque     | "<<mystl_times1 + " | " << mystl_times2 + " | " + mystl_times3 + " |\n";
+    std::cout << "|     std::deque      | "<<stl_times1 + " | " << stl_times2 + " | " + stl_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -8,6 +8,10 @@
 #include <chrono>
 #include <iomanip>
 #include <deque>
+#include <vector>
+#include <algorithm>
+#include "../MYSTL/vector.h"
+#include "../MYSTL/algo.h"
 
 string time_push_back(int times, mystl::deque<int> dq){
     const auto t1 = std::chrono::system_clock::now();
@@ -29,7 +33,234 @@ string time_push_back(int times, std::deque<int> dq){
     string str1 = to_string(duration1) + "ms";
     return str1;
 }
+// 容器中放入 len 个元素，再按事先生成的随机下标访问 times 次
+template <class Con>
+string time_random_access(int times, int len){
+    Con c;
+    for(int i = 0; i < len; i++)
+        c.push_back(i);
+    std::vector<int> idx(times);
+    for(auto& i : idx)
+        i = rand() % len;
+    const auto t1 = std::chrono::system_clock::now();
+    long long sum = 0;
+    for(int i = 0; i < times; i++)
+        sum += c[idx[i]];
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+// 保持 depth 个元素，队尾进队头出 times 次
+template <class Con>
+string time_fifo(int times, int depth){
+    Con c;
+    for(int i = 0; i < depth; i++)
+        c.push_back(i);
+    const auto t1 = std::chrono::system_clock::now();
+    long long sum = 0;
+    for(int i = 0; i < times; i++){
+        c.push_back(i);
+        sum += c.front();
+        c.pop_front();
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+// 各自使用本库的 copy 和 count
+inline size_t copy_count(const mystl::deque<int>& c, int* out, int value){
+    mystl::copy(c.begin(), c.end(), out);
+    return mystl::count(c.begin(), c.end(), value);
+}
+inline size_t copy_count(const std::deque<int>& c, int* out, int value){
+    std::copy(c.begin(), c.end(), out);
+    return std::count(c.begin(), c.end(), value);
+}
+
+// 容器中放入 len 个元素，copy 到数组再 count 一遍，重复 times 次
+template <class Con>
+string time_copy_count(int times, int len){
+    Con c;
+    for(int i = 0; i < len; i++)
+        c.push_back(i & 7);
+    mystl::vector<int> v(len);
+    const auto t1 = std::chrono::system_clock::now();
+    size_t sum = 0;
+    for(int i = 0; i < times; i++)
+        sum += copy_count(c, v.data(), i & 7);
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+// 以下检查 deque 专用的 copy / move / fill / find 等重载，与 std::deque 上的结果逐个比较
+// 缓冲区取得很小，并用 push_front 改变起始偏移，使区间两端和目标位置落在缓冲区的各个位置上
+
+// 先 push_front front 个元素，再 push_back back 个元素，值依次为 base, base + 1, ...
+template <class D>
+void deque_fill_seq(D& d, int front, int back, int base){
+    for(int i = front - 1; i >= 0; i--)
+        d.push_front(base + i);
+    for(int i = front; i < front + back; i++)
+        d.push_back(base + i);
+}
 
+template <class D1, class D2>
+bool deque_same(const D1& a, const D2& b){
+    if(a.size() != b.size())
+        return false;
+    for(size_t i = 0; i < a.size(); i++)
+        if(a[i] != b[i])
+            return false;
+    return true;
+}
+
+// BufSize 不同的两个 deque 之间 copy / copy_backward / move
+template <size_t B1, size_t B2>
+bool deque_cross_copy_matches(){
+    const int n = 13;
+    for(int off = 0; off < 4; off++)
+    for(int f = 0; f <= n; f++)
+    for(int l = f; l <= n; l++)
+    for(int r = 0; r + (l - f) <= n; r++){
+        mystl::deque<int, mystl::allocator<int>, B1> src;
+        mystl::deque<int, mystl::allocator<int>, B2> dst1, dst2, dst3;
+        std::deque<int> ssrc, sdst1, sdst2;
+        deque_fill_seq(src, off, n - off, 0);
+        deque_fill_seq(ssrc, off, n - off, 0);
+        deque_fill_seq(dst1, 3 - off, n - 3 + off, 100);
+        deque_fill_seq(dst2, 3 - off, n - 3 + off, 100);
+        deque_fill_seq(dst3, 3 - off, n - 3 + off, 100);
+        deque_fill_seq(sdst1, 3 - off, n - 3 + off, 100);
+        deque_fill_seq(sdst2, 3 - off, n - 3 + off, 100);
+        mystl::copy(src.begin() + f, src.begin() + l, dst1.begin() + r);
+        mystl::copy_backward(src.begin() + f, src.begin() + l, dst2.begin() + r + (l - f));
+        mystl::move(src.begin() + f, src.begin() + l, dst3.begin() + r);
+        std::copy(ssrc.begin() + f, ssrc.begin() + l, sdst1.begin() + r);
+        std::copy_backward(ssrc.begin() + f, ssrc.begin() + l, sdst2.begin() + r + (l - f));
+        if(!deque_same(dst1, sdst1) || !deque_same(dst2, sdst2) || !deque_same(dst3, sdst1))
+            return false;
+    }
+    return true;
+}
+
+// 同一个 deque 内重叠的 copy（向前移）和 copy_backward / move_backward（向后移）
+template <size_t B>
+bool deque_overlap_copy_matches(){
+    const int n = 13;
+    for(int off = 0; off < 4; off++)
+    for(int f = 0; f <= n; f++)
+    for(int l = f; l <= n; l++)
+    for(int r = 0; r + (l - f) <= n; r++){
+        mystl::deque<int, mystl::allocator<int>, B> d;
+        std::deque<int> sd;
+        deque_fill_seq(d, off, n - off, 0);
+        deque_fill_seq(sd, off, n - off, 0);
+        if(r <= f){
+            mystl::copy(d.begin() + f, d.begin() + l, d.begin() + r);
+            std::copy(sd.begin() + f, sd.begin() + l, sd.begin() + r);
+        }
+        else if(r % 2 == 0){
+            mystl::copy_backward(d.begin() + f, d.begin() + l, d.begin() + r + (l - f));
+            std::copy_backward(sd.begin() + f, sd.begin() + l, sd.begin() + r + (l - f));
+        }
+        else{
+            mystl::move_backward(d.begin() + f, d.begin() + l, d.begin() + r + (l - f));
+            std::copy_backward(sd.begin() + f, sd.begin() + l, sd.begin() + r + (l - f));
+        }
+        if(!deque_same(d, sd))
+            return false;
+    }
+    return true;
+}
+
+// 指针区间 copy / move 到 deque，deque 区间 copy 到指针
+template <size_t B>
+bool deque_pointer_copy_matches(){
+    const int n = 13;
+    int a[n];
+    for(int i = 0; i < n; i++)
+        a[i] = 50 + i;
+    for(int off = 0; off < 4; off++)
+    for(int f = 0; f <= n; f++)
+    for(int l = f; l <= n; l++)
+    for(int r = 0; r + (l - f) <= n; r++){
+        mystl::deque<int, mystl::allocator<int>, B> d1, d2;
+        std::deque<int> sd;
+        deque_fill_seq(d1, off, n - off, 0);
+        deque_fill_seq(d2, off, n - off, 0);
+        deque_fill_seq(sd, off, n - off, 0);
+        mystl::copy(a + f, a + l, d1.begin() + r);
+        mystl::move(a + f, a + l, d2.begin() + r);
+        std::copy(a + f, a + l, sd.begin() + r);
+        if(!deque_same(d1, sd) || !deque_same(d2, sd))
+            return false;
+        int out[n] = { 0 };
+        int sout[n] = { 0 };
+        mystl::copy(d1.begin() + f, d1.begin() + l, out + r);
+        std::copy(sd.begin() + f, sd.begin() + l, sout + r);
+        if(!std::equal(out, out + n, sout))
+            return false;
+    }
+    return true;
+}
+
+// 跨缓冲区的 fill / fill_n / find / count / for_each / equal
+template <size_t B>
+bool deque_range_algo_matches(){
+    const int n = 13;
+    for(int off = 0; off < 4; off++)
+    for(int f = 0; f <= n; f++)
+    for(int l = f; l <= n; l++){
+        mystl::deque<int, mystl::allocator<int>, B> d, d2;
+        std::deque<int> sd;
+        deque_fill_seq(d, off, n - off, 0);
+        deque_fill_seq(sd, off, n - off, 0);
+        for(int i = 0; i < n; i++){
+            d[i] %= 5;
+            sd[i] %= 5;
+        }
+        deque_fill_seq(d2, 0, n, 0);
+        for(int i = 0; i < n; i++)
+            d2[i] = d[i];
+        const int v = (f + l) % 5;
+        if((mystl::find(d.begin() + f, d.begin() + l, v) - d.begin()) !=
+           (std::find(sd.begin() + f, sd.begin() + l, v) - sd.begin()))
+            return false;
+        if(mystl::count(d.begin() + f, d.begin() + l, v) !=
+           static_cast<size_t>(std::count(sd.begin() + f, sd.begin() + l, v)))
+            return false;
+        long long sum = 0, ssum = 0;
+        mystl::for_each(d.begin() + f, d.begin() + l, [&sum](int x){ sum = sum * 7 + x; });
+        std::for_each(sd.begin() + f, sd.begin() + l, [&ssum](int x){ ssum = ssum * 7 + x; });
+        if(sum != ssum)
+            return false;
+        if(!mystl::equal(d.begin() + f, d.begin() + l, d2.begin() + f))
+            return false;
+        if(l > f){
+            d2[l - 1] += 1;
+            if(mystl::equal(d.begin() + f, d.begin() + l, d2.begin() + f))
+                return false;
+        }
+        mystl::fill(d.begin() + f, d.begin() + l, 9);
+        std::fill(sd.begin() + f, sd.begin() + l, 9);
+        if(!deque_same(d, sd))
+            return false;
+        mystl::fill_n(d.begin() + f, l - f, 7);
+        std::fill_n(sd.begin() + f, l - f, 7);
+        if(!deque_same(d, sd))
+            return false;
+    }
+    return true;
+}
 
 namespace mystl{
 
@@ -89,6 +320,21 @@ void deque_test(){
     std::cout << std::noboolalpha;
     FUN_VALUE(d1.size());
     FUN_VALUE(d1.max_size());
+    // 缓冲区大小取整到 2 的幂
+    FUN_VALUE(mystl::deque<int>::buffer_size);
+    FUN_VALUE((mystl::deque<int, mystl::allocator<int>, 100>::buffer_size));
+    mystl::deque<int, mystl::allocator<int>, 4> d11{ 1,2,3,4,5,6,7,8,9 };
+    FUN_AFTER(d11, d11.push_front(0));
+    FUN_VALUE(d11[9]);
+    FUN_VALUE(*(d11.end() - 6));
+    std::cout << std::boolalpha;
+    FUN_VALUE((deque_cross_copy_matches<4, 4>()));
+    FUN_VALUE((deque_cross_copy_matches<4, 8>()));
+    FUN_VALUE((deque_cross_copy_matches<8, 2>()));
+    FUN_VALUE((deque_overlap_copy_matches<4>()));
+    FUN_VALUE((deque_pointer_copy_matches<4>()));
+    FUN_VALUE((deque_range_algo_matches<4>()));
+    std::cout << std::noboolalpha;
     PASSED;
 
 
@@ -112,6 +358,49 @@ void deque_test(){
     std::cout << "|        std          |  "<<stl_times1 + " | " << stl_times2 + " |" + stl_times3 + " |\n";
     std::cout << "|---------------------|-------------|-------------|-------------|\n";
     PASSED;
+
+    string dq_rand1 = time_random_access<mystl::deque<int>>(times3, 100000);
+    string dq_rand2 = time_random_access<mystl::deque<int>>(times3, 1000000);
+    string dq_rand3 = time_random_access<mystl::deque<int>>(times3, 10000000);
+    string vec_rand1 = time_random_access<mystl::vector<int>>(times3, 100000);
+    string vec_rand2 = time_random_access<mystl::vector<int>>(times3, 1000000);
+    string vec_rand3 = time_random_access<mystl::vector<int>>(times3, 10000000);
+    string stl_rand1 = time_random_access<std::deque<int>>(times3, 100000);
+    string stl_rand2 = time_random_access<std::deque<int>>(times3, 1000000);
+    string stl_rand3 = time_random_access<std::deque<int>>(times3, 10000000);
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  10^7 x c[rand()]   |    100000   |   1000000   |   10000000  |\n";
+    std::cout << "|    mystl::deque     | "<<dq_rand1 + " | " << dq_rand2 + " | " + dq_rand3 + " |\n";
+    std::cout << "|    mystl::vector    | "<<vec_rand1 + " | " << vec_rand2 + " | " + vec_rand3 + " |\n";
+    std::cout << "|     std::deque      | "<<stl_rand1 + " | " << stl_rand2 + " | " + stl_rand3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+
+    string dq_fifo1 = time_fifo<mystl::deque<int>>(times3, 100);
+    string dq_fifo2 = time_fifo<mystl::deque<int>>(times3, 10000);
+    string dq_fifo3 = time_fifo<mystl::deque<int>>(times3, 1000000);
+    string stl_fifo1 = time_fifo<std::deque<int>>(times3, 100);
+    string stl_fifo2 = time_fifo<std::deque<int>>(times3, 10000);
+    string stl_fifo3 = time_fifo<std::deque<int>>(times3, 1000000);
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 10^7 x push/pop at  |  depth 100  | depth 10000 |depth 1000000|\n";
+    std::cout << "|    mystl::deque     | "<<dq_fifo1 + " | " << dq_fifo2 + " | " + dq_fifo3 + " |\n";
+    std::cout << "|     std::deque      | "<<stl_fifo1 + " | " << stl_fifo2 + " | " + stl_fifo3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+
+    string dq_scan1 = time_copy_count<mystl::deque<int>>(100, 100000);
+    string dq_scan2 = time_copy_count<mystl::deque<int>>(100, 1000000);
+    string dq_scan3 = time_copy_count<mystl::deque<int>>(10, 10000000);
+    string stl_scan1 = time_copy_count<std::deque<int>>(100, 100000);
+    string stl_scan2 = time_copy_count<std::deque<int>>(100, 1000000);
+    string stl_scan3 = time_copy_count<std::deque<int>>(10, 10000000);
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|     copy + count    | 100 x 10^5  | 100 x 10^6  |  10 x 10^7  |\n";
+    std::cout << "|    mystl::deque     | "<<dq_scan1 + " | " << dq_scan2 + " | " + dq_scan3 + " |\n";
+    std::cout << "|     std::deque      | "<<stl_scan1 + " | " << stl_scan2 + " | " + stl_scan3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
 }
 
 
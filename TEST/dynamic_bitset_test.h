@@ -0,0 +1,117 @@
+#ifndef MYTINYSTL_DYNAMIC_BITSET_TEST_H_
+#define MYTINYSTL_DYNAMIC_BITSET_TEST_H_
+
+// dynamic_bitset test : 测试 dynamic_bitset 的接口与按行过滤时 and / count 的性能
+
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <stdexcept>
+
+#include "../MYSTL/dynamic_bitset.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 两组各 len 行的标记求交集并统计行数，重复 times 次
+string time_filter_bitset(int times, size_t len){
+    mystl::dynamic_bitset a(len), b(len);
+    for(size_t i = 0; i < len; i += 3)
+        a[i] = true;
+    for(size_t i = 0; i < len; i += 5)
+        b[i] = true;
+    const auto t1 = std::chrono::system_clock::now();
+    size_t sum = 0;
+    for(int i = 0; i < times; i++){
+        mystl::dynamic_bitset c(a);
+        c &= b;
+        sum += c.count();
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+template <class Vec>
+string time_filter_bytes(int times, size_t len){
+    Vec a(len), b(len);
+    for(size_t i = 0; i < len; i += 3)
+        a[i] = true;
+    for(size_t i = 0; i < len; i += 5)
+        b[i] = true;
+    const auto t1 = std::chrono::system_clock::now();
+    size_t sum = 0;
+    for(int i = 0; i < times; i++){
+        Vec c(a);
+        for(size_t j = 0; j < len; j++)
+            c[j] = c[j] && b[j];
+        for(size_t j = 0; j < len; j++)
+            sum += c[j] ? 1 : 0;
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+void dynamic_bitset_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : dynamic_bitset -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    mystl::dynamic_bitset b1(10);
+    mystl::dynamic_bitset b2(10, true);
+    STR_FUN_AFTER(b1.to_string(), b1.set(1).set(3).set(8));
+    STR_FUN_AFTER(b1.to_string(), b1.flip(0));
+    STR_FUN_AFTER(b2.to_string(), b2.reset(3));
+    STR_FUN_AFTER(b2.to_string(), b2 &= b1);
+    STR_FUN_AFTER(b2.to_string(), b2 |= b1);
+    STR_FUN_AFTER(b2.to_string(), b2 ^= mystl::dynamic_bitset(10, true));
+    STR_FUN_AFTER(b2.to_string(), b2.and_not(b1));
+    STR_FUN_AFTER(b1.to_string(), b1.push_back(true));
+    STR_FUN_AFTER(b1.to_string(), b1.resize(70, true));
+    STR_FUN_AFTER(b1.to_string(), b1.resize(12));
+    FUN_VALUE(b1.count());
+    FUN_VALUE(b1.find_first());
+    FUN_VALUE(b1.find_next(3));
+    FUN_VALUE(b1.find_next(10));
+    FUN_VALUE(b1.num_words());
+    std::cout << std::boolalpha;
+    FUN_VALUE(b1.test(8));
+    FUN_VALUE(b2.any());
+    FUN_VALUE((~b2).all());
+    FUN_VALUE((b1 == b1));
+    std::cout << std::noboolalpha;
+    try{
+        b1.set(12);
+    }
+    catch(const std::out_of_range& e){
+        std::cout << " b1.set(12) : " << e.what() << "\n";
+    }
+    PASSED;
+
+    int times = 20;
+    string bitset_times1 = time_filter_bitset(times, 100000);
+    string bitset_times2 = time_filter_bitset(times, 1000000);
+    string bitset_times3 = time_filter_bitset(times, 10000000);
+    string char_times1 = time_filter_bytes<std::vector<char>>(times, 100000);
+    string char_times2 = time_filter_bytes<std::vector<char>>(times, 1000000);
+    string char_times3 = time_filter_bytes<std::vector<char>>(times, 10000000);
+    string bool_times1 = time_filter_bytes<std::vector<bool>>(times, 100000);
+    string bool_times2 = time_filter_bytes<std::vector<bool>>(times, 1000000);
+    string bool_times3 = time_filter_bytes<std::vector<bool>>(times, 10000000);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 20 x (and + count)  |    10^5     |    10^6     |    10^7     |\n";
+    std::cout << "|   dynamic_bitset    | "<<bitset_times1 + " | " << bitset_times2 + " | " + bitset_times3 + " |\n";
+    std::cout << "|  std::vector<char>  | "<<char_times1 + " | " << char_times2 + " | " + char_times3 + " |\n";
+    std::cout << "|  std::vector<bool>  | "<<bool_times1 + " | " << bool_times2 + " | " + bool_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -0,0 +1,166 @@
+#ifndef MYTINYSTL_LOCKFREE_STACK_TEST_H_
+#define MYTINYSTL_LOCKFREE_STACK_TEST_H_
+
+// lockfree_stack test : 测试 lockfree_stack 的接口与多个线程共用一个对象空闲链表时的性能
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <iterator>
+
+#include "../MYSTL/lockfree_stack.h"
+#include "../MYSTL/stack.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 每个线程反复取出一个对象再放回，取不到时新建一个
+string time_lockfree_stack(int threads, int len){
+    mystl::lockfree_stack<int> s;
+    s.reserve(threads);
+    std::atomic<long long> sum(0);
+    const int per = len / threads;
+    const auto t1 = std::chrono::system_clock::now();
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; t++){
+        workers.emplace_back([&s, &sum, per](){
+            long long local = 0;
+            for(int i = 0; i < per; i++){
+                int x = i;
+                if(s.try_pop(x))
+                    local += x;
+                s.push(x);
+            }
+            sum += local;
+        });
+    }
+    for(auto& w : workers)
+        w.join();
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum.load());
+    return str1;
+}
+
+// 同样的用法，共用一个互斥锁保护的 mystl::stack
+string time_locked_stack(int threads, int len){
+    mystl::stack<int> s;
+    std::mutex m;
+    std::atomic<long long> sum(0);
+    const int per = len / threads;
+    const auto t1 = std::chrono::system_clock::now();
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; t++){
+        workers.emplace_back([&s, &m, &sum, per](){
+            long long local = 0;
+            for(int i = 0; i < per; i++){
+                int x = i;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    if(!s.empty()){
+                        x = s.top();
+                        s.pop();
+                        local += x;
+                    }
+                }
+                std::lock_guard<std::mutex> lock(m);
+                s.push(x);
+            }
+            sum += local;
+        });
+    }
+    for(auto& w : workers)
+        w.join();
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum.load());
+    return str1;
+}
+
+// 每次用 push_range 放入 32 个，再用 pop_all 全部取回
+string time_lockfree_stack_batch(int threads, int len){
+    mystl::lockfree_stack<int> s;
+    std::atomic<long long> sum(0);
+    const int per = len / threads;
+    const auto t1 = std::chrono::system_clock::now();
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; t++){
+        workers.emplace_back([&s, &sum, per](){
+            long long local = 0;
+            int in[32];
+            mystl::vector<int> out;
+            for(int i = 0; i < per; i += 32){
+                for(int k = 0; k < 32; k++)
+                    in[k] = i + k;
+                s.push_range(in, in + 32);
+                out.clear();
+                s.pop_all(std::back_inserter(out));
+                for(size_t k = 0; k < out.size(); k++)
+                    local += out[k];
+            }
+            sum += local;
+        });
+    }
+    for(auto& w : workers)
+        w.join();
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum.load());
+    return str1;
+}
+
+void lockfree_stack_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : lockfree_stack -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = { 1,2,3,4,5 };
+    int b[8] = { 0 };
+    int x = 0;
+    mystl::lockfree_stack<int> s1;
+    s1.reserve(4);
+    s1.push(1);
+    s1.emplace(2);
+    s1.push_range(a, a + 5);
+    std::cout << std::boolalpha;
+    FUN_VALUE(s1.try_pop(x));
+    FUN_VALUE(x);
+    FUN_VALUE(s1.pop_all(b));
+    FUN_VALUE(b[0]);
+    FUN_VALUE(b[5]);
+    FUN_VALUE(s1.empty());
+    FUN_VALUE(s1.try_pop(x));
+    std::cout << std::noboolalpha;
+    s1.push(6);
+    s1.clear();
+    s1.shrink_to_fit();
+    PASSED;
+
+    const int len = 1000000;
+    string lf_times1 = time_lockfree_stack(1, len);
+    string lf_times2 = time_lockfree_stack(2, len);
+    string lf_times3 = time_lockfree_stack(4, len);
+    string batch_times1 = time_lockfree_stack_batch(1, len);
+    string batch_times2 = time_lockfree_stack_batch(2, len);
+    string batch_times3 = time_lockfree_stack_batch(4, len);
+    string lock_times1 = time_locked_stack(1, len);
+    string lock_times2 = time_locked_stack(2, len);
+    string lock_times3 = time_locked_stack(4, len);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 10^6 pop + push     |  1 thread   |  2 threads  |  4 threads  |\n";
+    std::cout << "|   lockfree_stack    | "<<lf_times1 + " | " << lf_times2 + " | " + lf_times3 + " |\n";
+    std::cout << "| push_range / pop_all| "<<batch_times1 + " | " << batch_times2 + " | " + batch_times3 + " |\n";
+    std::cout << "| mutex + mystl::stack| "<<lock_times1 + " | " << lock_times2 + " | " + lock_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -0,0 +1,185 @@
+#ifndef MYTINYSTL_MEMORY_RESOURCE_TEST_H_
+#define MYTINYSTL_MEMORY_RESOURCE_TEST_H_
+
+// memory_resource test : 测试各内存资源与 polymorphic_allocator 的接口，以及节点容器使用它们时的性能
+
+#include <iostream>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "../MYSTL/memory_resource.h"
+#include "../MYSTL/vector.h"
+#include "../MYSTL/list.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 转交给 new_delete_resource，并记录尚未归还的块数
+class counting_resource : public mystl::memory_resource{
+public:
+    long outstanding = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override{
+        void* p = mystl::new_delete_resource()->allocate(bytes, alignment);
+        ++outstanding;
+        return p;
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override{
+        --outstanding;
+        mystl::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const mystl::memory_resource& other) const noexcept override{
+        return this == &other;
+    }
+};
+
+// 几个线程在同一个 synchronized_pool_resource 上各自建表、清空，结束后检查内容
+inline bool synchronized_pool_threads(mystl::synchronized_pool_resource& pool, int threads, int len){
+    typedef mystl::list<int, mystl::polymorphic_allocator<int>> pmr_list;
+    std::vector<int> ok(threads, 0);
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; t++){
+        workers.emplace_back([&pool, &ok, t, len](){
+            pmr_list l(&pool);
+            for(int r = 0; r < 10; r++){
+                l.clear();
+                for(int i = 0; i < len; i++)
+                    l.push_back(t * len + i);
+            }
+            int expect = t * len;
+            bool good = true;
+            for(auto x : l)
+                good = good && x == expect++;
+            ok[t] = good && expect == (t + 1) * len;
+        });
+    }
+    for(auto& w : workers)
+        w.join();
+    for(auto x : ok)
+        if(!x)
+            return false;
+    return true;
+}
+
+inline bool null_resource_throws(){
+    try{
+        mystl::null_memory_resource()->allocate(8);
+    }
+    catch(std::bad_alloc&){
+        return true;
+    }
+    return false;
+}
+
+// 用 Resource 作为 list 的内存来源，push_back len 个元素后整体析构
+template <class Resource>
+string time_pmr_list(int len){
+    const auto t1 = std::chrono::system_clock::now();
+    {
+        Resource r;
+        mystl::list<int, mystl::polymorphic_allocator<int>> l(&r);
+        for(int i = 0; i < len; i++)
+            l.push_back(i);
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    return str1;
+}
+
+string time_default_list(int len){
+    const auto t1 = std::chrono::system_clock::now();
+    {
+        mystl::list<int> l;
+        for(int i = 0; i < len; i++)
+            l.push_back(i);
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    return str1;
+}
+
+void memory_resource_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------ Run container test : memory_resource -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    counting_resource up;
+    std::cout << std::boolalpha;
+    FUN_VALUE((*mystl::new_delete_resource() == *mystl::new_delete_resource()));
+    FUN_VALUE(null_resource_throws());
+    mystl::memory_resource* old = mystl::set_default_resource(&up);
+    FUN_VALUE((mystl::get_default_resource() == &up));
+    mystl::set_default_resource(old);
+
+    // 先用调用者的 buffer，用完才向上游申请，release 全部归还
+    alignas(16) char buf[256];
+    mystl::monotonic_buffer_resource arena(buf, sizeof(buf), &up);
+    void* a1 = arena.allocate(100);
+    FUN_VALUE((a1 == static_cast<void*>(buf)));
+    FUN_VALUE(up.outstanding);
+    arena.allocate(300);
+    FUN_VALUE(up.outstanding);
+    arena.release();
+    FUN_VALUE(up.outstanding);
+
+    {   // 容器要先于 release 析构
+        mystl::vector<int, mystl::polymorphic_allocator<int>> v1(&arena);
+        FUN_AFTER(v1, v1.assign(8, 8));
+        FUN_AFTER(v1, v1.push_back(9));
+        FUN_VALUE((v1.get_allocator().resource() == &arena));
+    }
+    arena.release();
+
+    // 同一级的块释放后复用，超出最大级的请求直接交给上游，release 时一并归还
+    mystl::pool_options opts;
+    opts.largest_required_pool_block = 256;
+    mystl::unsynchronized_pool_resource pool(opts, &up);
+    void* p1 = pool.allocate(24);
+    pool.deallocate(p1, 24);
+    FUN_VALUE((pool.allocate(24) == p1));
+    pool.allocate(4096);
+    FUN_VALUE((up.outstanding >= 2));
+    pool.release();
+    FUN_VALUE(up.outstanding);
+
+    {
+        mystl::list<int, mystl::polymorphic_allocator<int>> l1(&pool);
+        FUN_AFTER(l1, l1.push_back(1));
+        FUN_AFTER(l1, l1.push_front(0));
+    }
+    pool.release();
+
+    mystl::synchronized_pool_resource spool(&up);
+    FUN_VALUE((spool.upstream_resource() == &up));
+    FUN_VALUE(synchronized_pool_threads(spool, 4, 1000));
+    spool.release();
+    FUN_VALUE(up.outstanding);
+    std::cout << std::noboolalpha;
+    PASSED;
+
+    string default_times1 = time_default_list(100000);
+    string default_times2 = time_default_list(1000000);
+    string default_times3 = time_default_list(5000000);
+    string pool_times1 = time_pmr_list<mystl::unsynchronized_pool_resource>(100000);
+    string pool_times2 = time_pmr_list<mystl::unsynchronized_pool_resource>(1000000);
+    string pool_times3 = time_pmr_list<mystl::unsynchronized_pool_resource>(5000000);
+    string arena_times1 = time_pmr_list<mystl::monotonic_buffer_resource>(100000);
+    string arena_times2 = time_pmr_list<mystl::monotonic_buffer_resource>(1000000);
+    string arena_times3 = time_pmr_list<mystl::monotonic_buffer_resource>(5000000);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| list push_back+free |    100000   |   1000000   |   5000000   |\n";
+    std::cout << "|      allocator      | "<<default_times1 + " | " << default_times2 + " | " + default_times3 + " |\n";
+    std::cout << "|  unsync_pool_res    | "<<pool_times1 + " | " << pool_times2 + " | " + pool_times3 + " |\n";
+    std::cout << "| monotonic_buffer_res| "<<arena_times1 + " | " << arena_times2 + " | " + arena_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -0,0 +1,123 @@
+#ifndef MYTINYSTL_MMAP_VECTOR_TEST_H_
+#define MYTINYSTL_MMAP_VECTOR_TEST_H_
+
+// mmap_vector test : 测试 mmap_vector 的接口与重新打开文件时的性能
+
+#include <cstdio>
+#include <iostream>
+#include <chrono>
+#include <stdexcept>
+
+#include "../MYSTL/mmap_vector.h"
+#include "../MYSTL/vector.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 写入 len 个元素的文件，times 次重新映射并读取中间的元素
+string time_mmap_open(int times, size_t len, const char* path){
+    {
+        mystl::mmap_vector<uint64_t> v(path, mystl::mmap_mode::create);
+        for(size_t i = 0; i < len; i++)
+            v.push_back(i);
+    }
+    const auto t1 = std::chrono::system_clock::now();
+    uint64_t sum = 0;
+    for(int i = 0; i < times; i++){
+        mystl::mmap_vector<uint64_t> v(path, mystl::mmap_mode::read_only);
+        sum += v[len / 2];
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+// 同样的文件，times 次用 fread 读入 mystl::vector
+string time_vector_load(int times, size_t len, const char* path){
+    {
+        mystl::mmap_vector<uint64_t> v(path, mystl::mmap_mode::create);
+        for(size_t i = 0; i < len; i++)
+            v.push_back(i);
+    }
+    const auto t1 = std::chrono::system_clock::now();
+    uint64_t sum = 0;
+    for(int i = 0; i < times; i++){
+        std::FILE* f = std::fopen(path, "rb");
+        mystl::vector<uint64_t> v;
+        v.resize_uninitialized(len);
+        std::fseek(f, 64, SEEK_SET);
+        sum += std::fread(v.data(), sizeof(uint64_t), len, f);
+        std::fclose(f);
+        sum += v[len / 2];
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+void mmap_vector_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : mmap_vector ---------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    const char* path = "mmap_vector_test.bin";
+    int a[] = { 1,2,3,4,5 };
+    {
+        mystl::mmap_vector<int> v1(path, mystl::mmap_mode::create);
+        FUN_AFTER(v1, v1.push_back(1));
+        FUN_AFTER(v1, v1.append(a, 5));
+        FUN_AFTER(v1, v1.insert(v1.begin() + 1, 2, 9));
+        FUN_AFTER(v1, v1.insert(v1.end(), a, a + 2));
+        FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 3));
+        FUN_AFTER(v1, v1.resize(10, 7));
+        FUN_AFTER(v1, v1.pop_back());
+        FUN_VALUE(v1.size());
+        FUN_AFTER(v1, v1.flush());
+    }
+    {
+        // 重新打开文件，元素原样保留
+        mystl::mmap_vector<int> v2(path, mystl::mmap_mode::read_only);
+        COUT(v2);
+        FUN_VALUE(v2.size());
+        FUN_VALUE(v2.at(3));
+        std::cout << std::boolalpha;
+        FUN_VALUE(v2.is_writable());
+        std::cout << std::noboolalpha;
+        try{
+            v2.push_back(1);
+        }
+        catch(const std::runtime_error& e){
+            std::cout << " v2.push_back(1) : " << e.what() << "\n";
+        }
+    }
+    {
+        mystl::mmap_vector<int> v3(path);
+        FUN_AFTER(v3, v3.push_back(6));
+        FUN_AFTER(v3, v3.assign(3, 3));
+    }
+    std::remove(path);
+    PASSED;
+
+    int times = 20;
+    string mmap_times1 = time_mmap_open(times, 100000, path);
+    string mmap_times2 = time_mmap_open(times, 1000000, path);
+    string mmap_times3 = time_mmap_open(times, 10000000, path);
+    string mystl_times1 = time_vector_load(times, 100000, path);
+    string mystl_times2 = time_vector_load(times, 1000000, path);
+    string mystl_times3 = time_vector_load(times, 10000000, path);
+    std::remove(path);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  20 x open uint64   |    10^5     |    10^6     |    10^7     |\n";
+    std::cout << "|     mmap_vector     | "<<mmap_times1 + " | " << mmap_times2 + " | " + mmap_times3 + " |\n";
+    std::cout << "| fread mystl::vector | "<<mystl_times1 + " | " << mystl_times2 + " | " + mystl_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
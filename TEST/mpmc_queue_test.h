@@ -0,0 +1,231 @@
+#ifndef MYTINYSTL_MPMC_QUEUE_TEST_H_
+#define MYTINYSTL_MPMC_QUEUE_TEST_H_
+
+// mpmc_queue test : 测试 mpmc_queue 的接口与多个生产者、消费者之间传递元素时的性能
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../MYSTL/mpmc_queue.h"
+#include "../MYSTL/queue.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// producers 个生产者用拷贝、原地构造、移动三种方式交替放入互不相同的 string，两个消费者取出，
+// 检查每个值恰好收到一次；容量很小，生产者经常要重试
+bool mpmc_string_once(int producers, int per){
+    mystl::mpmc_queue<std::string, true> q(4);
+    std::vector<std::string> got[2];
+    const int total = producers * per;
+    std::atomic<int> taken(0);
+    std::vector<std::thread> workers;
+    for(int t = 0; t < producers; t++){
+        workers.emplace_back([&q, t, per](){
+            for(int i = 0; i < per; i++){
+                std::string s = "value-" + std::to_string(t * per + i) + "-padding-beyond-sso";
+                if(i % 3 == 0)
+                    q.push(s);
+                else if(i % 3 == 1)
+                    q.emplace(s.c_str());
+                else
+                    while(!q.try_push_for(std::move(s), std::chrono::milliseconds(1)))
+                        ;
+            }
+        });
+    }
+    for(int c = 0; c < 2; c++){
+        workers.emplace_back([&q, &got, &taken, c, total](){
+            std::string s;
+            while(taken.load() < total){
+                if(q.try_pop_for(s, std::chrono::milliseconds(1))){
+                    got[c].push_back(s);
+                    ++taken;
+                }
+            }
+        });
+    }
+    for(auto& w : workers)
+        w.join();
+    std::vector<std::string> all(got[0]);
+    all.insert(all.end(), got[1].begin(), got[1].end());
+    std::vector<std::string> expect;
+    for(int i = 0; i < total; i++)
+        expect.push_back("value-" + std::to_string(i) + "-padding-beyond-sso");
+    std::sort(all.begin(), all.end());
+    std::sort(expect.begin(), expect.end());
+    return all == expect;
+}
+
+// 第 limit 次写入时抛出异常的输出迭代器
+struct mpmc_throwing_output{
+    int* out;
+    int  limit;
+    mpmc_throwing_output& operator*(){ return *this; }
+    mpmc_throwing_output& operator++(){ return *this; }
+    mpmc_throwing_output& operator=(int v){
+        if(limit-- == 0)
+            throw std::runtime_error("output full");
+        *out++ = v;
+        return *this;
+    }
+};
+
+// try_pop_n 写出时抛出异常，之后队列应能重新放满
+int mpmc_pop_n_throw_then_fill(){
+    mystl::mpmc_queue<int> q(4);
+    for(int i = 0; i < 4; i++)
+        q.try_push(i);
+    int b[4] = { 0 };
+    try{
+        q.try_pop_n(mpmc_throwing_output{ b, 1 }, 4);
+    }
+    catch(std::runtime_error&){
+    }
+    int pushed = 0;
+    for(int i = 0; i < 8; i++)
+        pushed += q.try_push(i) ? 1 : 0;
+    return pushed;
+}
+
+// threads 个生产者阻塞地 push，threads 个消费者用 pop_n 每次最多取 32 个
+string time_mpmc(int threads, int len){
+    mystl::mpmc_queue<int, true> q(1024);
+    std::atomic<long long> sum(0);
+    const int per = len / threads;
+    const auto t1 = std::chrono::system_clock::now();
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; t++){
+        workers.emplace_back([&q, per](){
+            for(int i = 0; i < per; i++)
+                q.push(i);
+        });
+        workers.emplace_back([&q, &sum, per](){
+            int buf[32];
+            long long local = 0;
+            for(int i = 0; i < per; ){
+                const int n = static_cast<int>(q.pop_n(buf, per - i < 32 ? per - i : 32));
+                for(int k = 0; k < n; k++)
+                    local += buf[k];
+                i += n;
+            }
+            sum += local;
+        });
+    }
+    for(auto& w : workers)
+        w.join();
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum.load());
+    return str1;
+}
+
+// 同样的线程数共用一个互斥锁保护的 mystl::queue
+string time_locked_mpmc(int threads, int len){
+    mystl::queue<int> q;
+    std::mutex m;
+    std::atomic<long long> sum(0);
+    const int per = len / threads;
+    const auto t1 = std::chrono::system_clock::now();
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; t++){
+        workers.emplace_back([&q, &m, per](){
+            for(int i = 0; i < per; i++){
+                std::lock_guard<std::mutex> lock(m);
+                q.push(i);
+            }
+        });
+        workers.emplace_back([&q, &m, &sum, per](){
+            long long local = 0;
+            for(int i = 0; i < per; ){
+                bool got = false;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    if(!q.empty()){
+                        local += q.front();
+                        q.pop();
+                        got = true;
+                    }
+                }
+                if(got)
+                    ++i;
+                else
+                    std::this_thread::yield();
+            }
+            sum += local;
+        });
+    }
+    for(auto& w : workers)
+        w.join();
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum.load());
+    return str1;
+}
+
+void mpmc_queue_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : mpmc_queue ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int b[6] = { 0 };
+    int x = 0;
+    mystl::mpmc_queue<int, true> q1(3);
+    FUN_VALUE(q1.capacity());
+    std::cout << std::boolalpha;
+    FUN_VALUE(q1.try_push(1));
+    FUN_VALUE(q1.try_emplace(2));
+    FUN_VALUE(q1.try_push_for(3, std::chrono::milliseconds(1)));
+    FUN_VALUE(q1.try_push(4));
+    FUN_VALUE(q1.try_push_for(5, std::chrono::milliseconds(1)));
+    FUN_VALUE(q1.size());
+    FUN_VALUE(q1.try_pop(x));
+    FUN_VALUE(x);
+    FUN_VALUE(q1.try_pop_n(b, 6));
+    FUN_VALUE(b[2]);
+    FUN_VALUE(q1.try_pop_for(x, std::chrono::milliseconds(1)));
+    FUN_VALUE(q1.empty());
+    std::cout << std::noboolalpha;
+    std::thread producer([&q1](){
+        for(int i = 1; i <= 6; i++)
+            q1.push(i);
+    });
+    for(int i = 0; i < 6; i++){
+        q1.pop(x);
+        std::cout << " " << x;
+    }
+    std::cout << "\n";
+    producer.join();
+    std::cout << std::boolalpha;
+    FUN_VALUE(mpmc_string_once(4, 3000));
+    FUN_VALUE(mpmc_pop_n_throw_then_fill());
+    std::cout << std::noboolalpha;
+    PASSED;
+
+    const int len = 1000000;
+    string mpmc_times1 = time_mpmc(1, len);
+    string mpmc_times2 = time_mpmc(2, len);
+    string mpmc_times3 = time_mpmc(4, len);
+    string lock_times1 = time_locked_mpmc(1, len);
+    string lock_times2 = time_locked_mpmc(2, len);
+    string lock_times3 = time_locked_mpmc(4, len);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 10^6 int, P + C     |    1 + 1    |    2 + 2    |    4 + 4    |\n";
+    std::cout << "|     mpmc_queue      | "<<mpmc_times1 + " | " << mpmc_times2 + " | " + mpmc_times3 + " |\n";
+    std::cout << "| mutex + mystl::queue| "<<lock_times1 + " | " << lock_times2 + " | " + lock_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -0,0 +1,133 @@
+#ifndef MYTINYSTL_NODE_POOL_TEST_H_
+#define MYTINYSTL_NODE_POOL_TEST_H_
+
+// node_pool test : 测试 node_pool / pool_allocator 的接口，以及节点容器使用 pool_allocator 时的性能
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../MYSTL/node_pool.h"
+#include "../MYSTL/list.h"
+#include "../MYSTL/map.h"
+#include "../MYSTL/unordered_map.h"
+#include "allocator_aware_test.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 几个线程同时用 pool_allocator 建表、清空，最后把节点交给另一个线程释放
+inline bool pool_allocator_threads(int threads, int len){
+    typedef mystl::list<int, mystl::pool_allocator<int>> pool_list;
+    std::vector<pool_list*> lists(threads, nullptr);
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; t++){
+        workers.emplace_back([&lists, t, len](){
+            pool_list* l = new pool_list;
+            for(int r = 0; r < 10; r++){
+                l->clear();
+                for(int i = 0; i < len; i++)
+                    l->push_back(t * len + i);
+            }
+            lists[t] = l;
+        });
+    }
+    for(auto& w : workers)
+        w.join();
+    bool ok = true;
+    for(int t = 0; t < threads; t++){
+        int expect = t * len;
+        for(auto x : *lists[t])
+            ok = ok && x == expect++;
+        ok = ok && expect == (t + 1) * len;
+    }
+    std::thread([&lists](){
+        for(auto l : lists)
+            delete l;
+    }).join();
+    return ok;
+}
+
+// 重复插入已存在的键时，新建的节点要归还
+inline bool pool_duplicate_key_balanced(){
+    typedef tracking_allocator<mystl::pair<const int, int>> pair_alloc;
+    typedef mystl::unordered_map<int, int, mystl::hash<int>, mystl::equal_to<int>, pair_alloc> umap;
+    alloc_stats s;
+    {
+        umap h{ pair_alloc(&s, 1) };
+        for(int r = 0; r < 3; r++)
+            for(int i = 0; i < 100; i++)
+                h.emplace(i, r);
+        if(h.size() != 100 || h.find(50)->second != 0)
+            return false;
+    }
+    return alloc_balanced(s);
+}
+
+// 按递减顺序插入 len 个键
+template <class Map>
+string time_map_insert(int len){
+    const auto t1 = std::chrono::system_clock::now();
+    {
+        Map m;
+        for(int i = len; i > 0; i--)
+            m[i] = i;
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    return str1;
+}
+
+void node_pool_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[--------------- Run container test : node_pool ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    mystl::node_pool p1(20);
+    FUN_VALUE(p1.block_size());
+    void* b1 = p1.allocate();
+    void* b2 = p1.allocate();
+    FUN_VALUE(static_cast<char*>(b2) - static_cast<char*>(b1));
+    std::cout << std::boolalpha;
+    p1.deallocate(b1);
+    FUN_VALUE((p1.allocate() == b1));  // 释放的块先被复用
+    p1.release();
+
+    mystl::list<int, mystl::pool_allocator<int>> l1;
+    FUN_AFTER(l1, l1.push_back(1));
+    FUN_AFTER(l1, l1.push_back(2));
+    FUN_AFTER(l1, l1.pop_front());
+    FUN_VALUE((mystl::pool_allocator<int>() == mystl::pool_allocator<double>()));
+
+    // 递减插入时每个新节点都成为最左节点，begin() 要随之更新
+    mystl::map<int, int, mystl::less<int>, mystl::pool_allocator<mystl::pair<const int, int>>> m1;
+    for(int i = 10; i > 0; i--)
+        m1[i] = i * i;
+    FUN_VALUE(m1.begin()->first);
+    FUN_VALUE(m1.size());
+    FUN_VALUE(pool_duplicate_key_balanced());
+    FUN_VALUE(pool_allocator_threads(4, 1000));
+    std::cout << std::noboolalpha;
+    PASSED;
+
+    typedef mystl::map<int, int> default_map;
+    typedef mystl::map<int, int, mystl::less<int>, mystl::pool_allocator<mystl::pair<const int, int>>> pool_map;
+    string default_times1 = time_map_insert<default_map>(100000);
+    string default_times2 = time_map_insert<default_map>(500000);
+    string default_times3 = time_map_insert<default_map>(1000000);
+    string pool_times1 = time_map_insert<pool_map>(100000);
+    string pool_times2 = time_map_insert<pool_map>(500000);
+    string pool_times3 = time_map_insert<pool_map>(1000000);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  map insert + free  |    100000   |    500000   |   1000000   |\n";
+    std::cout << "|      allocator      | "<<default_times1 + " | " << default_times2 + " | " + default_times3 + " |\n";
+    std::cout << "|    pool_allocator   | "<<pool_times1 + " | " << pool_times2 + " | " + pool_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -0,0 +1,211 @@
+#ifndef MYTINYSTL_PAIRING_HEAP_TEST_H_
+#define MYTINYSTL_PAIRING_HEAP_TEST_H_
+
+// pairing_heap test : 测试 pairing_heap 的接口与在随机图上跑 Dijkstra 的性能
+
+#include <iostream>
+#include <chrono>
+#include <queue>
+#include <vector>
+
+#include "../MYSTL/pairing_heap.h"
+#include "../MYSTL/queue.h"
+#include "../MYSTL/vector.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+void pairing_heap_print(mystl::pairing_heap<int> h)
+{
+  while (!h.empty())
+  {
+    std::cout << " " << h.top();
+    h.pop();
+  }
+  std::cout << std::endl;
+}
+//  pairing_heap 的遍历输出
+#define PAIRING_HEAP_COUT(h) do {                \
+    std::string h_name = #h;                     \
+    std::cout << " " << h_name << " :";          \
+    pairing_heap_print(h);                       \
+} while(0)
+
+#define PAIRING_HEAP_FUN_AFTER(con, fun) do {    \
+  std::string fun_name = #fun;                   \
+  std::cout << " After " << fun_name << " :\n";  \
+  fun;                                           \
+  PAIRING_HEAP_COUT(con);                        \
+} while(0)
+
+struct dijkstra_entry{
+    long long dist;
+    int       v;
+    bool operator<(const dijkstra_entry& rhs) const { return dist < rhs.dist; }
+    bool operator>(const dijkstra_entry& rhs) const { return dist > rhs.dist; }
+};
+
+// n 个顶点，每个顶点连向下一个顶点和另外 3 个随机顶点，边权随机，按 CSR 存放
+struct dijkstra_graph{
+    mystl::vector<int> offset;
+    mystl::vector<int> to;
+    mystl::vector<int> weight;
+
+    explicit dijkstra_graph(int n)
+      :offset(n + 1), to(4 * n), weight(4 * n)
+    {
+        srand(7);
+        for(int u = 0; u < n; u++){
+            offset[u] = 4 * u;
+            to[4 * u] = (u + 1) % n;
+            weight[4 * u] = rand() % 1000 + 1;
+            for(int k = 1; k < 4; k++){
+                to[4 * u + k] = rand() % n;
+                weight[4 * u + k] = rand() % 1000 + 1;
+            }
+        }
+        offset[n] = 4 * n;
+    }
+};
+
+// 每个顶点在堆中至多一个元素，距离变小时 decrease_key；peak 返回堆的最大元素个数
+string time_dijkstra_pairing(const dijkstra_graph& g, int n, size_t& peak){
+    typedef mystl::pairing_heap<dijkstra_entry, mystl::greater<dijkstra_entry>> heap_type;
+    const auto t1 = std::chrono::system_clock::now();
+    heap_type heap;
+    mystl::vector<long long> dist(n, -1);
+    mystl::vector<heap_type::handle> where(n);
+    mystl::vector<char> done(n, 0);
+    dist[0] = 0;
+    where[0] = heap.push(dijkstra_entry{0, 0});
+    peak = 0;
+    while(!heap.empty()){
+        peak = heap.size() > peak ? heap.size() : peak;
+        const dijkstra_entry e = heap.pop_top();
+        done[e.v] = 1;
+        for(int i = g.offset[e.v]; i < g.offset[e.v + 1]; i++){
+            const int w = g.to[i];
+            const long long nd = e.dist + g.weight[i];
+            if(done[w])
+                continue;
+            if(dist[w] < 0){
+                dist[w] = nd;
+                where[w] = heap.push(dijkstra_entry{nd, w});
+            }
+            else if(nd < dist[w]){
+                dist[w] = nd;
+                heap.decrease_key(where[w], dijkstra_entry{nd, w});
+            }
+        }
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(dist[n - 1]);
+    return str1;
+}
+
+// 距离变小时重复放入，取出时跳过已确定的顶点（lazy deletion）
+template <class PQ>
+string time_dijkstra_lazy(const dijkstra_graph& g, int n, size_t& peak){
+    const auto t1 = std::chrono::system_clock::now();
+    PQ heap;
+    mystl::vector<long long> dist(n, -1);
+    mystl::vector<char> done(n, 0);
+    dist[0] = 0;
+    heap.push(dijkstra_entry{0, 0});
+    peak = 0;
+    while(!heap.empty()){
+        peak = heap.size() > peak ? heap.size() : peak;
+        const dijkstra_entry e = heap.top();
+        heap.pop();
+        if(done[e.v])
+            continue;
+        done[e.v] = 1;
+        for(int i = g.offset[e.v]; i < g.offset[e.v + 1]; i++){
+            const int w = g.to[i];
+            const long long nd = e.dist + g.weight[i];
+            if(!done[w] && (dist[w] < 0 || nd < dist[w])){
+                dist[w] = nd;
+                heap.push(dijkstra_entry{nd, w});
+            }
+        }
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(dist[n - 1]);
+    return str1;
+}
+
+void pairing_heap_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : pairing_heap ---------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = { 5,1,4,2,3 };
+    mystl::pairing_heap<int> h1;
+    mystl::pairing_heap<int> h2(a, a + 5);
+    mystl::pairing_heap<int> h3{ 6,7,8 };
+    mystl::pairing_heap<int> h4(h2);
+    mystl::pairing_heap<int> h5(std::move(h4));
+    mystl::pairing_heap<int> h6;
+    h6 = h5;
+    mystl::pairing_heap<int> h7;
+    h7 = std::move(h5);
+    mystl::pairing_heap<int>::handle x1 = h1.push(10);
+    mystl::pairing_heap<int>::handle x2 = h1.push(20);
+    mystl::pairing_heap<int>::handle x3 = h1.emplace(30);
+    PAIRING_HEAP_COUT(h1);
+    PAIRING_HEAP_FUN_AFTER(h1, h1.decrease_key(x1, 40));
+    PAIRING_HEAP_FUN_AFTER(h1, h1.update(x3, 5));
+    PAIRING_HEAP_FUN_AFTER(h1, h1.erase(x2));
+    PAIRING_HEAP_FUN_AFTER(h1, h1.merge(h3));
+    PAIRING_HEAP_FUN_AFTER(h1, h1.pop());
+    FUN_VALUE(*x3);
+    FUN_VALUE(h1.size());
+    FUN_VALUE(h1.top());
+    FUN_VALUE(h1.pop_top());
+    PAIRING_HEAP_FUN_AFTER(h1, h1.swap(h2));
+    PAIRING_HEAP_FUN_AFTER(h1, h1.clear());
+    std::cout << std::boolalpha;
+    FUN_VALUE(h1.empty());
+    FUN_VALUE(h3.empty());
+    std::cout << std::noboolalpha;
+    PASSED;
+
+    dijkstra_graph g1(100000);
+    dijkstra_graph g2(1000000);
+    dijkstra_graph g3(4000000);
+    size_t pairing_peak[3], lazy_peak[3], stl_peak[3];
+    string pairing_times1 = time_dijkstra_pairing(g1, 100000, pairing_peak[0]);
+    string pairing_times2 = time_dijkstra_pairing(g2, 1000000, pairing_peak[1]);
+    string pairing_times3 = time_dijkstra_pairing(g3, 4000000, pairing_peak[2]);
+    string mystl_times1 = time_dijkstra_lazy<mystl::priority_queue<dijkstra_entry,
+      mystl::vector<dijkstra_entry>, mystl::greater<dijkstra_entry>>>(g1, 100000, lazy_peak[0]);
+    string mystl_times2 = time_dijkstra_lazy<mystl::priority_queue<dijkstra_entry,
+      mystl::vector<dijkstra_entry>, mystl::greater<dijkstra_entry>>>(g2, 1000000, lazy_peak[1]);
+    string mystl_times3 = time_dijkstra_lazy<mystl::priority_queue<dijkstra_entry,
+      mystl::vector<dijkstra_entry>, mystl::greater<dijkstra_entry>>>(g3, 4000000, lazy_peak[2]);
+    string stl_times1 = time_dijkstra_lazy<std::priority_queue<dijkstra_entry,
+      std::vector<dijkstra_entry>, std::greater<dijkstra_entry>>>(g1, 100000, stl_peak[0]);
+    string stl_times2 = time_dijkstra_lazy<std::priority_queue<dijkstra_entry,
+      std::vector<dijkstra_entry>, std::greater<dijkstra_entry>>>(g2, 1000000, stl_peak[1]);
+    string stl_times3 = time_dijkstra_lazy<std::priority_queue<dijkstra_entry,
+      std::vector<dijkstra_entry>, std::greater<dijkstra_entry>>>(g3, 4000000, stl_peak[2]);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| Dijkstra, vertices  |    10^5     |    10^6     |   4*10^6    |\n";
+    std::cout << "| pairing_heap (d-key)| "<<pairing_times1 + " | " << pairing_times2 + " | " + pairing_times3 + " |\n";
+    std::cout << "| mystl p_queue (lazy)| "<<mystl_times1 + " | " << mystl_times2 + " | " + mystl_times3 + " |\n";
+    std::cout << "|  std p_queue (lazy) | "<<stl_times1 + " | " << stl_times2 + " | " + stl_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| peak heap entries   |    10^5     |    10^6     |   4*10^6    |\n";
+    std::cout << "| pairing_heap (d-key)| "<<to_string(pairing_peak[0]) + " | " << to_string(pairing_peak[1]) + " | " + to_string(pairing_peak[2]) + " |\n";
+    std::cout << "|  p_queue (lazy)     | "<<to_string(lazy_peak[0]) + " | " << to_string(lazy_peak[1]) + " | " + to_string(lazy_peak[2]) + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -121,18 +121,151 @@ void queue_test()
 
 }
 
+void p_queue_print(mystl::priority_queue<int> p)
+{
+  while (!p.empty())
+  {
+    std::cout << " " << p.top();
+    p.pop();
+  }
+  std::cout << std::endl;
+}
+//  priority_queue 的遍历输出
+#define P_QUEUE_COUT(p) do {                     \
+    std::string p_name = #p;                     \
+    std::cout << " " << p_name << " :";          \
+    p_queue_print(p);                            \
+} while(0)
 
+#define P_QUEUE_FUN_AFTER(con, fun) do {         \
+  std::string fun_name = #fun;                   \
+  std::cout << " After " << fun_name << " :\n";  \
+  fun;                                           \
+  P_QUEUE_COUT(con);                             \
+} while(0)
 
+// 定时器堆的典型用法：堆中保持 len 个元素，反复取出堆顶再放回一个稍晚的值
+template <class PQ>
+string time_heap_hold(int len, int times){
+    PQ q;
+    mystl::vector<int> v(len);
+    for(int i = 0; i < len; i++)
+        v[i] = rand();
+    q.push_range(v.begin(), v.end());
+    const auto t1 = std::chrono::system_clock::now();
+    long long sum = 0;
+    for(int i = 0; i < times; i++){
+        const int x = q.top();
+        q.pop();
+        sum += x;
+        q.push(x - rand() % 1000);
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
 
+// 往已有 len 个元素的堆中放入 len 个更大的递增元素，逐个 push 时每个都要上溯到堆顶
+template <class PQ>
+string time_heap_bulk(int len, bool range){
+    PQ q;
+    mystl::vector<int> v(len);
+    for(int i = 0; i < len; i++)
+        v[i] = i;
+    q.push_range(v.begin(), v.end());
+    for(int i = 0; i < len; i++)
+        v[i] += len;
+    const auto t1 = std::chrono::system_clock::now();
+    if(range){
+        q.push_range(v.begin(), v.end());
+    }
+    else{
+        for(int i = 0; i < len; i++)
+            q.push(v[i]);
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(q.size());
+    return str1;
+}
 
+void priority_queue_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : priority_queue -------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int a[] = { 1,2,3,4,5 };
+    mystl::vector<int> v1(5);
+    mystl::priority_queue<int> p1;
+    mystl::priority_queue<int> p2(5);
+    mystl::priority_queue<int> p3(5, 1);
+    mystl::priority_queue<int> p4(a, a + 5);
+    mystl::priority_queue<int> p5(v1);
+    mystl::priority_queue<int> p6(std::move(v1));
+    mystl::priority_queue<int> p7(p2);
+    mystl::priority_queue<int> p8(std::move(p2));
+    mystl::priority_queue<int> p9;
+    p9 = p3;
+    mystl::priority_queue<int> p10;
+    p10 = std::move(p3);
+    mystl::priority_queue<int> p11{ 1,2,3,4,5 };
+    mystl::priority_queue<int> p12;
+    p12 = { 1,2,3,4,5 };
 
+    P_QUEUE_FUN_AFTER(p1, p1.push(1));
+    P_QUEUE_FUN_AFTER(p1, p1.push(5));
+    P_QUEUE_FUN_AFTER(p1, p1.push(3));
+    P_QUEUE_FUN_AFTER(p1, p1.pop());
+    P_QUEUE_FUN_AFTER(p1, p1.emplace(7));
+    P_QUEUE_FUN_AFTER(p1, p1.emplace(2));
+    P_QUEUE_FUN_AFTER(p1, p1.push_range(a, a + 5));
+    std::cout << std::boolalpha;
+    FUN_VALUE(p1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(p1.size());
+    FUN_VALUE(p1.top());
+    while (!p1.empty())
+    {
+        P_QUEUE_FUN_AFTER(p1, p1.pop());
+    }
+    P_QUEUE_FUN_AFTER(p1, p1.swap(p4));
+    P_QUEUE_FUN_AFTER(p1, p1.clear());
+    mystl::dary_priority_queue<int, 4, mystl::vector<int>, mystl::greater<int>> d1{ 5,1,4,2,3 };
+    d1.push_range(a, a + 5);
+    FUN_VALUE(d1.arity);
+    FUN_VALUE(d1.size());
+    FUN_VALUE(d1.top());
+    FUN_VALUE((d1.pop(), d1.pop(), d1.pop(), d1.top()));
+    PASSED;
 
-
-
-
-
-
-
+    const int times = 1000000;
+    string bin_times1 = time_heap_hold<mystl::priority_queue<int>>(100000, times);
+    string bin_times2 = time_heap_hold<mystl::priority_queue<int>>(1000000, times);
+    string bin_times3 = time_heap_hold<mystl::priority_queue<int>>(10000000, times);
+    string dary_times1 = time_heap_hold<mystl::dary_priority_queue<int, 4>>(100000, times);
+    string dary_times2 = time_heap_hold<mystl::dary_priority_queue<int, 4>>(1000000, times);
+    string dary_times3 = time_heap_hold<mystl::dary_priority_queue<int, 4>>(10000000, times);
+    string push_times1 = time_heap_bulk<mystl::priority_queue<int>>(100000, false);
+    string push_times2 = time_heap_bulk<mystl::priority_queue<int>>(1000000, false);
+    string push_times3 = time_heap_bulk<mystl::priority_queue<int>>(10000000, false);
+    string range_times1 = time_heap_bulk<mystl::priority_queue<int>>(100000, true);
+    string range_times2 = time_heap_bulk<mystl::priority_queue<int>>(1000000, true);
+    string range_times3 = time_heap_bulk<mystl::priority_queue<int>>(10000000, true);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 10^6 pop + push     |    10^5     |    10^6     |    10^7     |\n";
+    std::cout << "|   binary (D = 2)    | "<<bin_times1 + " | " << bin_times2 + " | " + bin_times3 + " |\n";
+    std::cout << "|   4-ary  (D = 4)    | "<<dary_times1 + " | " << dary_times2 + " | " + dary_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| add n to n (asc)    |    10^5     |    10^6     |    10^7     |\n";
+    std::cout << "|   push one by one   | "<<push_times1 + " | " << push_times2 + " | " + push_times3 + " |\n";
+    std::cout << "|     push_range      | "<<range_times1 + " | " << range_times2 + " | " + range_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
 
 }
 
@@ -0,0 +1,91 @@
+#ifndef MYTINYSTL_SMALL_VECTOR_TEST_H_
+#define MYTINYSTL_SMALL_VECTOR_TEST_H_
+
+// small_vector test : 测试 small_vector 的接口与大量短数组的构造性能
+
+#include <vector>
+#include <iostream>
+#include <chrono>
+
+#include "../MYSTL/small_vector.h"
+#include "../MYSTL/vector.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 反复构造 times 个只有 len 个元素的短数组
+template <class Vec>
+string time_small_lists(int times, int len){
+    const auto t1 = std::chrono::system_clock::now();
+    long long sum = 0;
+    for(int i = 0; i < times; i++){
+        Vec v;
+        for(int j = 0; j < len; j++)
+            v.push_back(i + j);
+        sum += v[len - 1];
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+void small_vector_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : small_vector --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = { 1,2,3,4,5 };
+    mystl::small_vector<int, 8> v1;
+    mystl::small_vector<int, 8> v2(10);
+    mystl::small_vector<int, 8> v3(5, 1);
+    mystl::small_vector<int, 8> v4(a, a + 5);
+    mystl::small_vector<int, 8> v5(v4);
+    mystl::small_vector<int, 8> v6(std::move(v2));
+    mystl::small_vector<int, 8> v7{ 1,2,3,4,5,6,7,8,9 };
+    std::cout << std::boolalpha;
+    FUN_VALUE(v4.is_inline());
+    FUN_VALUE(v6.is_inline());
+    FUN_VALUE(v7.is_inline());
+    FUN_VALUE((v5 == v4));
+    std::cout << std::noboolalpha;
+    FUN_AFTER(v1, v1.assign(4, 4));
+    FUN_AFTER(v1, v1.emplace(v1.begin(), 0));
+    FUN_AFTER(v1, v1.push_back(v1[0]));
+    FUN_AFTER(v1, v1.insert(v1.begin() + 1, a, a + 5));
+    FUN_AFTER(v1, v1.insert(v1.end(), 2, 9));
+    FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 8));
+    FUN_AFTER(v1, v1.pop_back());
+    FUN_VALUE(v1.capacity());
+    FUN_AFTER(v1, v1.shrink_to_fit());
+    FUN_VALUE(v1.capacity());
+    FUN_AFTER(v1, v1.swap(v7));
+    FUN_AFTER(v7, v7.resize(6, 6));
+    FUN_VALUE(v1.front());
+    FUN_VALUE(v1.back());
+    FUN_VALUE(v1.at(2));
+    PASSED;
+
+    int times = 1000000;
+    string sv_times1 = time_small_lists<mystl::small_vector<int, 8>>(times, 2);
+    string sv_times2 = time_small_lists<mystl::small_vector<int, 8>>(times, 6);
+    string sv_times3 = time_small_lists<mystl::small_vector<int, 8>>(times, 12);
+    string mystl_times1 = time_small_lists<mystl::vector<int>>(times, 2);
+    string mystl_times2 = time_small_lists<mystl::vector<int>>(times, 6);
+    string mystl_times3 = time_small_lists<mystl::vector<int>>(times, 12);
+    string stl_times1 = time_small_lists<std::vector<int>>(times, 2);
+    string stl_times2 = time_small_lists<std::vector<int>>(times, 6);
+    string stl_times3 = time_small_lists<std::vector<int>>(times, 12);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  10^6 lists of len  |      2      |      6      |      12     |\n";
+    std::cout << "|  small_vector<8>    | "<<sv_times1 + " | " << sv_times2 + " | " + sv_times3 + " |\n";
+    std::cout << "|    mystl::vector    | "<<mystl_times1 + " | " << mystl_times2 + " | " + mystl_times3 + " |\n";
+    std::cout << "|     std::vector     | "<<stl_times1 + " | " << stl_times2 + " | " + stl_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -0,0 +1,105 @@
+#ifndef MYTINYSTL_SOA_VECTOR_TEST_H_
+#define MYTINYSTL_SOA_VECTOR_TEST_H_
+
+// soa_vector test : 测试 soa_vector 的接口与只扫描一个字段时的性能
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <chrono>
+
+#include "../MYSTL/soa_vector.h"
+#include "../MYSTL/vector.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 一行 64 字节的记录，聚合时只读 price
+struct soa_test_record{
+    int    id;
+    double price;
+    double qty;
+    char   note[40];
+};
+
+// 按行存放，扫描 times 遍 price
+template <class Vec>
+string time_scan_rows(int times, int len){
+    Vec v(len);
+    for(int i = 0; i < len; i++)
+        v[i].price = i * 0.5;
+    const auto t1 = std::chrono::system_clock::now();
+    double sum = 0;
+    for(int i = 0; i < times; i++){
+        for(auto& r : v)
+            sum += r.price;
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+// 按列存放，只扫描 price 一列
+string time_scan_column(int times, int len){
+    mystl::soa_vector<int, double, double, soa_test_record> v(len);
+    for(int i = 0; i < len; i++)
+        v.get<1>(i) = i * 0.5;
+    const auto t1 = std::chrono::system_clock::now();
+    double sum = 0;
+    for(int i = 0; i < times; i++){
+        for(double x : v.column<1>())
+            sum += x;
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+void soa_vector_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[--------------- Run container test : soa_vector ---------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    mystl::soa_vector<int, std::string, double> v1;
+    FUN_AFTER(v1.column<0>(), v1.push_back(1, "a", 0.5));
+    FUN_AFTER(v1.column<1>(), v1.emplace_back(2, "b", 1.5));
+    FUN_AFTER(v1.column<2>(), v1.push_back(std::make_tuple(3, std::string("c"), 2.5)));
+    FUN_AFTER(v1.column<0>(), std::get<0>(v1[1]) = 20);
+    FUN_AFTER(v1.column<1>(), v1.get<1>(2) = "cc");
+    FUN_AFTER(v1.column<0>(), v1.erase(0));
+    FUN_AFTER(v1.column<0>(), v1.resize(4));
+    FUN_AFTER(v1.column<0>(), v1.pop_back());
+    FUN_VALUE(v1.size());
+    FUN_VALUE(std::get<1>(v1.back()));
+    FUN_VALUE(std::get<2>(*(v1.begin() + 1)));
+    FUN_VALUE(v1.column<2>().size_bytes());
+    FUN_VALUE((v1.reserve(100), v1.capacity()));
+    FUN_AFTER(v1.column<0>(), v1.clear());
+    PASSED;
+
+    int times = 20;
+    string soa_times1 = time_scan_column(times, 100000);
+    string soa_times2 = time_scan_column(times, 1000000);
+    string soa_times3 = time_scan_column(times, 10000000);
+    string mystl_times1 = time_scan_rows<mystl::vector<soa_test_record>>(times, 100000);
+    string mystl_times2 = time_scan_rows<mystl::vector<soa_test_record>>(times, 1000000);
+    string mystl_times3 = time_scan_rows<mystl::vector<soa_test_record>>(times, 10000000);
+    string stl_times1 = time_scan_rows<std::vector<soa_test_record>>(times, 100000);
+    string stl_times2 = time_scan_rows<std::vector<soa_test_record>>(times, 1000000);
+    string stl_times3 = time_scan_rows<std::vector<soa_test_record>>(times, 10000000);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 20 x sum one field  |    10^5     |    10^6     |    10^7     |\n";
+    std::cout << "|     soa_vector      | "<<soa_times1 + " | " << soa_times2 + " | " + soa_times3 + " |\n";
+    std::cout << "|    mystl::vector    | "<<mystl_times1 + " | " << mystl_times2 + " | " + mystl_times3 + " |\n";
+    std::cout << "|     std::vector     | "<<stl_times1 + " | " << stl_times2 + " | " + stl_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -0,0 +1,201 @@
+#ifndef MYTINYSTL_SPSC_QUEUE_TEST_H_
+#define MYTINYSTL_SPSC_QUEUE_TEST_H_
+
+// spsc_queue test : 测试 spsc_queue 的接口与两个线程之间传递元素时的性能
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <stdexcept>
+
+#include "../MYSTL/spsc_queue.h"
+#include "../MYSTL/queue.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 第 limit 次写入时抛出异常的输出迭代器
+struct spsc_throwing_output{
+    int* out;
+    int  limit;
+    spsc_throwing_output& operator*(){ return *this; }
+    spsc_throwing_output& operator++(){ return *this; }
+    spsc_throwing_output& operator=(int v){
+        if(limit-- == 0)
+            throw std::runtime_error("output full");
+        *out++ = v;
+        return *this;
+    }
+};
+
+// 放入 0..3，try_pop_n 写出两个后抛出异常，返回下一次 try_pop 取到的值，应为 2
+int spsc_pop_n_throw_next(){
+    mystl::spsc_queue<int> q(4);
+    for(int i = 0; i < 4; i++)
+        q.try_push(i);
+    int b[4] = { 0 };
+    try{
+        q.try_pop_n(spsc_throwing_output{ b, 2 }, 4);
+    }
+    catch(std::runtime_error&){
+    }
+    int x = -1;
+    q.try_pop(x);
+    return x;
+}
+
+// 生产者逐个 try_push，消费者逐个 try_pop，失败时让出 CPU
+string time_spsc(int len){
+    mystl::spsc_queue<int> q(1024);
+    const auto t1 = std::chrono::system_clock::now();
+    std::thread producer([&q, len](){
+        for(int i = 0; i < len; )
+        {
+            if(q.try_push(i))
+                ++i;
+            else
+                std::this_thread::yield();
+        }
+    });
+    long long sum = 0;
+    for(int i = 0; i < len; ){
+        int x;
+        if(q.try_pop(x)){
+            sum += x;
+            ++i;
+        }
+        else{
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+// 每次最多传递 64 个，消费者用阻塞的 wait_pop_n
+string time_spsc_batch(int len){
+    mystl::spsc_queue<int, true> q(1024);
+    const auto t1 = std::chrono::system_clock::now();
+    std::thread producer([&q, len](){
+        int buf[64];
+        for(int i = 0; i < len; ){
+            const int n = len - i < 64 ? len - i : 64;
+            for(int k = 0; k < n; k++)
+                buf[k] = i + k;
+            const size_t pushed = q.try_push_n(buf, n);
+            if(pushed == 0)
+                std::this_thread::yield();
+            i += static_cast<int>(pushed);
+        }
+    });
+    long long sum = 0;
+    int buf[64];
+    for(int i = 0; i < len; ){
+        const size_t n = q.wait_pop_n(buf, 64);
+        for(size_t k = 0; k < n; k++)
+            sum += buf[k];
+        i += static_cast<int>(n);
+    }
+    producer.join();
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+// 用互斥锁保护的 mystl::queue
+string time_locked_queue(int len){
+    mystl::queue<int> q;
+    std::mutex m;
+    const auto t1 = std::chrono::system_clock::now();
+    std::thread producer([&q, &m, len](){
+        for(int i = 0; i < len; i++){
+            std::lock_guard<std::mutex> lock(m);
+            q.push(i);
+        }
+    });
+    long long sum = 0;
+    for(int i = 0; i < len; ){
+        bool got = false;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if(!q.empty()){
+                sum += q.front();
+                q.pop();
+                got = true;
+            }
+        }
+        if(got)
+            ++i;
+        else
+            std::this_thread::yield();
+    }
+    producer.join();
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+void spsc_queue_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : spsc_queue ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = { 1,2,3,4,5,6 };
+    int b[6] = { 0 };
+    int x = 0;
+    mystl::spsc_queue<int, true> q1(3);
+    FUN_VALUE(q1.capacity());
+    std::cout << std::boolalpha;
+    FUN_VALUE(q1.try_push(0));
+    FUN_VALUE(q1.try_push_n(a, 6));
+    FUN_VALUE(q1.try_push(7));
+    FUN_VALUE(q1.try_pop(x));
+    FUN_VALUE(x);
+    FUN_VALUE(*q1.front());
+    FUN_VALUE(q1.try_pop_n(b, 6));
+    FUN_VALUE(b[2]);
+    FUN_VALUE(q1.empty());
+    FUN_VALUE(spsc_pop_n_throw_next());
+    std::cout << std::noboolalpha;
+    std::thread producer([&q1, &a](){
+        for(int i = 0; i < 6; i++)
+            q1.push(a[i]);
+    });
+    for(int i = 0; i < 6; i++){
+        q1.wait_pop(x);
+        std::cout << " " << x;
+    }
+    std::cout << "\n";
+    producer.join();
+    PASSED;
+
+    string spsc_times1 = time_spsc(100000);
+    string spsc_times2 = time_spsc(1000000);
+    string spsc_times3 = time_spsc(10000000);
+    string batch_times1 = time_spsc_batch(100000);
+    string batch_times2 = time_spsc_batch(1000000);
+    string batch_times3 = time_spsc_batch(10000000);
+    string lock_times1 = time_locked_queue(100000);
+    string lock_times2 = time_locked_queue(1000000);
+    string lock_times3 = time_locked_queue(10000000);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 2 threads pass int  |    10^5     |    10^6     |    10^7     |\n";
+    std::cout << "|     spsc_queue      | "<<spsc_times1 + " | " << spsc_times2 + " | " + spsc_times3 + " |\n";
+    std::cout << "|  spsc_queue batch   | "<<batch_times1 + " | " << batch_times2 + " | " + batch_times3 + " |\n";
+    std::cout << "| mutex + mystl::queue| "<<lock_times1 + " | " << lock_times2 + " | " + lock_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -0,0 +1,96 @@
+#ifndef MYTINYSTL_STATIC_VECTOR_TEST_H_
+#define MYTINYSTL_STATIC_VECTOR_TEST_H_
+
+// static_vector test : 测试 static_vector 的接口与作为临时缓冲区时的性能
+
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <stdexcept>
+
+#include "../MYSTL/static_vector.h"
+#include "../MYSTL/vector.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 每次循环新建一个缓冲区，写入 len 个元素
+template <class Vec>
+string time_scratch(int times, int len){
+    const auto t1 = std::chrono::system_clock::now();
+    long long sum = 0;
+    for(int i = 0; i < times; i++){
+        Vec v;
+        for(int j = 0; j < len; j++)
+            v.push_back(i ^ j);
+        sum += v[len / 2];
+    }
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum);
+    return str1;
+}
+
+void static_vector_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : static_vector --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = { 1,2,3,4,5 };
+    mystl::static_vector<int, 8> v1;
+    mystl::static_vector<int, 8> v2(4, 2);
+    mystl::static_vector<int, 8> v3(a, a + 5);
+    mystl::static_vector<int, 8> v4{ 1,2,3 };
+    FUN_AFTER(v1, v1.assign(3, 3));
+    FUN_AFTER(v1, v1.emplace(v1.begin(), 0));
+    FUN_AFTER(v1, v1.push_back(v1[0]));
+    FUN_AFTER(v1, v1.insert(v1.begin() + 1, a, a + 3));
+    FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 2));
+    FUN_AFTER(v1, v1.pop_back());
+    FUN_AFTER(v1, v1.swap(v3));
+    FUN_AFTER(v3, v3.resize(7, 7));
+    std::cout << std::boolalpha;
+    FUN_VALUE(v3.full());
+    FUN_VALUE(v3.try_push_back(8));
+    FUN_VALUE(v3.try_push_back(9));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(v3.capacity());
+    try{
+        v3.push_back(10);
+    }
+    catch(const std::length_error& e){
+        std::cout << " v3.push_back(10) : " << e.what() << "\n";
+    }
+    FUN_VALUE(v2.size());
+    FUN_VALUE(v4.back());
+    FUN_VALUE(*v4.rbegin());
+    FUN_VALUE(*(v4.rend() - 1));
+    FUN_VALUE(*v4.cbegin());
+    FUN_VALUE(v4.cend() - v4.cbegin());
+    FUN_VALUE(*v4.crbegin());
+    FUN_VALUE(v4.crend() - v4.crbegin());
+    PASSED;
+
+    int times = 1000000;
+    string sv_times1 = time_scratch<mystl::static_vector<int, 64>>(times, 4);
+    string sv_times2 = time_scratch<mystl::static_vector<int, 64>>(times, 16);
+    string sv_times3 = time_scratch<mystl::static_vector<int, 64>>(times, 64);
+    string mystl_times1 = time_scratch<mystl::vector<int>>(times, 4);
+    string mystl_times2 = time_scratch<mystl::vector<int>>(times, 16);
+    string mystl_times3 = time_scratch<mystl::vector<int>>(times, 64);
+    string stl_times1 = time_scratch<std::vector<int>>(times, 4);
+    string stl_times2 = time_scratch<std::vector<int>>(times, 16);
+    string stl_times3 = time_scratch<std::vector<int>>(times, 64);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 10^6 buffers of len |      4      |      16     |      64     |\n";
+    std::cout << "|  static_vector<64>  | "<<sv_times1 + " | " << sv_times2 + " | " + sv_times3 + " |\n";
+    std::cout << "|    mystl::vector    | "<<mystl_times1 + " | " << mystl_times2 + " | " + mystl_times3 + " |\n";
+    std::cout << "|     std::vector     | "<<stl_times1 + " | " << stl_times2 + " | " + stl_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif
@@ -1,13 +1,28 @@
 #include "vector_test.h"
+#include "small_vector_test.h"
+#include "static_vector_test.h"
+#include "dynamic_bitset_test.h"
+#include "mmap_vector_test.h"
+#include "soa_vector_test.h"
 #include "deque_test.h"
+#include "circular_buffer_test.h"
 #include "stack_test.h"
 #include "queue_test.h"
+#include "pairing_heap_test.h"
+#include "spsc_queue_test.h"
+#include "mpmc_queue_test.h"
+#include "work_stealing_deque_test.h"
+#include "lockfree_stack_test.h"
 #include "list_test.h"
 #include "map_test.h"
 #include "set_test.h"
 #include "unordered_map_test.h"
 #include "unordered_set_test.h"
 #include "algorithm_test.h"
+#include "allocator_test.h"
+#include "node_pool_test.h"
+#include "memory_resource_test.h"
+#include "allocator_aware_test.h"
 using namespace mystl;
 
 
@@ -15,9 +30,21 @@ int main(){
 
     mystl::algorithm_test();
     mystl::vector_test();
+    mystl::small_vector_test();
+    mystl::static_vector_test();
+    mystl::dynamic_bitset_test();
+    mystl::mmap_vector_test();
+    mystl::soa_vector_test();
     mystl::deque_test();
+    mystl::circular_buffer_test();
     mystl::stack_test();
     mystl::queue_test();
+    mystl::priority_queue_test();
+    mystl::pairing_heap_test();
+    mystl::spsc_queue_test();
+    mystl::mpmc_queue_test();
+    mystl::work_stealing_deque_test();
+    mystl::lockfree_stack_test();
     mystl::list_test();
     mystl::map_test();
     mystl::multimap_test();
@@ -27,5 +54,9 @@ int main(){
     mystl::unordered_multimap_test();
     mystl::unordered_set_test();
     mystl::unordered_multiset_test();
+    mystl::allocator_test();
+    mystl::node_pool_test();
+    mystl::memory_resource_test();
+    mystl::allocator_aware_test();
 }
 
@@ -557,6 +557,14 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
 #define TEST_LEN(len1, len2, len3, wide) \
   test_len(len1, len2, len3, wide)
 
+// 把计时循环算出的结果写进 volatile 变量，使循环不会被编译器当作无用代码删掉
+template <class T>
+void do_not_optimize(const T& value)
+{
+  static volatile T sink;
+  sink = value;
+}
+
 // 常用测试性能的宏
 #define FUN_TEST_FORMAT1(mode, fun, arg, count) do {         \
   srand((int)time(0));                                       \
@@ -89,6 +89,15 @@ void vector_test(){
     FUN_VALUE(v1.capacity());
     FUN_VALUE(v1.size());
     FUN_VALUE(v1.capacity());
+    FUN_VALUE((v1.resize_uninitialized(12), v1.size()));
+    FUN_AFTER(v1, v1.resize_default_init(6));
+    FUN_AFTER(v1, v1.shrink_to_fit());
+    FUN_VALUE(v1.capacity());
+    FUN_AFTER(v1, v1.append_range(a, a + 5));
+    FUN_AFTER(v1, v1.append_range(v1.begin(), v1.end()));
+    int next = 10;
+    FUN_AFTER(v1, v1.append_n(3, [&next] { return next++; }));
+    FUN_AFTER(v1, (v1.reserve(v1.size() + 2), v1.emplace_back_unchecked(7), v1.emplace_back_unchecked(8)));
     FUN_AFTER(v1, v1.clear());
     FUN_VALUE(v1.size());
     FUN_VALUE(v1.capacity());
@@ -98,6 +107,17 @@ void vector_test(){
     FUN_VALUE(v1.capacity());
     FUN_VALUE(v1.size());
     FUN_VALUE(v1.capacity());
+    // 元素本身是容器时，扩容和插入删除按字节搬移
+    mystl::vector<mystl::vector<int>> v12(20, v7);
+    FUN_VALUE((v12.insert(v12.begin(), v4), v12.front().size()));
+    FUN_VALUE((v12.erase(v12.begin(), v12.begin() + 10), v12.size()));
+    FUN_VALUE((v12.push_back(v12[0]), v12.back().back()));
+    // 增长策略
+    mystl::vector<int, mystl::allocator<int>, mystl::growth_2x> v13(16, 1);
+    FUN_VALUE((v13.push_back(2), v13.capacity()));
+    mystl::vector<int, mystl::allocator<int>, mystl::growth_exact_then_geometric> v14;
+    FUN_VALUE(v14.capacity());
+    FUN_VALUE((v14.push_back(1), v14.capacity()));
     PASSED;
     std::vector<int> v11;
     int times1 = 100000;
@@ -0,0 +1,161 @@
+#ifndef MYTINYSTL_WORK_STEALING_DEQUE_TEST_H_
+#define MYTINYSTL_WORK_STEALING_DEQUE_TEST_H_
+
+// work_stealing_deque test : 测试 work_stealing_deque 的接口与拥有者分发、其它线程窃取时的性能
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+#include "../MYSTL/work_stealing_deque.h"
+#include "../MYSTL/deque.h"
+#include "test.h"
+using namespace std;
+
+namespace mystl{
+
+// 拥有者放入 len 个任务，每放入 4 个自己从底部取 1 个，thieves 个线程从顶部窃取
+string time_work_stealing(int thieves, int len){
+    mystl::work_stealing_deque<int> d;
+    std::atomic<bool> done(false);
+    std::atomic<long long> sum(0);
+    const auto t1 = std::chrono::system_clock::now();
+    std::vector<std::thread> workers;
+    for(int k = 0; k < thieves; k++){
+        workers.emplace_back([&d, &done, &sum](){
+            long long local = 0;
+            int x;
+            while(!done.load(std::memory_order_acquire)){
+                if(d.steal(x))
+                    local += x;
+                else
+                    std::this_thread::yield();
+            }
+            while(d.steal(x))
+                local += x;
+            sum += local;
+        });
+    }
+    long long local = 0;
+    int x;
+    for(int i = 0; i < len; i++){
+        d.push(i);
+        if(i % 4 == 3 && d.pop(x))
+            local += x;
+    }
+    while(d.pop(x))
+        local += x;
+    done.store(true, std::memory_order_release);
+    for(auto& w : workers)
+        w.join();
+    sum += local;
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum.load());
+    return str1;
+}
+
+// 同样的分发方式，共用一个互斥锁保护的 mystl::deque
+string time_locked_deque(int thieves, int len){
+    mystl::deque<int> d;
+    std::mutex m;
+    std::atomic<bool> done(false);
+    std::atomic<long long> sum(0);
+    const auto t1 = std::chrono::system_clock::now();
+    std::vector<std::thread> workers;
+    for(int k = 0; k < thieves; k++){
+        workers.emplace_back([&d, &m, &done, &sum](){
+            long long local = 0;
+            while(true){
+                bool got = false;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    if(!d.empty()){
+                        local += d.front();
+                        d.pop_front();
+                        got = true;
+                    }
+                }
+                if(!got){
+                    if(done.load(std::memory_order_acquire))
+                        break;
+                    std::this_thread::yield();
+                }
+            }
+            sum += local;
+        });
+    }
+    long long local = 0;
+    for(int i = 0; i < len; i++){
+        std::lock_guard<std::mutex> lock(m);
+        d.push_back(i);
+        if(i % 4 == 3){
+            local += d.back();
+            d.pop_back();
+        }
+    }
+    while(true){
+        std::lock_guard<std::mutex> lock(m);
+        if(d.empty())
+            break;
+        local += d.back();
+        d.pop_back();
+    }
+    done.store(true, std::memory_order_release);
+    for(auto& w : workers)
+        w.join();
+    sum += local;
+    const auto t2 = std::chrono::system_clock::now();
+    const auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() * 1e-3;
+    string str1 = to_string(duration1) + "ms";
+    test::do_not_optimize(sum.load());
+    return str1;
+}
+
+void work_stealing_deque_test(){
+    std::cout << "[===============================================================]\n";
+    std::cout << "[---------- Run container test : work_stealing_deque -----------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int x = 0;
+    mystl::work_stealing_deque<int> d1(2);
+    FUN_VALUE(d1.capacity());
+    d1.push(1);
+    d1.push(2);
+    d1.push(3);
+    FUN_VALUE(d1.size());
+    FUN_VALUE(d1.capacity());
+    std::cout << std::boolalpha;
+    FUN_VALUE(d1.steal(x));
+    FUN_VALUE(x);
+    FUN_VALUE(d1.pop(x));
+    FUN_VALUE(x);
+    FUN_VALUE(d1.pop(x));
+    FUN_VALUE(x);
+    FUN_VALUE(d1.pop(x));
+    FUN_VALUE(d1.steal(x));
+    FUN_VALUE(d1.empty());
+    std::cout << std::noboolalpha;
+    PASSED;
+
+    const int len = 1000000;
+    string ws_times1 = time_work_stealing(1, len);
+    string ws_times2 = time_work_stealing(2, len);
+    string ws_times3 = time_work_stealing(4, len);
+    string lock_times1 = time_locked_deque(1, len);
+    string lock_times2 = time_locked_deque(2, len);
+    string lock_times3 = time_locked_deque(4, len);
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 10^6 tasks, thieves |      1      |      2      |      4      |\n";
+    std::cout << "| work_stealing_deque | "<<ws_times1 + " | " << ws_times2 + " | " + ws_times3 + " |\n";
+    std::cout << "| mutex + mystl::deque| "<<lock_times1 + " | " << lock_times2 + " | " + lock_times3 + " |\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+}
+
+}
+#endif